@@ -0,0 +1,601 @@
+/**
+ * @file taa3040_bench.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Microbenchmarks of the TAA3040 driver against an in-process register model
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ * Every public call of taa3040.h, plus the image, packed and blob codecs, is run against
+ * a model of the device's register file. For each one the bus traffic of a single call
+ * (transactions and bytes) and the CPU cost over many calls are reported as one JSON
+ * document on stdout, so results can be diffed between releases. On Linux the recorder
+ * is also timed writing blocks to a file through its pwrite / O_DIRECT sink:
+ *
+ *   ./TAA3040_bench [iterations] [bus] > bench_output.json
+ *
+ * On Linux the calls can go through the i2c-dev HAL instead, over the bus given: a
+ * /dev/i2c-N node with a device (or i2c-stub) at 0x4C, or the register model behind a
+ * modelled adapter, "model-i2c" with plain I2C_RDWR transfers or "model-smbus" with
+ * SMBus transfers only. Each result then also counts the ioctls of one call.
+ */
+
+#define _GNU_SOURCE
+
+#include "taa3040.h"
+#include "taa3040_image.h"
+#include "taa3040_packed.h"
+#include "taa3040_blob.h"
+#include "taa3040_eq.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include "taa3040_linux.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TAA3040_BENCH_TIMER "tsc"
+#endif
+
+#define TAA3040_BENCH_ITERATIONS    (2000)
+#define TAA3040_BENCH_ADDRESS       (0x4C)
+#define TAA3040_BENCH_RECORDER_PATH "/tmp/taa3040_bench.wav"  ///< Reused by every rotation
+#define TAA3040_BENCH_RECORDER_BLOCK (4096)                    ///< One O_DIRECT aligned block per call
+#define TAA3040_BENCH_RECORDER_FRAMES (TAA3040_BENCH_RECORDER_BLOCK / (TAA3040_NUM_CHANNELS * sizeof(int32_t)))
+
+/* === Register Model === */
+
+/*
+ * 256 pages of 128 registers with address auto-increment. Writing register 0 selects the
+ * page, and the page 0 checksum register sums every data byte received, as on the device.
+ */
+typedef struct {
+    uint8_t regs[256][TAA3040_PAGE_SIZE];
+    uint8_t page;
+    uint8_t checksum;
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t bytes_read;
+    uint32_t bytes_written;
+} taa3040_bench_model_t;
+
+static taa3040_bench_model_t model;
+
+static void taa3040_bench_model_write(const uint8_t reg, const uint8_t* const bytes, const uint8_t length)
+{
+    model.writes++;
+    model.bytes_written += length;
+    for (uint8_t i = 0; i < length; ++i)
+    {
+        const uint8_t addr = (uint8_t)((reg + i) & (TAA3040_PAGE_SIZE - 1));
+        if (addr == TAA3040_REG_PAGE_SELECT)
+            model.page = bytes[i];
+        else if (model.page == 0 && addr == TAA3040_REG_I2C_CHECKSUM)
+        {
+            model.checksum = bytes[i];
+            continue;
+        }
+        else
+            model.regs[model.page][addr] = bytes[i];
+        model.checksum = (uint8_t)(model.checksum + bytes[i]);
+    }
+}
+
+static void taa3040_bench_model_read(const uint8_t reg, uint8_t* const bytes, const uint8_t length)
+{
+    model.reads++;
+    model.bytes_read += length;
+    for (uint8_t i = 0; i < length; ++i)
+    {
+        const uint8_t addr = (uint8_t)((reg + i) & (TAA3040_PAGE_SIZE - 1));
+        if (addr == TAA3040_REG_PAGE_SELECT)
+            bytes[i] = model.page;
+        else if (model.page == 0 && addr == TAA3040_REG_I2C_CHECKSUM)
+            bytes[i] = model.checksum;
+        else
+            bytes[i] = model.regs[model.page][addr];
+    }
+}
+
+static bool taa3040_bench_i2c_write(
+#ifdef TAA3040_HAL_CONTEXT
+    void* const context,
+#endif
+    const uint8_t address, const uint8_t reg, const void* const data, const uint8_t length)
+{
+    (void)address;
+#ifdef TAA3040_HAL_CONTEXT
+    (void)context;
+#endif
+    taa3040_bench_model_write(reg, (const uint8_t*)data, length);
+    return true;
+}
+
+static bool taa3040_bench_i2c_read(
+#ifdef TAA3040_HAL_CONTEXT
+    void* const context,
+#endif
+    const uint8_t address, const uint8_t reg, void* const data, const uint8_t length)
+{
+    (void)address;
+#ifdef TAA3040_HAL_CONTEXT
+    (void)context;
+#endif
+    taa3040_bench_model_read(reg, (uint8_t*)data, length);
+    return true;
+}
+
+#ifndef TAA3040_REDUCED_HAL
+static void taa3040_bench_enable_write(
+#ifdef TAA3040_HAL_CONTEXT
+    void* const context,
+#endif
+    const bool state)
+{
+#ifdef TAA3040_HAL_CONTEXT
+    (void)context;
+#endif
+    (void)state;
+}
+#endif
+
+#if defined(__linux__)
+
+/* === Modelled i2c-dev Adapter === */
+
+/*
+ * The bench builds its own copy of the i2c-dev HAL with TAA3040_LINUX_IOCTL naming this
+ * function. With a modelled adapter selected every ioctl lands here, so the HAL's I2C_RDWR
+ * messages or SMBus transfers reach the register model; otherwise they go to the kernel.
+ * The modelled device acknowledges TAA3040_BENCH_ADDRESS only.
+ */
+static unsigned long adapter_functionality;     ///< I2C_FUNC_* bits of the modelled adapter, 0 for the kernel
+static unsigned long adapter_slave;
+static taa3040_linux_i2c_t bus;
+
+int taa3040_bench_ioctl(int fd, unsigned long request, ...)
+{
+    va_list args;
+    va_start(args, request);
+    const unsigned long arg = va_arg(args, unsigned long);
+    va_end(args);
+
+    if (!adapter_functionality)
+        return ioctl(fd, request, arg);
+
+    switch (request)
+    {
+    case I2C_FUNCS:
+        *(unsigned long*)arg = adapter_functionality;
+        return 0;
+
+    case I2C_SLAVE:
+        adapter_slave = arg;
+        return 0;
+
+    case I2C_RDWR:
+    {
+        const struct i2c_rdwr_ioctl_data *const rdwr = (const struct i2c_rdwr_ioctl_data*)arg;
+        if (!(adapter_functionality & I2C_FUNC_I2C))
+            break;
+
+        // A register address write, then either the data or a repeated start read
+        uint8_t reg = 0;
+        for (uint32_t i = 0; i < rdwr->nmsgs; ++i)
+        {
+            const struct i2c_msg *const m = &rdwr->msgs[i];
+            if (m->addr != TAA3040_BENCH_ADDRESS)
+            {
+                errno = ENXIO;
+                return -1;
+            }
+            if (m->flags & I2C_M_RD)
+                taa3040_bench_model_read(reg, m->buf, (uint8_t)m->len);
+            else
+            {
+                reg = m->buf[0];
+                if (m->len > 1)
+                    taa3040_bench_model_write(reg, &m->buf[1], (uint8_t)(m->len - 1));
+            }
+        }
+        return (int)rdwr->nmsgs;
+    }
+
+    case I2C_SMBUS:
+    {
+        const struct i2c_smbus_ioctl_data *const smbus = (const struct i2c_smbus_ioctl_data*)arg;
+        if (adapter_slave != TAA3040_BENCH_ADDRESS)
+        {
+            errno = ENXIO;
+            return -1;
+        }
+
+        const bool byte = smbus->size == I2C_SMBUS_BYTE_DATA;
+        uint8_t *const data = byte? &smbus->data->byte: &smbus->data->block[1];
+        const uint8_t length = byte? 1: smbus->data->block[0];
+        if (smbus->read_write == I2C_SMBUS_READ)
+            taa3040_bench_model_read(smbus->command, data, length);
+        else
+            taa3040_bench_model_write(smbus->command, data, length);
+        return 0;
+    }
+
+    default:
+        break;
+    }
+
+    errno = EINVAL;
+    return -1;
+}
+
+/* Drive the calls through the i2c-dev HAL over a /dev/i2c-N node or a modelled adapter */
+static bool taa3040_bench_open_bus(const char *const path, taa3040_hal_t *const hal)
+{
+    if (!strcmp(path, "model-i2c"))
+        adapter_functionality = I2C_FUNC_I2C | I2C_FUNC_SMBUS_BYTE_DATA | I2C_FUNC_SMBUS_I2C_BLOCK;
+    else if (!strcmp(path, "model-smbus"))
+        adapter_functionality = I2C_FUNC_SMBUS_BYTE_DATA | I2C_FUNC_SMBUS_I2C_BLOCK;
+
+    return taa3040_linux_i2c_open(&bus, adapter_functionality? "/dev/null": path) && taa3040_linux_i2c_hal(&bus, hal);
+}
+
+static inline uint32_t taa3040_bench_ioctls(void)
+{
+    return bus.ioctls;
+}
+
+#else
+
+static inline uint32_t taa3040_bench_ioctls(void)
+{
+    return 0;
+}
+
+#endif
+
+/* === Benchmarked Calls === */
+
+static taa3040_t dev;
+static taa3040_hal_t hal;
+static taa3040_config_t config;
+static taa3040_config_t config_out;
+static taa3040_packed_config_t packed;
+static taa3040_status_t status;
+static taa3040_biquad_filter_t biquad;
+static taa3040_register_write_t upload_log[TAA3040_IMAGE_SIZE];
+static uint8_t image[TAA3040_IMAGE_SIZE];
+static uint8_t blob[TAA3040_BLOB_MAX_SIZE];
+static size_t blob_size;
+static uint8_t scratch[TAA3040_PAGE_SIZE];
+static uint8_t byte_value;
+static float gain_levels[TAA3040_NUM_CHANNELS] = { 0, 6, 12, 18, 24, 30, 36, 42 };
+static float volume_levels[TAA3040_NUM_CHANNELS] = { 0, -3, -6, -9, -12, -15, -18, -21 };
+static float gain_levels_out[TAA3040_NUM_CHANNELS];
+static float volume_levels_out[TAA3040_NUM_CHANNELS];
+static taa3040_eq_point_t eq_points[TAA3040_EQ_MAX_POINTS];
+static taa3040_biquad_filter_t eq_filters[TAA3040_EQ_MAX_SECTIONS];
+
+#define TAA3040_BENCH(name, call) static bool taa3040_bench_##name(void) { return (call); }
+
+TAA3040_BENCH(init,                     taa3040_init(&dev, &hal, TAA3040_BENCH_ADDRESS))
+TAA3040_BENCH(reset,                    taa3040_reset(&dev))
+TAA3040_BENCH(sleep,                    taa3040_sleep(&dev))
+TAA3040_BENCH(wake,                     taa3040_wake(&dev))
+TAA3040_BENCH(startup,                  taa3040_startup(&dev))
+TAA3040_BENCH(shutdown,                 taa3040_shutdown(&dev))
+TAA3040_BENCH(set_device_config,        taa3040_set_device_config(&dev, &config))
+TAA3040_BENCH(get_device_config,        taa3040_get_device_config(&dev, &config_out))
+TAA3040_BENCH(set_asi_config,           taa3040_set_asi_config(&dev, &config.asi_config))
+TAA3040_BENCH(get_asi_config,           taa3040_get_asi_config(&dev, &config_out.asi_config))
+TAA3040_BENCH(set_channel_config,       taa3040_set_channel_config(&dev, 3, &config.channel_configs[3]))
+TAA3040_BENCH(get_channel_config,       taa3040_get_channel_config(&dev, 3, &config_out.channel_configs[3]))
+TAA3040_BENCH(set_channel_configs,      taa3040_set_channel_configs(&dev, config.channel_configs))
+TAA3040_BENCH(get_channel_configs,      taa3040_get_channel_configs(&dev, config_out.channel_configs))
+TAA3040_BENCH(set_mixer_channel_config, taa3040_set_mixer_channel_config(&dev, 3, &config.mixer_config.channels[3]))
+TAA3040_BENCH(get_mixer_channel_config, taa3040_get_mixer_channel_config(&dev, 3, &config_out.mixer_config.channels[3]))
+TAA3040_BENCH(set_mixer_config,         taa3040_set_mixer_config(&dev, &config.mixer_config))
+TAA3040_BENCH(get_mixer_config,         taa3040_get_mixer_config(&dev, &config_out.mixer_config))
+TAA3040_BENCH(set_system_config,        taa3040_set_system_config(&dev, &config.system_config))
+TAA3040_BENCH(set_dsp_config,           taa3040_set_dsp_config(&dev, &config.dsp_config))
+TAA3040_BENCH(get_dsp_config,           taa3040_get_dsp_config(&dev, &config_out.dsp_config))
+TAA3040_BENCH(set_gpio_config,          taa3040_set_gpio_config(&dev, &config.gpio_config))
+TAA3040_BENCH(get_gpio_config,          taa3040_get_gpio_config(&dev, &config_out.gpio_config))
+TAA3040_BENCH(set_interrupt_config,     taa3040_set_interrupt_config(&dev, &config.interrupt_config))
+TAA3040_BENCH(get_interrupt_config,     taa3040_get_interrupt_config(&dev, &config_out.interrupt_config))
+TAA3040_BENCH(set_gain_db,              taa3040_set_gain_db(&dev, 3, 20))
+TAA3040_BENCH(get_gain_db,              taa3040_get_gain_db(&dev, 3, &byte_value))
+TAA3040_BENCH(set_digital_volume,       taa3040_set_digital_volume(&dev, 3, 201))
+TAA3040_BENCH(get_digital_volume,       taa3040_get_digital_volume(&dev, 3, &byte_value))
+TAA3040_BENCH(set_levels,               taa3040_set_levels(&dev, 0xFF, gain_levels, volume_levels))
+TAA3040_BENCH(get_levels,               taa3040_get_levels(&dev, gain_levels_out, volume_levels_out))
+TAA3040_BENCH(set_filter,               taa3040_set_filter(&dev, 7, &biquad))
+TAA3040_BENCH(get_filter,               taa3040_get_filter(&dev, 7, &biquad))
+TAA3040_BENCH(enable_channel,           taa3040_enable_channel(&dev, 3))
+TAA3040_BENCH(disable_channel,          taa3040_disable_channel(&dev, 3))
+TAA3040_BENCH(get_status,               taa3040_get_status(&dev, &status))
+TAA3040_BENCH(set_page,                 taa3040_set_page(&dev, 0))
+TAA3040_BENCH(write_registers,          taa3040_write_registers(&dev, TAA3040_BLOCK_CHANNEL_START, scratch, TAA3040_BLOCK_CHANNEL_LENGTH))
+TAA3040_BENCH(read_registers,           taa3040_read_registers(&dev, TAA3040_BLOCK_CHANNEL_START, scratch, TAA3040_BLOCK_CHANNEL_LENGTH))
+TAA3040_BENCH(write_image,              taa3040_write_image(&dev, image))
+TAA3040_BENCH(read_image,               taa3040_read_image(&dev, image))
+TAA3040_BENCH(upload_device_config,     taa3040_upload_device_config(&dev, &config, upload_log, TAA3040_IMAGE_SIZE, NULL))
+TAA3040_BENCH(set_packed_config,        taa3040_set_packed_config(&dev, &packed))
+TAA3040_BENCH(get_packed_config,        taa3040_get_packed_config(&dev, &packed))
+TAA3040_BENCH(blob_load,                taa3040_blob_load(&dev, blob, blob_size))
+
+static bool taa3040_bench_image_encode(void) { taa3040_image_encode(&config, image); return true; }
+static bool taa3040_bench_image_decode(void) { taa3040_image_decode(image, &config_out); return true; }
+static bool taa3040_bench_pack_config(void) { taa3040_pack_config(&config, &packed); return true; }
+static bool taa3040_bench_unpack_config(void) { taa3040_unpack_config(&packed, &config_out); return true; }
+static bool taa3040_bench_blob_encode(void) { return taa3040_blob_encode(&config, blob, sizeof(blob)) != 0; }
+static bool taa3040_bench_blob_decode(void) { return taa3040_blob_decode(blob, blob_size, &config_out); }
+static bool taa3040_bench_eq_fit(void)
+{
+    return taa3040_eq_fit(eq_points, TAA3040_EQ_MAX_POINTS, 48000, TAA3040_EQ_MAX_SECTIONS, eq_filters, NULL);
+}
+
+#if defined(__linux__)
+static taa3040_recorder_t recorder;
+static taa3040_linux_files_t recorder_files = { .pattern = TAA3040_BENCH_RECORDER_PATH, .direct = true };
+static uint8_t recorder_blocks[4 * TAA3040_BENCH_RECORDER_BLOCK] __attribute__((aligned(TAA3040_BENCH_RECORDER_BLOCK)));
+static uint8_t recorder_header[TAA3040_BENCH_RECORDER_BLOCK] __attribute__((aligned(TAA3040_BENCH_RECORDER_BLOCK)));
+static int32_t recorder_frames[TAA3040_BENCH_RECORDER_FRAMES * TAA3040_NUM_CHANNELS];
+
+static bool taa3040_bench_recorder_write(void)
+{
+    return taa3040_recorder_push(&recorder, recorder_frames, TAA3040_BENCH_RECORDER_FRAMES) == TAA3040_BENCH_RECORDER_FRAMES
+        && taa3040_recorder_drain(&recorder);
+}
+
+static bool taa3040_bench_recorder_open(void)
+{
+    const taa3040_recorder_config_t recorder_config = {
+        .channels = TAA3040_NUM_CHANNELS,
+        .valid_bits = 24,
+        .sample_rate = 48000,
+        .blocks = recorder_blocks,
+        .block_bytes = TAA3040_BENCH_RECORDER_BLOCK,
+        .block_count = sizeof(recorder_blocks) / TAA3040_BENCH_RECORDER_BLOCK,
+        .header = recorder_header,
+        .header_bytes = TAA3040_BENCH_RECORDER_BLOCK,
+        .max_file_bytes = 1024 * TAA3040_BENCH_RECORDER_BLOCK,
+    };
+    taa3040_recorder_sink_t sink;
+    return taa3040_linux_recorder_sink(&recorder_files, &sink) && taa3040_recorder_init(&recorder, &recorder_config, &sink);
+}
+
+static void taa3040_bench_recorder_close(void)
+{
+    taa3040_recorder_flush(&recorder);
+    taa3040_recorder_finish(&recorder);
+    unlink(TAA3040_BENCH_RECORDER_PATH);
+}
+#endif
+
+typedef struct {
+    const char* name;
+    bool (*call)(void);
+} taa3040_bench_case_t;
+
+#define TAA3040_BENCH_CASE(name) { "taa3040_" #name, taa3040_bench_##name }
+
+static const taa3040_bench_case_t TAA3040_BENCH_CASES[] = {
+    TAA3040_BENCH_CASE(init),
+    TAA3040_BENCH_CASE(reset),
+    TAA3040_BENCH_CASE(sleep),
+    TAA3040_BENCH_CASE(wake),
+    TAA3040_BENCH_CASE(startup),
+    TAA3040_BENCH_CASE(shutdown),
+    TAA3040_BENCH_CASE(set_device_config),
+    TAA3040_BENCH_CASE(get_device_config),
+    TAA3040_BENCH_CASE(set_asi_config),
+    TAA3040_BENCH_CASE(get_asi_config),
+    TAA3040_BENCH_CASE(set_channel_config),
+    TAA3040_BENCH_CASE(get_channel_config),
+    TAA3040_BENCH_CASE(set_channel_configs),
+    TAA3040_BENCH_CASE(get_channel_configs),
+    TAA3040_BENCH_CASE(set_mixer_channel_config),
+    TAA3040_BENCH_CASE(get_mixer_channel_config),
+    TAA3040_BENCH_CASE(set_mixer_config),
+    TAA3040_BENCH_CASE(get_mixer_config),
+    TAA3040_BENCH_CASE(set_system_config),
+    TAA3040_BENCH_CASE(set_dsp_config),
+    TAA3040_BENCH_CASE(get_dsp_config),
+    TAA3040_BENCH_CASE(set_gpio_config),
+    TAA3040_BENCH_CASE(get_gpio_config),
+    TAA3040_BENCH_CASE(set_interrupt_config),
+    TAA3040_BENCH_CASE(get_interrupt_config),
+    TAA3040_BENCH_CASE(set_gain_db),
+    TAA3040_BENCH_CASE(get_gain_db),
+    TAA3040_BENCH_CASE(set_digital_volume),
+    TAA3040_BENCH_CASE(get_digital_volume),
+    TAA3040_BENCH_CASE(set_levels),
+    TAA3040_BENCH_CASE(get_levels),
+    TAA3040_BENCH_CASE(set_filter),
+    TAA3040_BENCH_CASE(get_filter),
+    TAA3040_BENCH_CASE(enable_channel),
+    TAA3040_BENCH_CASE(disable_channel),
+    TAA3040_BENCH_CASE(get_status),
+    TAA3040_BENCH_CASE(set_page),
+    TAA3040_BENCH_CASE(write_registers),
+    TAA3040_BENCH_CASE(read_registers),
+    TAA3040_BENCH_CASE(write_image),
+    TAA3040_BENCH_CASE(read_image),
+    TAA3040_BENCH_CASE(upload_device_config),
+    TAA3040_BENCH_CASE(set_packed_config),
+    TAA3040_BENCH_CASE(get_packed_config),
+    TAA3040_BENCH_CASE(blob_load),
+    TAA3040_BENCH_CASE(image_encode),
+    TAA3040_BENCH_CASE(image_decode),
+    TAA3040_BENCH_CASE(pack_config),
+    TAA3040_BENCH_CASE(unpack_config),
+    TAA3040_BENCH_CASE(blob_encode),
+    TAA3040_BENCH_CASE(blob_decode),
+    TAA3040_BENCH_CASE(eq_fit),
+#if defined(__linux__)
+    TAA3040_BENCH_CASE(recorder_write),
+#endif
+};
+
+/* === Measurement === */
+
+static inline uint64_t taa3040_bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t taa3040_bench_cycles(void)
+{
+#ifdef TAA3040_BENCH_TIMER
+    return __rdtsc();
+#else
+    return taa3040_bench_now_ns();  // No cycle counter, report nanoseconds instead
+#endif
+}
+
+static inline long long taa3040_bench_heap_in_use(void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return (long long)mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+    return (long long)mallinfo().uordblks;
+#else
+    return 0;
+#endif
+}
+
+static void taa3040_bench_reset_model(void)
+{
+    memset(&model, 0, sizeof(model));
+}
+
+static void taa3040_bench_run(const taa3040_bench_case_t *const c, const uint32_t iterations, const bool last)
+{
+    // Bus traffic of one call, from a known device state
+    taa3040_bench_reset_model();
+    taa3040_init(&dev, &hal, TAA3040_BENCH_ADDRESS);
+    taa3040_write_image(&dev, image);
+    model.reads = model.writes = model.bytes_read = model.bytes_written = 0;
+    const uint32_t ioctls_before = taa3040_bench_ioctls();
+
+    const long long heap_before = taa3040_bench_heap_in_use();
+    const bool ok = c->call();
+    const long long heap = taa3040_bench_heap_in_use() - heap_before;
+    const uint32_t ioctls = taa3040_bench_ioctls() - ioctls_before;
+    const uint32_t reads = model.reads, writes = model.writes;
+    const uint32_t bytes_read = model.bytes_read, bytes_written = model.bytes_written;
+
+    uint64_t total = 0, best = UINT64_MAX;
+    const uint64_t start_ns = taa3040_bench_now_ns();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        const uint64_t t0 = taa3040_bench_cycles();
+        c->call();
+        const uint64_t t = taa3040_bench_cycles() - t0;
+        total += t;
+        if (t < best)
+            best = t;
+    }
+    const uint64_t elapsed_ns = taa3040_bench_now_ns() - start_ns;
+
+    printf("    {\"api\": \"%s\", \"ok\": %s, \"cycles_min\": %llu, \"cycles_mean\": %llu, \"ns_mean\": %llu, "
+           "\"heap_bytes\": %lld, \"transactions\": %u, \"reads\": %u, \"writes\": %u, "
+           "\"bytes_read\": %u, \"bytes_written\": %u, \"bytes\": %u, \"ioctls\": %u}%s\n",
+        c->name, ok? "true": "false", (unsigned long long)best, (unsigned long long)(total / iterations),
+        (unsigned long long)(elapsed_ns / iterations), heap, reads + writes, reads, writes,
+        bytes_read, bytes_written, bytes_read + bytes_written, ioctls, last? "": ",");
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t iterations = TAA3040_BENCH_ITERATIONS;
+    if (argc > 1)
+        iterations = (uint32_t)strtoul(argv[1], NULL, 10);
+    if (iterations == 0)
+        iterations = 1;
+
+    const char *const bus_name = argc > 2? argv[2]: "model";
+    hal.i2c_read = taa3040_bench_i2c_read;
+    hal.i2c_write = taa3040_bench_i2c_write;
+#if defined(__linux__)
+    if (argc > 2 && !taa3040_bench_open_bus(bus_name, &hal))
+    {
+        fprintf(stderr, "cannot open bus %s\n", bus_name);
+        return 1;
+    }
+#else
+    if (argc > 2)
+        return 1;
+#endif
+#ifndef TAA3040_REDUCED_HAL
+    hal.enable_write = taa3040_bench_enable_write;
+#endif
+
+    // A configuration that exercises every block, so encoders cannot take shortcuts
+    config = TAA3040_DEFAULT_CONFIG;
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        config.channel_configs[ch].enabled = true;
+        config.channel_configs[ch].gain_db = (uint8_t)(10 + ch);
+        config.asi_config.channel_configs[ch].enabled = true;
+        config.asi_config.channel_configs[ch].slot = ch;
+    }
+    for (uint8_t i = 0; i < TAA3040_NUM_BIQUADS; ++i)
+        config.dsp_config.biquad_filters[i].n0 = 0x40000000 - i;
+    biquad = config.dsp_config.biquad_filters[7];
+    taa3040_image_encode(&config, image);
+    taa3040_pack_config(&config, &packed);
+    blob_size = taa3040_blob_encode(&config, blob, sizeof(blob));
+
+    // The largest fit: every point, every section, a target of a boost, a notch and a presence lift
+    for (uint8_t i = 0; i < TAA3040_EQ_MAX_POINTS; ++i)
+    {
+        const double decade = 1.3 + 3.0 * i / (TAA3040_EQ_MAX_POINTS - 1);
+        eq_points[i].frequency_hz = (float)pow(10.0, decade);
+        eq_points[i].gain_db = (float)(6.0 * exp(-pow((decade - 2.0) / 0.25, 2)) - 4.0 * exp(-pow((decade - 3.3) / 0.15, 2))
+                                     + 3.0 * exp(-pow((decade - 4.0) / 0.3, 2)));
+        eq_points[i].weight = 1.0f;
+    }
+#if defined(__linux__)
+    if (!taa3040_bench_recorder_open())
+        return 1;
+#endif
+
+    const size_t count = sizeof(TAA3040_BENCH_CASES) / sizeof(TAA3040_BENCH_CASES[0]);
+    printf("{\n  \"driver\": \"taa3040\",\n  \"iterations\": %u,\n  \"bus\": \"%s\",\n", iterations, bus_name);
+#ifdef TAA3040_BENCH_TIMER
+    printf("  \"cycle_source\": \"%s\",\n", TAA3040_BENCH_TIMER);
+#else
+    printf("  \"cycle_source\": \"ns\",\n");
+#endif
+    printf("  \"results\": [\n");
+    for (size_t i = 0; i < count; ++i)
+        taa3040_bench_run(&TAA3040_BENCH_CASES[i], iterations, i + 1 == count);
+    printf("  ]\n}\n");
+#if defined(__linux__)
+    taa3040_bench_recorder_close();
+    if (argc > 2)
+        taa3040_linux_i2c_close(&bus);
+#endif
+    return 0;
+}
@@ -117,6 +117,8 @@ bool taa3040_get_asi_config(const taa3040_t *const dev, taa3040_asi_config_t *co
 /**
  * @brief Configure a single input channel.
  *
+ * Powers the channel up or down to match ch_config->enabled, as taa3040_get_channel_config reads it back.
+ *
  * @param[in] dev Device handle.
  * @param[in] channel Channel index (0–7).
  * @param[in] ch_config Pointer to constant channel configuration.
@@ -134,6 +136,24 @@ bool taa3040_set_channel_config(const taa3040_t *const dev, uint8_t channel, con
  */
 bool taa3040_get_channel_config(const taa3040_t *const dev, uint8_t channel, taa3040_channel_config_t *const ch_config);
 
+/**
+ * @brief Configure all input channels with one burst over the channel blocks and one enable write.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] ch_configs Configurations of channels 0–7.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_set_channel_configs(const taa3040_t *const dev, const taa3040_channel_config_t ch_configs[TAA3040_NUM_CHANNELS]);
+
+/**
+ * @brief Read the configuration of all input channels with one burst.
+ *
+ * @param[in] dev Device handle.
+ * @param[out] ch_configs Configurations of channels 0–7 to fill.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_get_channel_configs(const taa3040_t *const dev, taa3040_channel_config_t ch_configs[TAA3040_NUM_CHANNELS]);
+
 /* === Mixer Configuration === */
 
 /**
@@ -174,6 +194,16 @@ bool taa3040_set_mixer_config(const taa3040_t *const dev, const taa3040_mixer_co
  */
 bool taa3040_get_mixer_config(const taa3040_t *const dev, taa3040_mixer_config_t *const mixer_config);
 
+/**
+ * @brief Set power, regulator, quick charge and PDM clocking.
+ *
+ * Writes POWER_CONFIG, SLEEP_CFG (keeping the current sleep state), SHUTDOWN_CFG,
+ * PDMCLK_CONFIG and PDMIN_CONFIG.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] config Pointer to constant system configuration.
+ * @return true if successful, false otherwise.
+ */
 bool taa3040_set_system_config(const taa3040_t* const dev, const taa3040_system_config_t* const config);
 
 /**
@@ -274,6 +304,31 @@ bool taa3040_set_digital_volume(const taa3040_t *const dev, uint8_t channel, uin
  */
 bool taa3040_get_digital_volume(const taa3040_t *const dev, uint8_t channel, uint8_t *const volume_code);
 
+/**
+ * @brief Set the gain and digital volume of several channels in dB, with one read and one burst write.
+ *
+ * Gains are rounded to 1 dB in 0 to 42 dB, volumes to 0.5 dB in -100 to +27 dB, and
+ * volumes below -100 dB mute the channel.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] mask Channels to set, TAA3040_CHANNEL_BIT of each channel (IN_CHANNEL_EN order).
+ * @param[in] gain_db Analog gain of each channel, indexed by channel.
+ * @param[in] volume_db Digital volume of each channel, indexed by channel.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_set_levels(const taa3040_t *const dev, const uint8_t mask, const float gain_db[TAA3040_NUM_CHANNELS],
+                        const float volume_db[TAA3040_NUM_CHANNELS]);
+
+/**
+ * @brief Read the gain and digital volume of all channels in dB, with one burst.
+ *
+ * @param[in] dev Device handle.
+ * @param[out] gain_db Analog gain of each channel (may be NULL).
+ * @param[out] volume_db Digital volume of each channel, -INFINITY when muted (may be NULL).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_get_levels(const taa3040_t *const dev, float gain_db[TAA3040_NUM_CHANNELS], float volume_db[TAA3040_NUM_CHANNELS]);
+
 /**
  * @brief 
  * 
@@ -330,6 +385,110 @@ bool taa3040_disable_channel(const taa3040_t* const dev, const uint8_t channel);
  */
 bool taa3040_get_status(const taa3040_t *const dev, taa3040_status_t *const status);
 
+/* === Raw Register Access === */
+
+/**
+ * @brief Select the register page that following raw accesses address.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] page Page number.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_set_page(const taa3040_t *const dev, const uint8_t page);
+
+/**
+ * @brief Write consecutive registers of the current page in one transfer.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] reg First register address.
+ * @param[in] data Register contents.
+ * @param[in] length Number of registers to write.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_write_registers(const taa3040_t *const dev, const uint8_t reg, const uint8_t *const data, const uint8_t length);
+
+/**
+ * @brief Read consecutive registers of the current page in one transfer.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] reg First register address.
+ * @param[out] data Buffer receiving the register contents.
+ * @param[in] length Number of registers to read.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_read_registers(const taa3040_t *const dev, const uint8_t reg, uint8_t *const data, const uint8_t length);
+
+/**
+ * @brief Program every register of a register image, one transfer per run.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] image Register image of TAA3040_IMAGE_SIZE bytes (see taa3040_image.h).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_write_image(const taa3040_t *const dev, const uint8_t *const image);
+
+/**
+ * @brief Program some of the runs of a register image, in run order, one transfer per run.
+ *
+ * Leaves the device on page 0, also when a write fails.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] image Register image of TAA3040_IMAGE_SIZE bytes (see taa3040_image.h).
+ * @param[in] runs Runs to write, bit i for TAA3040_IMAGE_RUNS[i].
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_write_image_runs(const taa3040_t *const dev, const uint8_t *const image, const uint32_t runs);
+
+/**
+ * @brief Read every register of a register image, one transfer per run.
+ *
+ * @param[in] dev Device handle.
+ * @param[out] image Buffer of TAA3040_IMAGE_SIZE bytes.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_read_image(const taa3040_t *const dev, uint8_t *const image);
+
+/* === Checksum Verified Upload === */
+
+/**
+ * @brief Start a checksum verified upload.
+ *
+ * Resets the device's I2C checksum register and attaches the upload to the device, so
+ * every following write through the driver is summed on the host as it is sent.
+ *
+ * @param[in] dev Device handle.
+ * @param[out] upload Upload state, must stay valid until taa3040_upload_end.
+ * @param[in] log Optional buffer recording every register write, used to locate mismatches (may be NULL).
+ * @param[in] log_capacity Number of entries in log, one per register byte written.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_upload_begin(taa3040_t *const dev, taa3040_upload_t *const upload, taa3040_register_write_t *const log, const uint16_t log_capacity);
+
+/**
+ * @brief Finish a checksum verified upload with a single checksum read.
+ *
+ * Registers are only read back individually when the checksum disagrees. In that case
+ * the first entries of the upload log are replaced by the registers whose contents differ.
+ * If the log overflowed, or no log was given, mismatches may be reported as 0 on failure.
+ *
+ * @param[in] dev Device handle.
+ * @param[out] mismatches Number of logged registers that read back differently (may be NULL).
+ * @return true if the device checksum matched, false otherwise.
+ */
+bool taa3040_upload_end(taa3040_t *const dev, uint16_t *const mismatches);
+
+/**
+ * @brief Apply a full device configuration and verify it with the I2C checksum.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] config Pointer to constant configuration data.
+ * @param[in] log Optional buffer used to locate mismatches (may be NULL).
+ * @param[in] log_capacity Number of entries in log.
+ * @param[out] mismatches Number of registers that read back differently (may be NULL).
+ * @return true if the configuration was written and verified, false otherwise.
+ */
+bool taa3040_upload_device_config(taa3040_t *const dev, const taa3040_config_t *const config, taa3040_register_write_t *const log, const uint16_t log_capacity, uint16_t *const mismatches);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,182 @@
+/**
+ * @file taa3040_asrc.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Clock drift estimation and asynchronous resampling across devices
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_ASRC_H
+#define TAA3040_ASRC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "taa3040_types.h"
+
+/*
+ * Devices clocked from independent oscillators deliver frames at slightly different
+ * rates, tens of ppm apart, so their streams slide past each other by a frame every few
+ * seconds. One device is picked as the master and every other device is resampled onto
+ * its timeline.
+ *
+ * The drift estimator of a device is fed the frames the master and the device delivered
+ * over the same interval, and the frames its resampler produced. It averages the rate
+ * ratio over windows of master frames, then adds a correction proportional to how far
+ * the resampled stream is ahead of or behind the master. The step it returns
+ * converges to the true ratio and the resampled stream stays aligned to the master.
+ *
+ * The resampler is a windowed sinc polyphase filter, interpolating linearly between
+ * phases. It works on interleaved frames of TAA3040_NUM_CHANNELS words, so each output
+ * frame is one pass over the taps with all channels in the innermost loop. That loop has
+ * a fixed trip count over contiguous floats, which compilers vectorize without
+ * intrinsics. The filter table is built once and may be shared by any number of
+ * resamplers.
+ *
+ * Ratios and steps are Q32.32: input frames per output frame, 1 << 32 for no drift.
+ */
+
+#ifndef TAA3040_ASRC_TAPS
+#define TAA3040_ASRC_TAPS       (32)    ///< Taps per phase, even, may be overridden at build time
+#endif
+
+#ifndef TAA3040_ASRC_PHASES
+#define TAA3040_ASRC_PHASES     (128)   ///< Phases of the filter table, may be overridden at build time
+#endif
+
+#define TAA3040_ASRC_ONE        (1ULL << 32)    ///< A ratio of 1 in Q32.32
+
+/* === Drift Estimation === */
+
+/**
+ * @brief Drift of one device against the master.
+ */
+typedef struct {
+    uint64_t ratio;             ///< Averaged device / master frame rate, Q32.32
+    int64_t error;              ///< Frames produced by the resampler minus frames from the master, Q32.32
+    uint32_t window;            ///< Master frames averaged per ratio measurement
+    uint32_t horizon;           ///< Master frames over which an alignment error is corrected
+    uint32_t window_master;     ///< Master frames in the current window
+    uint32_t window_frames;     ///< Device frames in the current window
+    uint8_t smoothing_shift;    ///< Each window moves the ratio by 1 / 2^shift of its difference
+    bool primed;                ///< A full window set the ratio
+} taa3040_drift_t;
+
+/**
+ * @brief Initialize a drift estimator.
+ *
+ * @param[out] drift Estimator to initialize.
+ * @param[in] window Master frames per ratio measurement, about a second of audio.
+ * @param[in] horizon Master frames over which alignment errors are corrected, several windows.
+ * @param[in] smoothing_shift Averaging across windows, 0 takes each window as is.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_drift_init(taa3040_drift_t *const drift, const uint32_t window, const uint32_t horizon, const uint8_t smoothing_shift);
+
+/**
+ * @brief Account for one interval.
+ *
+ * @param[in,out] drift Estimator.
+ * @param[in] master_frames Frames the master delivered in the interval.
+ * @param[in] frames Frames this device delivered in the same interval.
+ * @param[in] produced Frames its resampler produced from them.
+ */
+void taa3040_drift_update(taa3040_drift_t *const drift, const uint32_t master_frames, const uint32_t frames, const uint32_t produced);
+
+/**
+ * @brief Resampling step that tracks the master.
+ *
+ * @param[in] drift Estimator.
+ * @return Input frames per output frame, Q32.32.
+ */
+uint64_t taa3040_drift_step(const taa3040_drift_t *const drift);
+
+/**
+ * @brief Averaged drift of the device.
+ *
+ * @param[in] drift Estimator.
+ * @return Parts per million the device runs faster than the master (negative when slower).
+ */
+int32_t taa3040_drift_ppm(const taa3040_drift_t *const drift);
+
+/* === Resampling === */
+
+/**
+ * @brief Polyphase filter table, one extra phase to interpolate towards.
+ */
+typedef struct {
+    float coeffs[TAA3040_ASRC_PHASES + 1][TAA3040_ASRC_TAPS];
+} taa3040_asrc_filter_t;
+
+/**
+ * @brief Design the filter table.
+ *
+ * A Blackman-Harris windowed sinc, each phase normalized to unity gain.
+ *
+ * @param[out] filter Table to fill.
+ * @param[in] cutoff Passband edge as a fraction of the sample rate, below 0.5 (0.45 keeps 20 kHz at 44.1 kHz).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_asrc_filter_init(taa3040_asrc_filter_t *const filter, const float cutoff);
+
+/**
+ * @brief Resampler of one device.
+ */
+typedef struct {
+    const taa3040_asrc_filter_t* filter;                                ///< Filter table
+    float history[2 * TAA3040_ASRC_TAPS][TAA3040_NUM_CHANNELS];         ///< Input frames, mirrored so the newest taps are contiguous
+    uint16_t position;                                                  ///< Next history slot
+    uint8_t channels;                                                   ///< Words per input and output frame
+    uint64_t phase;                                                     ///< Position of the next output past the newest input, Q32.32
+    uint64_t step;                                                      ///< Input frames per output frame, Q32.32
+} taa3040_asrc_t;
+
+/**
+ * @brief Initialize a resampler with silent history.
+ *
+ * The output lags the input by TAA3040_ASRC_TAPS / 2 frames.
+ *
+ * @param[out] asrc Resampler to initialize.
+ * @param[in] filter Filter table, must outlive the resampler.
+ * @param[in] channels Words per frame (1 - 8).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_asrc_init(taa3040_asrc_t *const asrc, const taa3040_asrc_filter_t *const filter, const uint8_t channels);
+
+/**
+ * @brief Change the step, usually to taa3040_drift_step once per interval.
+ *
+ * @param[in,out] asrc Resampler.
+ * @param[in] step Input frames per output frame, Q32.32, within 1/2 and 2.
+ */
+void taa3040_asrc_set_step(taa3040_asrc_t *const asrc, const uint64_t step);
+
+/**
+ * @brief Resample interleaved frames.
+ *
+ * Every input frame is consumed. The output count follows the step, frames / step
+ * give or take one, and is limited to capacity.
+ *
+ * @param[in,out] asrc Resampler.
+ * @param[in] input Interleaved input frames, channels words each.
+ * @param[in] frames Input frames.
+ * @param[out] output Interleaved output frames.
+ * @param[in] capacity Output frames that fit, at least frames * 2 + 1 never truncates.
+ * @return Output frames written.
+ */
+size_t taa3040_asrc_process(taa3040_asrc_t *const asrc, const int32_t *const input, const size_t frames,
+                            int32_t *const output, const size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_ASRC_H */
@@ -0,0 +1,679 @@
+/**
+ * @file taa3040_async.hpp
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Header-only C++20 coroutine interface to the TAA3040 over an asynchronous bus
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_ASYNC_HPP
+#define TAA3040_ASYNC_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "taa3040.h"
+
+/*
+ * Every call of the C API, in taa3040.h or any other module, can be awaited on a bus
+ * whose transfers complete later, so one thread can run any number of devices:
+ *
+ *   namespace taa = crablabs::taa3040;
+ *   taa::task<bool> bring_up(taa::async_device<bus>& dev, const taa3040_config_t* config)
+ *   {
+ *       taa3040_detected_clock_t clock;
+ *       co_return co_await dev.wake()
+ *              && co_await dev.wait_status(TAA3040_STATUS_ACTIVE_OFF, 10000, 500)
+ *              && co_await dev.set_device_config(config)
+ *              && co_await dev.poll(taa3040_rate_read, [](const taa3040_detected_clock_t& c) { return c.valid; }, 10000, 500, &clock);
+ *   }
+ *   taa::spawn(bring_up(dev, &config), [](bool ok) { ... });
+ *
+ * The C functions stay as they are. The device runs them against a HAL that records
+ * their transfers instead of performing them. Writes are queued and report success. The
+ * first read that has no recorded result fails the call. The queued writes and that read
+ * then go out on the bus, and the function runs again from the start with every transfer
+ * so far replayed from the record. A call with n reads therefore runs n + 1 times in
+ * memory, while the device sees each transfer once and in the order a blocking HAL
+ * would have issued them. Driver functions only decide what to transfer from what they
+ * read, so every run repeats the previous one up to its first new transfer. A run that
+ * does not is reported as a failure.
+ *
+ * Calls on one device are serialized, so no other call's transfers come between those
+ * of a call; calls awaited one after another may still alternate with calls made by
+ * other coroutines on the same device. Upload checking must be done within
+ * one call (taa3040_upload_device_config); taa3040_upload_begin and taa3040_upload_end
+ * awaited separately would fold replayed writes twice. Tracing is not supported.
+ *
+ * A transport performs the transfers. It is given a completion to call once each one is
+ * done, on the thread that runs the coroutines, possibly before returning:
+ *
+ *   struct bus {
+ *       void read(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length, taa::completion done);
+ *       void write(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t length, taa::completion done);
+ *       void sleep(uint32_t us, taa::completion done);
+ *       void enable(uint8_t address, bool state);  // optional, the enable pin
+ *   };
+ *
+ * Buffers stay valid until the completion is called.
+ */
+
+namespace crablabs
+{
+namespace taa3040   // nested, as the C device struct already owns the global name
+{
+
+/* === Coroutines === */
+
+/**
+ * @brief A lazily started coroutine producing a T, awaited by another coroutine or spawned.
+ */
+template <typename T>
+class [[nodiscard]] task
+{
+public:
+    struct promise_type
+    {
+        T value{};
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+
+        task get_return_object() noexcept { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        void return_value(T v) noexcept(std::is_nothrow_move_assignable_v<T>) { value = std::move(v); }
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        struct final_awaiter
+        {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept { return h.promise().continuation; }
+            void await_resume() noexcept {}
+        };
+        final_awaiter final_suspend() noexcept { return {}; }
+    };
+
+    task(task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+    task& operator=(task&&) = delete;
+
+    ~task()
+    {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept
+    {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    T await_resume() { return std::move(handle_.promise().value); }
+
+private:
+    explicit task(const std::coroutine_handle<promise_type> h) : handle_(h) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail
+{
+
+/** @brief A coroutine that starts at once and frees itself when done */
+struct detached
+{
+    struct promise_type
+    {
+        detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/** @brief State shared by a transfer and its completion */
+struct pending
+{
+    std::coroutine_handle<> handle;
+    bool ok = false;
+    bool finished = false;
+    bool suspended = false;
+};
+
+} // namespace detail
+
+/**
+ * @brief Start a task from outside a coroutine, e.g. from the event loop.
+ *
+ * @param[in] work Task to run until its first transfer, then from completions.
+ * @param[in] done Called with the result once the task finished.
+ */
+template <typename T, typename Done>
+detail::detached spawn(task<T> work, Done done)
+{
+    done(co_await work);
+}
+
+/** @brief Start a task whose result is not needed */
+template <typename T>
+detail::detached spawn(task<T> work)
+{
+    co_await work;
+}
+
+/**
+ * @brief Reports the end of one transfer to the coroutine waiting on it.
+ */
+class completion
+{
+public:
+    explicit completion(detail::pending *const p) noexcept : pending_(p) {}
+
+    /** @brief Finish the transfer; resumes the waiting coroutine unless it has not suspended yet */
+    void operator()(const bool ok) const
+    {
+        pending_->ok = ok;
+        pending_->finished = true;
+        if (pending_->suspended)
+            pending_->handle.resume();
+    }
+
+private:
+    detail::pending* pending_;
+};
+
+/**
+ * @brief Awaitable of one transport operation, started by Start(completion).
+ */
+template <typename Start>
+class transfer : private detail::pending
+{
+public:
+    explicit transfer(Start start) : start_(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(const std::coroutine_handle<> h)
+    {
+        handle = h;
+        start_(completion(this));
+
+        // Completed inside the call, carry on without suspending
+        suspended = !finished;
+        return suspended;
+    }
+
+    bool await_resume() const noexcept { return ok; }
+
+private:
+    Start start_;
+};
+
+/** @brief Requirements on a transport */
+template <typename T>
+concept async_transport = requires(T& t, const uint8_t address, const uint8_t reg, uint8_t *const in, const uint8_t *const out,
+                                   const uint8_t length, const uint32_t us, const completion done)
+{
+    t.read(address, reg, in, length, done);
+    t.write(address, reg, out, length, done);
+    t.sleep(us, done);
+};
+
+/* === Transfer Replay === */
+
+namespace detail
+{
+
+/**
+ * @brief Records the transfers of a driver call and replays them on later runs.
+ */
+class replay
+{
+protected:
+    enum class kind : uint8_t
+    {
+        read,
+        write,
+        enable_high,
+        enable_low,
+    };
+
+    struct op
+    {
+        kind type;
+        uint8_t reg;
+        uint8_t length;
+        uint32_t offset;    ///< Data in bytes_
+    };
+
+    /** @brief Run a driver function once, against the record */
+    template <typename F, typename... Args>
+    auto run(F& fn, Args&... args)
+    {
+        replay *const outer = active_;
+        active_ = this;
+        cursor_ = 0;
+        missed_ = false;
+        auto result = fn(&dev_, args...);
+        active_ = outer;
+        return result;
+    }
+
+    explicit replay(const uint8_t address)
+    {
+        const taa3040_hal_t hal = {
+            .i2c_read = hal_read,
+            .i2c_write = hal_write,
+#ifndef TAA3040_REDUCED_HAL
+            .enable_write = hal_enable,
+#endif
+        };
+
+        // Only fills in the device; its page 0 write is dropped, every call selects its page
+        const taa3040_hal_t *const h = &hal;
+        run(taa3040_init, h, address);
+        clear();
+    }
+
+    replay(const replay&) = delete;
+    replay& operator=(const replay&) = delete;
+
+    void clear()
+    {
+        ops_.clear();
+        bytes_.clear();
+        issued_ = 0;
+        diverged_ = false;
+    }
+
+    /** @brief Queue for one call at a time per device */
+    class lock
+    {
+    public:
+        explicit lock(replay& r) : owner_(r) {}
+        lock(const lock&) = delete;
+
+        bool await_ready() noexcept
+        {
+            if (owner_.busy_)
+                return false;
+            owner_.busy_ = true;
+            return true;
+        }
+
+        void await_suspend(const std::coroutine_handle<> h)
+        {
+            handle_ = h;
+            if (owner_.tail_)
+                owner_.tail_->next_ = this;
+            else
+                owner_.head_ = this;
+            owner_.tail_ = this;
+        }
+
+        void await_resume() noexcept {}
+
+    private:
+        friend class replay;
+
+        replay& owner_;
+        std::coroutine_handle<> handle_;
+        lock* next_ = nullptr;
+    };
+
+    /** @brief Releases the device when the call's frame goes */
+    class guard
+    {
+    public:
+        explicit guard(replay& r) : owner_(r) {}
+        guard(const guard&) = delete;
+
+        ~guard()
+        {
+            // Ownership passes straight to the next waiter, which runs until its first transfer
+            lock *const next = owner_.head_;
+            if (!next)
+            {
+                owner_.busy_ = false;
+                return;
+            }
+
+            owner_.head_ = next->next_;
+            if (!owner_.head_)
+                owner_.tail_ = nullptr;
+            next->handle_.resume();
+        }
+
+    private:
+        replay& owner_;
+    };
+
+    taa3040_t dev_;
+    std::vector<op> ops_;
+    std::vector<uint8_t> bytes_;
+    size_t issued_ = 0;             ///< Ops already on the bus
+    bool missed_ = false;           ///< The run stopped at a read without a result
+    bool diverged_ = false;         ///< A run asked for a different transfer than recorded
+
+private:
+    uint8_t* record(const kind type, const uint8_t reg, const uint8_t length)
+    {
+        ops_.push_back(op{type, reg, length, static_cast<uint32_t>(bytes_.size())});
+        bytes_.resize(bytes_.size() + length);
+        ++cursor_;
+        return bytes_.data() + ops_.back().offset;
+    }
+
+    /** @brief The recorded op at the cursor, if it is the same transfer */
+    const op* replayed(const kind type, const uint8_t reg, const uint8_t length)
+    {
+        const op& o = ops_[cursor_++];
+        if (o.type == type && o.reg == reg && o.length == length)
+            return &o;
+
+        diverged_ = missed_ = true;
+        return nullptr;
+    }
+
+    bool read(const uint8_t reg, void *const data, const uint8_t length)
+    {
+        if (missed_)
+            return false;
+
+        if (cursor_ == ops_.size())
+        {
+            record(kind::read, reg, length);
+            missed_ = true;
+            return false;
+        }
+
+        const op *const o = replayed(kind::read, reg, length);
+        if (!o)
+            return false;
+
+        memcpy(data, &bytes_[o->offset], length);
+        return true;
+    }
+
+    bool write(const uint8_t reg, const void *const data, const uint8_t length)
+    {
+        if (missed_)
+            return false;
+
+        if (cursor_ == ops_.size())
+        {
+            memcpy(record(kind::write, reg, length), data, length);
+            return true;
+        }
+
+        const op *const o = replayed(kind::write, reg, length);
+        if (o && memcmp(&bytes_[o->offset], data, length))
+            diverged_ = missed_ = true;
+        return !missed_;
+    }
+
+    void enable(const bool state)
+    {
+        const kind type = state? kind::enable_high: kind::enable_low;
+        if (missed_)
+            return;
+
+        if (cursor_ == ops_.size())
+            record(type, 0, 0);
+        else
+            replayed(type, 0, 0);
+    }
+
+#ifdef TAA3040_HAL_CONTEXT
+    static bool hal_read(void *const, const uint8_t, const uint8_t reg, void *const data, const uint8_t length)
+    {
+        return active_->read(reg, data, length);
+    }
+
+    static bool hal_write(void *const, const uint8_t, const uint8_t reg, const void *const data, const uint8_t length)
+    {
+        return active_->write(reg, data, length);
+    }
+
+    static void hal_enable(void *const, const bool state)
+    {
+        active_->enable(state);
+    }
+#else
+    static bool hal_read(const uint8_t, const uint8_t reg, void *const data, const uint8_t length)
+    {
+        return active_->read(reg, data, length);
+    }
+
+    static bool hal_write(const uint8_t, const uint8_t reg, const void *const data, const uint8_t length)
+    {
+        return active_->write(reg, data, length);
+    }
+
+    static void hal_enable(const bool state)
+    {
+        active_->enable(state);
+    }
+#endif
+
+    // Runs are synchronous, so the device being run is known without a HAL context
+    static inline thread_local replay* active_ = nullptr;
+
+    size_t cursor_ = 0;
+    bool busy_ = false;
+    lock* head_ = nullptr;
+    lock* tail_ = nullptr;
+};
+
+} // namespace detail
+
+/* === Device === */
+
+/**
+ * @brief A TAA3040 whose calls are awaited on an asynchronous transport.
+ */
+template <async_transport Transport>
+class async_device : private detail::replay
+{
+public:
+    /**
+     * @param[in] transport Bus the device is on, shared with other devices, must outlive the device.
+     * @param[in] address 7-bit I2C address.
+     */
+    async_device(Transport& transport, const uint8_t address) : replay(address), transport_(transport) {}
+
+    /**
+     * @brief Await any driver function taking the device first, e.g. call(taa3040_gpi_sample, &levels).
+     *
+     * Pointer arguments must stay valid until the call completes.
+     *
+     * @return The function's result, or a value initialized one (false) if a transfer failed.
+     */
+    template <typename F, typename... Args>
+    task<std::invoke_result_t<F&, taa3040_t*, Args&...>> call(F fn, Args... args)
+    {
+        using result = std::invoke_result_t<F&, taa3040_t*, Args&...>;
+
+        co_await lock(*this);
+        const guard held(*this);
+        clear();
+
+        for (;;)
+        {
+            const result r = run(fn, args...);
+            if (diverged_)
+                co_return result{};
+
+            // Queued writes first, then the read the run stopped at
+            for (; issued_ < ops_.size(); ++issued_)
+            {
+                if (!co_await issue(ops_[issued_]))
+                    co_return result{};
+            }
+
+            if (!missed_)
+                co_return r;
+        }
+    }
+
+    /** @brief Wait on the transport's timer */
+    auto delay_us(const uint32_t us)
+    {
+        return transfer([this, us](const completion done) { transport_.sleep(us, done); });
+    }
+
+    /**
+     * @brief Read with a getter until its result is ready, e.g. poll(taa3040_get_status, ...).
+     *
+     * @param[in] get Getter.
+     * @param[in] ready Predicate on the getter's result.
+     * @param[in] timeout_us Give up once this long was waited.
+     * @param[in] interval_us Wait between reads.
+     * @param[out] value Last result read.
+     * @return true once ready, false on a timeout or failed read.
+     */
+    template <typename T, typename Ready>
+    task<bool> poll(bool (*const get)(const taa3040_t*, T*), Ready ready, const uint32_t timeout_us, const uint32_t interval_us,
+                    T *const value)
+    {
+        for (uint32_t waited = 0;; waited += interval_us)
+        {
+            if (!co_await call(get, value))
+                co_return false;
+            if (ready(static_cast<const T&>(*value)))
+                co_return true;
+            if (waited >= timeout_us || !co_await delay_us(interval_us))
+                co_return false;
+        }
+    }
+
+    /** @brief Wait for the device to report a mode, e.g. TAA3040_STATUS_ACTIVE_OFF after wake */
+    task<bool> wait_status(const taa3040_device_status_t mode, const uint32_t timeout_us, const uint32_t interval_us)
+    {
+        taa3040_status_t status;
+        co_return co_await poll(taa3040_get_status, [mode](const taa3040_status_t& s) { return s.device_status == mode; },
+                                timeout_us, interval_us, &status);
+    }
+
+    /* --- taa3040.h --- */
+
+    task<bool> reset() { return call(taa3040_reset); }
+    task<bool> sleep() { return call(taa3040_sleep); }
+    task<bool> wake() { return call(taa3040_wake); }
+    task<bool> startup() { return call(taa3040_startup); }
+    task<bool> shutdown() { return call(taa3040_shutdown); }
+
+    task<bool> set_device_config(const taa3040_config_t *const config) { return call(taa3040_set_device_config, config); }
+    task<bool> get_device_config(taa3040_config_t *const config) { return call(taa3040_get_device_config, config); }
+    task<bool> set_asi_config(const taa3040_asi_config_t *const config) { return call(taa3040_set_asi_config, config); }
+    task<bool> get_asi_config(taa3040_asi_config_t *const config) { return call(taa3040_get_asi_config, config); }
+    task<bool> set_system_config(const taa3040_system_config_t *const config) { return call(taa3040_set_system_config, config); }
+    task<bool> set_dsp_config(const taa3040_dsp_config_t *const config) { return call(taa3040_set_dsp_config, config); }
+    task<bool> get_dsp_config(taa3040_dsp_config_t *const config) { return call(taa3040_get_dsp_config, config); }
+    task<bool> set_gpio_config(const taa3040_gpio_config_t *const config) { return call(taa3040_set_gpio_config, config); }
+    task<bool> get_gpio_config(taa3040_gpio_config_t *const config) { return call(taa3040_get_gpio_config, config); }
+    task<bool> set_interrupt_config(const taa3040_interrupt_config_t *const config) { return call(taa3040_set_interrupt_config, config); }
+    task<bool> get_interrupt_config(taa3040_interrupt_config_t *const config) { return call(taa3040_get_interrupt_config, config); }
+    task<bool> set_mixer_config(const taa3040_mixer_config_t *const config) { return call(taa3040_set_mixer_config, config); }
+    task<bool> get_mixer_config(taa3040_mixer_config_t *const config) { return call(taa3040_get_mixer_config, config); }
+
+    task<bool> set_channel_config(const uint8_t channel, const taa3040_channel_config_t *const config)
+    {
+        return call(taa3040_set_channel_config, channel, config);
+    }
+
+    task<bool> get_channel_config(const uint8_t channel, taa3040_channel_config_t *const config)
+    {
+        return call(taa3040_get_channel_config, channel, config);
+    }
+
+    task<bool> set_channel_configs(const taa3040_channel_config_t *const configs) { return call(taa3040_set_channel_configs, configs); }
+    task<bool> get_channel_configs(taa3040_channel_config_t *const configs) { return call(taa3040_get_channel_configs, configs); }
+
+    task<bool> set_mixer_channel_config(const uint8_t channel, const taa3040_mixer_channel_config_t *const config)
+    {
+        return call(taa3040_set_mixer_channel_config, channel, config);
+    }
+
+    task<bool> get_mixer_channel_config(const uint8_t channel, taa3040_mixer_channel_config_t *const config)
+    {
+        return call(taa3040_get_mixer_channel_config, channel, config);
+    }
+
+    task<bool> set_gain_db(const uint8_t channel, const uint8_t gain_db) { return call(taa3040_set_gain_db, channel, gain_db); }
+    task<bool> get_gain_db(const uint8_t channel, uint8_t *const gain_db) { return call(taa3040_get_gain_db, channel, gain_db); }
+    task<bool> set_digital_volume(const uint8_t channel, const uint8_t code) { return call(taa3040_set_digital_volume, channel, code); }
+    task<bool> get_digital_volume(const uint8_t channel, uint8_t *const code) { return call(taa3040_get_digital_volume, channel, code); }
+    task<bool> set_levels(const uint8_t mask, const float *const gain_db, const float *const volume_db)
+    {
+        return call(taa3040_set_levels, mask, gain_db, volume_db);
+    }
+
+    task<bool> get_levels(float *const gain_db, float *const volume_db) { return call(taa3040_get_levels, gain_db, volume_db); }
+    task<bool> set_filter(const uint8_t index, taa3040_biquad_filter_t *const filter) { return call(taa3040_set_filter, index, filter); }
+    task<bool> get_filter(const uint8_t index, taa3040_biquad_filter_t *const filter) { return call(taa3040_get_filter, index, filter); }
+    task<bool> enable_channel(const uint8_t channel) { return call(taa3040_enable_channel, channel); }
+    task<bool> disable_channel(const uint8_t channel) { return call(taa3040_disable_channel, channel); }
+    task<bool> get_status(taa3040_status_t *const status) { return call(taa3040_get_status, status); }
+
+    task<bool> write_registers(const uint8_t reg, const uint8_t *const data, const uint8_t length)
+    {
+        return call(taa3040_write_registers, reg, data, length);
+    }
+
+    task<bool> read_registers(const uint8_t reg, uint8_t *const data, const uint8_t length)
+    {
+        return call(taa3040_read_registers, reg, data, length);
+    }
+
+    task<bool> write_image(const uint8_t *const image) { return call(taa3040_write_image, image); }
+    task<bool> read_image(uint8_t *const image) { return call(taa3040_read_image, image); }
+
+    task<bool> upload_device_config(const taa3040_config_t *const config, taa3040_register_write_t *const log,
+                                    const uint16_t log_capacity, uint16_t *const mismatches)
+    {
+        return call(taa3040_upload_device_config, config, log, log_capacity, mismatches);
+    }
+
+private:
+    auto issue(const op o)
+    {
+        return transfer([this, o](const completion done) {
+            uint8_t *const data = bytes_.data() + o.offset;
+            switch (o.type)
+            {
+            case kind::read:
+                transport_.read(dev_.address, o.reg, data, o.length, done);
+                break;
+            case kind::write:
+                transport_.write(dev_.address, o.reg, data, o.length, done);
+                break;
+            default:
+                if constexpr (requires { transport_.enable(dev_.address, true); })
+                    transport_.enable(dev_.address, o.type == kind::enable_high);
+                done(true);
+                break;
+            }
+        });
+    }
+
+    Transport& transport_;
+};
+
+} // namespace taa3040
+} // namespace crablabs
+
+#endif /* TAA3040_ASYNC_HPP */
@@ -0,0 +1,111 @@
+/**
+ * @file taa3040_blob.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Versioned binary configuration blobs
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_BLOB_H
+#define TAA3040_BLOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "taa3040_types.h"
+#include "taa3040_image.h"
+
+/*
+ * A blob is a byte stream with no alignment requirements, so it can be stored as a
+ * const array in flash, mapped from a file or received over a link and used in place.
+ *
+ *   offset  size  field
+ *   0       4     magic "TAA3"
+ *   4       1     format version (TAA3040_BLOB_VERSION)
+ *   5       1     number of register runs
+ *   6       2     payload length in bytes, little-endian
+ *   8       4     CRC-32 (IEEE 802.3) of bytes 0-7 followed by the payload, little-endian
+ *   12      ...   payload: runs of [page][first register][length][length register values]
+ *
+ * Runs are programmed in the order they appear.
+ */
+
+#define TAA3040_BLOB_VERSION        (1)     ///< Format version written by this driver
+#define TAA3040_BLOB_HEADER_SIZE    (12)    ///< Bytes before the payload
+#define TAA3040_BLOB_RUN_HEADER     (3)     ///< Bytes before the data of each run
+
+/** @brief Size of a blob holding a full configuration */
+#define TAA3040_BLOB_MAX_SIZE       (TAA3040_BLOB_HEADER_SIZE + TAA3040_IMAGE_NUM_RUNS * TAA3040_BLOB_RUN_HEADER + TAA3040_IMAGE_SIZE)
+
+/**
+ * @brief Serialize a full configuration into a blob.
+ *
+ * @param[in] config Configuration to serialize.
+ * @param[out] blob Buffer receiving the blob.
+ * @param[in] capacity Size of blob; TAA3040_BLOB_MAX_SIZE is always enough.
+ * @return Number of bytes written, or 0 if the buffer is too small.
+ */
+size_t taa3040_blob_encode(const taa3040_config_t *const config, uint8_t *const blob, const size_t capacity);
+
+/**
+ * @brief Check the header, run structure and CRC of a blob.
+ *
+ * @param[in] blob Blob contents.
+ * @param[in] size Number of bytes available at blob.
+ * @return true if the blob is intact and of a supported version, false otherwise.
+ */
+bool taa3040_blob_verify(const uint8_t *const blob, const size_t size);
+
+/**
+ * @brief Deserialize a blob into a full configuration.
+ *
+ * Registers missing from the blob keep their default values and registers the
+ * configuration does not describe are ignored, so partial blobs decode cleanly.
+ *
+ * @param[in] blob Blob contents.
+ * @param[in] size Number of bytes available at blob.
+ * @param[out] config Configuration to fill.
+ * @return true if successful, false if the blob does not verify.
+ */
+bool taa3040_blob_decode(const uint8_t *const blob, const size_t size, taa3040_config_t *const config);
+
+/**
+ * @brief Program a blob into a device.
+ *
+ * Each run is written in a single transfer and the page is only switched when a run
+ * is on a different page than the one before it. The device is left on page 0.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] blob Blob contents.
+ * @param[in] size Number of bytes available at blob.
+ * @return true if successful, false if the blob does not verify or a write fails.
+ */
+bool taa3040_blob_load(const taa3040_t *const dev, const uint8_t *const blob, const size_t size);
+
+/**
+ * @brief Program a sequence of [page][reg][length][data] register runs.
+ *
+ * This is the payload format of a blob, shared by anything else that stores register
+ * writes as runs. The device must be on page 0 on entry, as every driver call leaves
+ * it, and is left on page 0, also when a run fails.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] runs Run data.
+ * @param[in] length Number of bytes of run data.
+ * @return true if successful, false if a run is truncated or a write fails.
+ */
+bool taa3040_blob_write_runs(const taa3040_t *const dev, const uint8_t *const runs, const size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_BLOB_H */
@@ -0,0 +1,265 @@
+/**
+ * @file taa3040_capture.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Indexed, memory mappable capture files with random access by frame and channel
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_CAPTURE_H
+#define TAA3040_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "taa3040_types.h"
+
+/*
+ * Interleaved WAV has to be scanned to find anything in a long recording. A capture
+ * file is laid out so that any frame of any channel is at a computed offset instead:
+ *
+ *   file header | configuration table | block 0 | block 1 | ...
+ *
+ * Every block has the same size and room for frames_per_block frames. It starts with a
+ * 64 byte block header and then stores one contiguous run of samples per channel. Frame
+ * f of channel c is in block f / frames_per_block, at a position known from the file
+ * header alone. Each block header records the timestamp of its first frame, the
+ * configuration in effect, and one configuration change or lost frames inside the
+ * block. A second change closes the block early, short of frames_per_block, so the
+ * next block starts with it; frames past a short block sit in later blocks, which the
+ * reader finds by their first_frame with a search starting from the computed block.
+ * Blocks are self describing, so a file cut short by a crash loses at most the block
+ * being written.
+ *
+ * Configurations are kept as register images (taa3040_image.h) in a table reserved
+ * behind the file header, so they decode to a taa3040_config_t whatever the build.
+ *
+ * The reader works on a read-only mapping of the file and returns pointers into it, so
+ * nothing is copied. The file is little endian and the structures below are its exact
+ * layout, for little endian hosts. A file that is still being written can be read; the
+ * block count in its header only counts blocks that were complete.
+ */
+
+#ifndef TAA3040_CAPTURE_MAX_CONFIGS
+#define TAA3040_CAPTURE_MAX_CONFIGS     (16)    ///< Configurations one file can hold, may be overridden at build time
+#endif
+
+#define TAA3040_CAPTURE_MAGIC           "TAA3040C"
+#define TAA3040_CAPTURE_VERSION         (1)
+#define TAA3040_CAPTURE_BLOCK_MAGIC     (0x4B4C4254u)   ///< "TBLK"
+
+#define TAA3040_CAPTURE_CONFIG_CHANGE   (0x0001)    ///< next_config takes effect at change_frame of the block
+#define TAA3040_CAPTURE_DISCONTINUITY   (0x0002)    ///< Frames were lost before or within the block
+
+/**
+ * @brief File header, at offset 0.
+ */
+typedef struct {
+    char magic[8];                  ///< TAA3040_CAPTURE_MAGIC, not nul terminated
+    uint16_t version;               ///< TAA3040_CAPTURE_VERSION
+    uint16_t block_header_bytes;    ///< sizeof(taa3040_capture_block_t)
+    uint8_t channels;               ///< Channels per frame
+    uint8_t sample_bytes;           ///< Bytes per sample, 4
+    uint16_t config_bytes;          ///< Bytes per configuration, TAA3040_IMAGE_SIZE
+    uint32_t frames_per_block;      ///< Frames in every block
+    uint32_t sample_rate;           ///< Frames per second
+    uint32_t block_stride;          ///< Bytes from one block to the next
+    uint16_t config_count;          ///< Configurations in the table
+    uint16_t config_capacity;       ///< Configurations the table has room for
+    uint64_t config_offset;         ///< File offset of the configuration table
+    uint64_t data_offset;           ///< File offset of block 0
+    uint64_t block_count;           ///< Complete blocks in the file
+    uint8_t reserved[8];
+} taa3040_capture_header_t;
+
+/**
+ * @brief Block header, at the start of every block, followed by one run of samples per channel.
+ */
+typedef struct {
+    uint32_t magic;                 ///< TAA3040_CAPTURE_BLOCK_MAGIC
+    uint32_t frames;                ///< Valid frames, frames_per_block except in a block closed early or a final block
+    uint64_t first_frame;           ///< Frame index of the first frame, block index * frames_per_block until a short block
+    uint64_t timestamp_us;          ///< Capture time of the first frame
+    uint64_t dropped;               ///< Frames lost before or within this block
+    uint16_t config;                ///< Configuration in effect before any change in the block
+    uint16_t next_config;           ///< Configuration from change_frame on, config when there is no change
+    uint16_t flags;                 ///< TAA3040_CAPTURE_* flags
+    uint16_t reserved0;
+    uint32_t change_frame;          ///< Frame within the block where next_config takes effect
+    uint8_t reserved[20];
+} taa3040_capture_block_t;
+
+/* === Writing === */
+
+/**
+ * @brief Writes bytes at an offset of the capture file.
+ *
+ * @param[in] context Context given to the writer.
+ * @param[in] offset File offset.
+ * @param[in] data Bytes to write, only valid during the call.
+ * @param[in] length Bytes in data.
+ * @return true if successful, false otherwise.
+ */
+typedef bool (*taa3040_capture_write_fn)(void *const context, const uint64_t offset, const void *const data, const size_t length);
+
+/**
+ * @brief Capture file being written.
+ */
+typedef struct {
+    taa3040_capture_header_t header;        ///< Header as last written
+    uint8_t* block;                         ///< Caller supplied buffer of one block_stride
+    uint32_t fill;                          ///< Frames in the block being filled
+    uint64_t frames;                        ///< Frames in the blocks written so far
+    uint64_t dropped;                       ///< Frames lost before the next block starts
+    uint16_t config;                        ///< Configuration in effect
+    bool config_changed;                    ///< config took effect before the next frame
+    taa3040_capture_write_fn write;
+    void* context;
+} taa3040_capture_writer_t;
+
+/**
+ * @brief Bytes of one block, for sizing the writer's block buffer.
+ *
+ * @param[in] channels Channels per frame.
+ * @param[in] frames_per_block Frames per block.
+ * @return Block size in bytes, a multiple of 64.
+ */
+size_t taa3040_capture_block_stride(const uint8_t channels, const uint32_t frames_per_block);
+
+/**
+ * @brief Start a capture file and record the configuration it starts in.
+ *
+ * @param[out] writer Writer to initialize.
+ * @param[in] channels Channels per frame (1 - 8).
+ * @param[in] sample_rate Frames per second.
+ * @param[in] frames_per_block Frames per block, a few milliseconds to a second of audio.
+ * @param[in] block Buffer of taa3040_capture_block_stride bytes, 8 byte aligned.
+ * @param[in] config Configuration of the device.
+ * @param[in] write File output.
+ * @param[in] context Passed to write.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_capture_writer_init(taa3040_capture_writer_t *const writer, const uint8_t channels, const uint32_t sample_rate,
+                                 const uint32_t frames_per_block, uint8_t *const block, const taa3040_config_t *const config,
+                                 const taa3040_capture_write_fn write, void *const context);
+
+/**
+ * @brief Append interleaved frames.
+ *
+ * @param[in,out] writer Writer.
+ * @param[in] frames Interleaved frames of channels 32 bit words.
+ * @param[in] count Frames to append.
+ * @param[in] timestamp_us Capture time of the first frame.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_capture_writer_append(taa3040_capture_writer_t *const writer, const int32_t *const frames, const size_t count,
+                                   const uint64_t timestamp_us);
+
+/**
+ * @brief Mark frames as lost before the next appended frame.
+ *
+ * @param[in,out] writer Writer.
+ * @param[in] frames Frames lost.
+ */
+void taa3040_capture_writer_drop(taa3040_capture_writer_t *const writer, const uint64_t frames);
+
+/**
+ * @brief Record a configuration change taking effect at the next appended frame.
+ *
+ * A block holds one change. Once frames have been appended after a change, the next one
+ * writes the block being filled early, as a short block, and the change starts the next.
+ *
+ * @param[in,out] writer Writer.
+ * @param[in] config New configuration of the device.
+ * @return true if successful, false if the table is full or a write failed.
+ */
+bool taa3040_capture_writer_set_config(taa3040_capture_writer_t *const writer, const taa3040_config_t *const config);
+
+/**
+ * @brief Write the partly filled block as a final, short block.
+ *
+ * @param[in,out] writer Writer.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_capture_writer_finish(taa3040_capture_writer_t *const writer);
+
+/* === Reading === */
+
+/**
+ * @brief Capture file mapped into memory.
+ */
+typedef struct {
+    const uint8_t* base;                        ///< Start of the mapping
+    size_t length;                              ///< Bytes mapped
+    const taa3040_capture_header_t* header;     ///< File header, inside the mapping
+    uint64_t block_count;                       ///< Complete blocks available
+    uint64_t frame_count;                       ///< Frames available
+} taa3040_capture_reader_t;
+
+/**
+ * @brief Validate a mapped capture file.
+ *
+ * @param[out] reader Reader to initialize.
+ * @param[in] base Mapping of the file, must outlive the reader.
+ * @param[in] length Bytes mapped.
+ * @return true if the file is a capture file, false otherwise.
+ */
+bool taa3040_capture_reader_open(taa3040_capture_reader_t *const reader, const void *const base, const size_t length);
+
+/**
+ * @brief Header of a block.
+ *
+ * @param[in] reader Reader.
+ * @param[in] block Block index.
+ * @return Block header inside the mapping, NULL if out of range or damaged.
+ */
+const taa3040_capture_block_t* taa3040_capture_reader_block(const taa3040_capture_reader_t *const reader, const uint64_t block);
+
+/**
+ * @brief Samples of one channel from a frame on, without copying.
+ *
+ * @param[in] reader Reader.
+ * @param[in] frame Frame index, time * sample_rate.
+ * @param[in] channel Channel (0 - channels - 1).
+ * @param[out] available Contiguous samples from the returned pointer, up to the end of the block (may be NULL).
+ * @return Pointer into the mapping, NULL if out of range.
+ */
+const int32_t* taa3040_capture_reader_samples(const taa3040_capture_reader_t *const reader, const uint64_t frame,
+                                              const uint8_t channel, size_t *const available);
+
+/**
+ * @brief Configuration in effect at a frame.
+ *
+ * @param[in] reader Reader.
+ * @param[in] frame Frame index.
+ * @param[out] config Decoded configuration; fields without a backing register are left untouched.
+ * @return true if successful, false if out of range.
+ */
+bool taa3040_capture_reader_config(const taa3040_capture_reader_t *const reader, const uint64_t frame, taa3040_config_t *const config);
+
+/**
+ * @brief Find the block captured at a time, for recordings with gaps.
+ *
+ * The block is computed from the time when nothing was dropped and no block closed early,
+ * and only checked against its neighbour's timestamp. Otherwise a binary search over the
+ * block timestamps finds it.
+ *
+ * @param[in] reader Reader.
+ * @param[in] timestamp_us Capture time.
+ * @return Last block starting at or before the time, 0 if it precedes the recording.
+ */
+uint64_t taa3040_capture_reader_find(const taa3040_capture_reader_t *const reader, const uint64_t timestamp_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_CAPTURE_H */
@@ -0,0 +1,232 @@
+/**
+ * @file taa3040_clock.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Clock tree solver and validation for master mode ASI configuration
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_CLOCK_H
+#define TAA3040_CLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "taa3040_types.h"
+
+/* === Clock Limits === */
+#define TAA3040_CLOCK_MAX_BCLK_HZ               (24576000u) ///< Highest BCLK the ASI can generate
+#define TAA3040_CLOCK_PLL_BYPASS_MIN_RATIO      (256u)      ///< Smallest MCLK/FSYNC ratio that can clock the modulators without the PLL
+
+#define TAA3040_CLOCK_NUM_BCLK_RATIOS           (11)        ///< Entries in taa3040_bclk_ratio_t
+#define TAA3040_CLOCK_NUM_MCLK_RATIOS           (8)         ///< Entries in taa3040_mclk_ratio_t
+#define TAA3040_CLOCK_NUM_MCLK_FREQS            (8)         ///< Entries in taa3040_mclk_freq_t
+#define TAA3040_CLOCK_NUM_SAMPLE_RATES          (9)         ///< Entries in taa3040_sampling_rate_t
+
+/** @brief Upper bound on solutions for one request: every BCLK ratio x (PLL from frequency, PLL from ratio, no PLL) x gated/ungated */
+#define TAA3040_CLOCK_MAX_SOLUTIONS             (TAA3040_CLOCK_NUM_BCLK_RATIOS * 3 * 2)
+
+/* === Compile-Time Helpers === */
+/*
+ * All of the following are integer constant expressions when their arguments are,
+ * so a fixed board clocking can be checked with _Static_assert / static_assert.
+ */
+
+/** @brief Number of bits in a slot for a taa3040_asi_word_length_t */
+#define TAA3040_WORD_LENGTH_BITS(wl)            ((wl) == TAA3040_ASI_WORD_LENGTH_32BITS? 32u : (16u + 4u * (unsigned)(wl)))
+
+/** @brief Number of BCLK cycles per frame for a taa3040_bclk_ratio_t */
+#define TAA3040_BCLK_RATIO_VALUE(r)             (((unsigned)(r) & 1u)? (24u << ((unsigned)(r) >> 1)) : (16u << ((unsigned)(r) >> 1)))
+
+/** @brief MCLK/FSYNC ratio for a taa3040_mclk_ratio_t */
+#define TAA3040_MCLK_RATIO_VALUE(r)             ((r) == TAA3040_MCLK_RATIO_64?   64u   : \
+                                                 (r) == TAA3040_MCLK_RATIO_256?  256u  : \
+                                                 (r) == TAA3040_MCLK_RATIO_384?  384u  : \
+                                                 (r) == TAA3040_MCLK_RATIO_512?  512u  : \
+                                                 (r) == TAA3040_MCLK_RATIO_768?  768u  : \
+                                                 (r) == TAA3040_MCLK_RATIO_1024? 1024u : \
+                                                 (r) == TAA3040_MCLK_RATIO_1536? 1536u : 2304u)
+
+/** @brief MCLK frequency in Hz for a taa3040_mclk_freq_t */
+#define TAA3040_MCLK_FREQ_HZ(f)                 ((f) == TAA3040_MCLK_FREQ_12000KHZ? 12000000u : \
+                                                 (f) == TAA3040_MCLK_FREQ_12288KHZ? 12288000u : \
+                                                 (f) == TAA3040_MCLK_FREQ_13000KHZ? 13000000u : \
+                                                 (f) == TAA3040_MCLK_FREQ_16000KHZ? 16000000u : \
+                                                 (f) == TAA3040_MCLK_FREQ_19200KHZ? 19200000u : \
+                                                 (f) == TAA3040_MCLK_FREQ_19680KHZ? 19680000u : \
+                                                 (f) == TAA3040_MCLK_FREQ_24000KHZ? 24000000u : 24576000u)
+
+/** @brief Sample rate in Hz for a taa3040_sampling_rate_t in the 48 kHz (true) or 44.1 kHz (false) family */
+#define TAA3040_SAMPLE_RATE_HZ(rate, is_48khz)  ((unsigned)(rate) < TAA3040_SAMPLING_RATE_48KHZ \
+                                                    ? ((is_48khz)? 8000u : 7350u) * ((unsigned)(rate) + 1u) \
+                                                    : ((is_48khz)? 48000u : 44100u) << ((unsigned)(rate) - TAA3040_SAMPLING_RATE_48KHZ))
+
+/** @brief BCLK frequency in Hz for a sample rate and BCLK ratio */
+#define TAA3040_CLOCK_BCLK_HZ(rate, is_48khz, bclk_ratio) \
+                                                (TAA3040_SAMPLE_RATE_HZ(rate, is_48khz) * TAA3040_BCLK_RATIO_VALUE(bclk_ratio))
+
+/** @brief If a frame of the given BCLK ratio holds every channel at the given word length */
+#define TAA3040_CLOCK_FRAME_FITS(bclk_ratio, channels, wl) \
+                                                ((unsigned)(channels) * TAA3040_WORD_LENGTH_BITS(wl) <= TAA3040_BCLK_RATIO_VALUE(bclk_ratio))
+
+/** @brief If a master mode clock setup can be generated: the frame fits and BCLK is within range */
+#define TAA3040_CLOCK_CONFIG_VALID(rate, is_48khz, bclk_ratio, channels, wl) \
+                                                (TAA3040_CLOCK_FRAME_FITS(bclk_ratio, channels, wl) \
+                                                && TAA3040_CLOCK_BCLK_HZ(rate, is_48khz, bclk_ratio) <= TAA3040_CLOCK_MAX_BCLK_HZ)
+
+/* === Solver Types === */
+
+/**
+ * @brief One achievable master mode clock setup.
+ *
+ * Solutions are ordered by BCLK rate first, then by power_cost.
+ */
+typedef struct
+{
+    taa3040_sampling_rate_t sample_rate;    ///< FSYNC rate selection
+    bool sample_rate_48khz;                 ///< If the rate is in the 48 kHz family (false: 44.1 kHz)
+    taa3040_bclk_ratio_t bclk_fsync_ratio;  ///< BCLK cycles per frame
+    bool mclk_ratio_mode;                   ///< If MCLK is described by mclk_fsync_ratio (true) or mclk_freq (false)
+    taa3040_mclk_freq_t mclk_freq;          ///< MCLK frequency selection (when !mclk_ratio_mode)
+    taa3040_mclk_ratio_t mclk_fsync_ratio;  ///< MCLK/FSYNC ratio selection (when mclk_ratio_mode)
+    bool pll_disabled;                      ///< If the audio clocks are divided straight from MCLK
+    bool gate_clocks;                       ///< If BCLK and FSYNC stop when all channels are off
+
+    uint32_t sample_rate_hz;                ///< Resulting FSYNC frequency
+    uint32_t bclk_hz;                       ///< Resulting BCLK frequency
+    uint16_t frame_bits;                    ///< BCLK cycles per frame
+    uint16_t used_bits;                     ///< BCLK cycles per frame occupied by channel data
+    uint8_t power_cost;                     ///< Relative power: 0 is cheapest (PLL off, clocks gated)
+} taa3040_clock_solution_t;
+
+/* === Solver === */
+
+/**
+ * @brief Find every master mode clock setup that produces a sample rate from an MCLK.
+ *
+ * Each channel occupies one slot of the selected word length in the frame, so the
+ * BCLK ratio must be at least channels x word length bits. Results are sorted by
+ * lowest BCLK rate and then lowest power.
+ *
+ * @param[in] mclk_hz Frequency of the clock on the MCLK pin.
+ * @param[in] sample_rate_hz Target FSYNC frequency.
+ * @param[in] channels Number of enabled ASI output channels (1–8).
+ * @param[in] word_length Slot word length.
+ * @param[out] solutions Array receiving up to max_solutions results, best first (may be NULL if max_solutions is 0).
+ * @param[in] max_solutions Capacity of solutions; TAA3040_CLOCK_MAX_SOLUTIONS holds every result.
+ * @return Number of valid setups found, which may exceed max_solutions.
+ */
+size_t taa3040_clock_solve(const uint32_t mclk_hz, const uint32_t sample_rate_hz, const uint8_t channels,
+    const taa3040_asi_word_length_t word_length, taa3040_clock_solution_t* const solutions, const size_t max_solutions);
+
+/**
+ * @brief Copy a solved clock setup into the master mode section of an ASI configuration.
+ *
+ * @param[in] solution The setup to apply.
+ * @param[out] asi_config ASI configuration to update; other fields are untouched.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_clock_apply(const taa3040_clock_solution_t* const solution, taa3040_asi_config_t* const asi_config);
+
+/**
+ * @brief Check that the master mode section of an ASI configuration is achievable.
+ *
+ * Verifies the frame holds the enabled channels at the configured word length, that
+ * BCLK is within range and that the MCLK frequency or ratio matches the given MCLK.
+ * Slave mode configurations are clocked by the host and always pass.
+ *
+ * @param[in] asi_config ASI configuration to check.
+ * @param[in] mclk_hz Frequency of the clock on the MCLK pin.
+ * @return true if the configuration is achievable, false otherwise.
+ */
+bool taa3040_clock_validate(const taa3040_asi_config_t* const asi_config, const uint32_t mclk_hz);
+
+/* === PDM Clock Planner === */
+
+/*
+ * The PDM clock is derived from the audio clock, so in the 44.1 kHz family each setting
+ * runs at 44.1/48 of its nominal rate. The decimation filter needs a minimum ratio of PDM
+ * clock to output sample rate to keep its alias rejection. Every filter is held to 64,
+ * so the planners never pick a ratio the filter figures were not given for (a 6.144 MHz
+ * clock still serves 96 kHz). These limits may be overridden at build time.
+ */
+
+#ifndef TAA3040_PDM_MIN_OSR_LIN_PHASE
+#define TAA3040_PDM_MIN_OSR_LIN_PHASE           (64u)   ///< Minimum PDM clock / sample rate with the linear phase filter
+#endif
+#ifndef TAA3040_PDM_MIN_OSR_LOW_LATENCY
+#define TAA3040_PDM_MIN_OSR_LOW_LATENCY         (64u)   ///< Minimum PDM clock / sample rate with the low latency filter
+#endif
+#ifndef TAA3040_PDM_MIN_OSR_ULTRA_LOW_LATENCY
+#define TAA3040_PDM_MIN_OSR_ULTRA_LOW_LATENCY   (64u)   ///< Minimum PDM clock / sample rate with the ultra low latency filter
+#endif
+
+/** @brief PDM clock in Hz for a taa3040_pdm_clock_t in the 48 kHz (true) or 44.1 kHz (false) family */
+#define TAA3040_PDM_CLOCK_HZ(clk, is_48khz)     (((clk) == TAA3040_PDM_CLOCK_6144KHZ? 6144000u : (3072000u >> (unsigned)(clk))) \
+                                                    / ((is_48khz)? 1u : 160u) * ((is_48khz)? 1u : 147u))
+
+/**
+ * @brief A PDM clock setting for a sample rate.
+ */
+typedef struct
+{
+    taa3040_pdm_clock_t pdm_clock;          ///< PDM clock selection
+    uint32_t pdm_clock_hz;                  ///< Resulting PDM clock frequency
+    uint16_t oversampling;                  ///< PDM clock cycles per output sample
+} taa3040_pdm_solution_t;
+
+/**
+ * @brief Pick the lowest PDM clock that supports an output sample rate.
+ *
+ * The clock must give the decimation filter its minimum oversampling and lie within the
+ * range the microphones accept. A lower clock lowers both microphone and modulator power.
+ *
+ * @param[in] sample_rate_hz Output sample rate, from the 48 kHz or 44.1 kHz family.
+ * @param[in] filter Decimation filter in use.
+ * @param[in] mic_min_hz Lowest clock the microphones accept (0 for no limit).
+ * @param[in] mic_max_hz Highest clock the microphones accept (0 for no limit).
+ * @param[out] solution Chosen setting.
+ * @return true if a setting exists, false otherwise.
+ */
+bool taa3040_pdm_solve(const uint32_t sample_rate_hz, const taa3040_decimation_filter_t filter,
+    const uint32_t mic_min_hz, const uint32_t mic_max_hz, taa3040_pdm_solution_t* const solution);
+
+/**
+ * @brief Copy a PDM clock setting into a system configuration.
+ *
+ * @param[in] solution The setting to apply.
+ * @param[out] system_config System configuration to update; other fields are untouched.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_pdm_apply(const taa3040_pdm_solution_t* const solution, taa3040_system_config_t* const system_config);
+
+/**
+ * @brief Route a pair of channels to a PDM microphone.
+ *
+ * Sets both channels of the pair to PDM input, the GPI to carry the pair's data and,
+ * unless clock_gpo is out of range, a GPO to drive the PDM clock push-pull. The two
+ * channels of a pair latch on opposite clock edges; latching_edge picks which is which.
+ *
+ * @param[in,out] config Configuration to update.
+ * @param[in] pair Channel pair (0: channels 1/2 ... 3: channels 7/8).
+ * @param[in] data_gpi GPI carrying the PDM data (0-3).
+ * @param[in] clock_gpo GPO driving the PDM clock (0-3), or TAA3040_NUM_GPO to leave the GPOs alone.
+ * @param[in] latching_edge Latching edge selection of the pair, stored in system_config.advanced.pdm_latching_edge.
+ * @return true if successful, false if an argument is out of range.
+ */
+bool taa3040_pdm_route(taa3040_config_t* const config, const uint8_t pair, const uint8_t data_gpi, const uint8_t clock_gpo,
+    const bool latching_edge);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_CLOCK_H */
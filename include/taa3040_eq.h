@@ -0,0 +1,141 @@
+/**
+ * @file taa3040_eq.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Fitting of target EQ curves into the biquads available per channel
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_EQ_H
+#define TAA3040_EQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * The twelve biquads are shared out by dsp_config.biquads_per_channel, as in the device's
+ * allocation table. One per channel serves all eight channels with biquads 0-7, leaving
+ * 8-11 unused. Two per channel serve channels 0-5, channel c using biquads c and c + 6.
+ * Three per channel serve channels 0-3, channel c using biquads c, c + 4 and c + 8.
+ *
+ * A target is a magnitude response in dB at a few frequencies. It is fitted with an
+ * overall level and one peaking section per biquad, each section having a frequency, a
+ * gain and a Q. The fit is a damped Gauss-Newton (Levenberg-Marquardt) least squares fit
+ * of the response in dB, started from sections placed greedily on the largest remaining
+ * errors. With at most 3 sections there are at most 10 parameters. The derivatives are
+ * analytic and the cascade's gain takes one logarithm per point, so an iteration is one
+ * response evaluation per point and a 10 x 10 solve. The bench's taa3040_eq_fit case,
+ * 3 sections on 64 points, takes about 0.35 ms on a desktop built with -O2 and about
+ * 0.9 ms unoptimized. Time scales with points x sections x iterations, so on a target it
+ * is worth measuring before fitting in a time critical path.
+ *
+ * The sections are then quantized to the device format. A biquad numerator cannot exceed
+ * unity at b0 and b2, so boosting sections are scaled down to fit. The gain taken out,
+ * plus the overall level, is returned as makeup_db, to be applied with the channel's
+ * digital volume (taa3040_set_levels). The reported error is that of the quantized
+ * sections plus the makeup.
+ */
+
+#ifndef TAA3040_EQ_MAX_POINTS
+#define TAA3040_EQ_MAX_POINTS       (64)    ///< Points in one target, may be overridden at build time
+#endif
+
+#ifndef TAA3040_EQ_MAX_ITERATIONS
+#define TAA3040_EQ_MAX_ITERATIONS   (50)    ///< Fit iterations before giving up on convergence, may be overridden at build time
+#endif
+
+#define TAA3040_EQ_MAX_SECTIONS     (3)     ///< Most biquads one channel can have
+
+/**
+ * @brief One point of a target response.
+ */
+typedef struct {
+    float frequency_hz;     ///< Frequency, below half the sample rate
+    float gain_db;          ///< Wanted gain
+    float weight;           ///< Relative importance, 0 ignores the point
+} taa3040_eq_point_t;
+
+/**
+ * @brief Target response of one channel.
+ */
+typedef struct {
+    const taa3040_eq_point_t* points;   ///< Points, NULL to leave the channel flat
+    uint8_t point_count;                ///< Points (up to TAA3040_EQ_MAX_POINTS)
+} taa3040_eq_target_t;
+
+/**
+ * @brief Outcome of one fit.
+ */
+typedef struct {
+    float makeup_db;        ///< Gain to apply with the digital volume
+    float rms_error_db;     ///< Weighted RMS error of the quantized fit plus makeup
+    float max_error_db;     ///< Largest error at any weighted point
+    uint8_t iterations;     ///< Fit iterations used
+} taa3040_eq_fit_t;
+
+/**
+ * @brief Biquad serving a section of a channel.
+ *
+ * @param[in] channel Channel (0 - 7).
+ * @param[in] section Section of the channel (0 - biquads_per_channel - 1).
+ * @param[in] biquads_per_channel dsp_config.biquads_per_channel (1 - 3).
+ * @param[out] index Biquad index (0 - 11).
+ * @return true if the channel has that section, false otherwise.
+ */
+bool taa3040_eq_biquad_index(const uint8_t channel, const uint8_t section, const uint8_t biquads_per_channel, uint8_t *const index);
+
+/**
+ * @brief Fit a target with cascaded sections.
+ *
+ * @param[in] points Target response.
+ * @param[in] count Points in the target (1 - TAA3040_EQ_MAX_POINTS).
+ * @param[in] sample_rate Sample rate in Hz.
+ * @param[in] sections Sections to fit (1 - 3).
+ * @param[out] filters Quantized sections, in cascade order.
+ * @param[out] fit Outcome (may be NULL).
+ * @return true if successful, false if the arguments are invalid.
+ */
+bool taa3040_eq_fit(const taa3040_eq_point_t *const points, const uint8_t count, const uint32_t sample_rate, const uint8_t sections,
+                    taa3040_biquad_filter_t *const filters, taa3040_eq_fit_t *const fit);
+
+/**
+ * @brief Fit the target of every channel into the biquads allocated to it.
+ *
+ * Uses dsp_config->biquads_per_channel and fills dsp_config->biquad_filters. Biquads of
+ * channels without a target, and biquads serving no channel, are set to pass through.
+ *
+ * @param[in,out] dsp_config DSP configuration to fill in.
+ * @param[in] targets Target of each channel.
+ * @param[in] sample_rate Sample rate in Hz.
+ * @param[out] fits Outcome per channel (may be NULL).
+ * @return true if successful, false if a target is invalid or on a channel without biquads.
+ */
+bool taa3040_eq_plan(taa3040_dsp_config_t *const dsp_config, const taa3040_eq_target_t targets[TAA3040_NUM_CHANNELS],
+                     const uint32_t sample_rate, taa3040_eq_fit_t fits[TAA3040_NUM_CHANNELS]);
+
+/**
+ * @brief Magnitude response of quantized sections.
+ *
+ * @param[in] filters Sections.
+ * @param[in] count Sections in the cascade.
+ * @param[in] sample_rate Sample rate in Hz.
+ * @param[in] frequency_hz Frequency to evaluate.
+ * @return Gain in dB.
+ */
+float taa3040_eq_response_db(const taa3040_biquad_filter_t *const filters, const uint8_t count, const uint32_t sample_rate,
+                             const float frequency_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_EQ_H */
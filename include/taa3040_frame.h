@@ -0,0 +1,154 @@
+/**
+ * @file taa3040_frame.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Layout of the ASI frame for the host, compacted when channels are summed
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_FRAME_H
+#define TAA3040_FRAME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * With dsp_config.channel_summing every channel of a group outputs the same average:
+ * channels 1 - 2, 3 - 4, 5 - 6 and 7 - 8 in pairs with 2 channel summing, and 1 - 4 and
+ * 5 - 8 with 4 channel summing. Sending every channel of a group on the bus only repeats
+ * the data, so compaction keeps the first enabled channel of each group, disables the
+ * rest, and in TDM moves the kept slots together from the lowest slot in use, keeping
+ * their order. The primary and the GPIO output lines are compacted separately. In I2S and
+ * LJ the slots stay where they are, split across the two halves of the frame.
+ *
+ * The frame descriptor tells the host what each word of a frame holds, so capture
+ * buffers, DMA and the recorder (config.channels = frame.words) size to the compacted
+ * frame. A smaller BCLK ratio also fits it; solve for one with taa3040_clock_solve and
+ * frame.words as the channel count.
+ *
+ * Keep the full layout as the source and compact a copy of it, so that turning summing
+ * off restores the channels compaction disabled.
+ */
+
+#ifndef TAA3040_FRAME_MAX_CONSUMERS
+#define TAA3040_FRAME_MAX_CONSUMERS     (4)     ///< Consumers a publisher can notify, may be overridden at build time
+#endif
+
+/**
+ * @brief One word of the frame.
+ */
+typedef struct {
+    uint8_t channel;        ///< ASI output channel sending it (0 - 7)
+    uint8_t slot;           ///< Slot it is sent in
+    uint8_t sources;        ///< ADC channels averaged into it, TAA3040_CHANNEL_BIT of each
+    bool gpio_output;       ///< Sent on the GPIO output line instead of the primary one
+} taa3040_frame_word_t;
+
+/**
+ * @brief What the host receives each frame.
+ */
+typedef struct {
+    uint8_t words;                                          ///< Words per frame over both lines
+    uint8_t output_mask;                                    ///< ASI output channels enabled, as ASI_OUT_CHANNEL_EN
+    uint16_t used_bits;                                     ///< BCLK cycles per frame holding data on the busier line
+    taa3040_asi_word_length_t word_length;                  ///< Bits per word
+    taa3040_channel_summing_mode_t summing;                 ///< Channel summing in effect
+    uint32_t sample_rate_hz;                                ///< Frames per second
+    taa3040_frame_word_t word[TAA3040_NUM_CHANNELS];        ///< Words, primary line first, in slot order
+} taa3040_frame_t;
+
+/**
+ * @brief Called when the published frame changes.
+ *
+ * @param[in] context Context given with the consumer.
+ * @param[in] previous Frame published before, 0 words at first.
+ * @param[in] current Frame now published.
+ */
+typedef void (*taa3040_frame_change_fn)(void *const context, const taa3040_frame_t *const previous, const taa3040_frame_t *const current);
+
+/**
+ * @brief Hands the frame in effect to the host's consumers.
+ */
+typedef struct {
+    taa3040_frame_t current;                                        ///< Frame last published
+    taa3040_frame_change_fn consumers[TAA3040_FRAME_MAX_CONSUMERS]; ///< Change callbacks
+    void* contexts[TAA3040_FRAME_MAX_CONSUMERS];                    ///< Passed to each callback
+    uint8_t consumer_count;                                         ///< Registered consumers
+    uint32_t changes;                                               ///< Changes published
+} taa3040_frame_publisher_t;
+
+/**
+ * @brief Describe the frame a configuration sends.
+ *
+ * @param[in] config Configuration.
+ * @param[out] frame Frame descriptor.
+ * @return true if successful, false if the arguments are invalid.
+ */
+bool taa3040_frame_describe(const taa3040_config_t *const config, taa3040_frame_t *const frame);
+
+/**
+ * @brief Compact the ASI channels for a channel summing mode.
+ *
+ * Leaves the layout as it is without summing.
+ *
+ * @param[in,out] asi_config ASI configuration to compact.
+ * @param[in] summing Channel summing mode.
+ * @return true if successful, false if the arguments are invalid.
+ */
+bool taa3040_frame_compact(taa3040_asi_config_t *const asi_config, const taa3040_channel_summing_mode_t summing);
+
+/**
+ * @brief Initialize a publisher with no consumers and an empty frame.
+ *
+ * @param[out] publisher Publisher to initialize.
+ */
+void taa3040_frame_publisher_init(taa3040_frame_publisher_t *const publisher);
+
+/**
+ * @brief Register a consumer.
+ *
+ * @param[in,out] publisher Publisher.
+ * @param[in] on_change Change callback.
+ * @param[in] context Passed to on_change.
+ * @return true if successful, false if the publisher is full.
+ */
+bool taa3040_frame_subscribe(taa3040_frame_publisher_t *const publisher, const taa3040_frame_change_fn on_change, void *const context);
+
+/**
+ * @brief Publish a frame, notifying every consumer if it differs from the current one.
+ *
+ * @param[in,out] publisher Publisher.
+ * @param[in] frame Frame in effect.
+ * @return true if the frame changed.
+ */
+bool taa3040_frame_publish(taa3040_frame_publisher_t *const publisher, const taa3040_frame_t *const frame);
+
+/**
+ * @brief Compact a configuration's ASI channels for its channel summing, write them and publish the frame.
+ *
+ * Call after setting the DSP configuration. The slots and output enables are written
+ * before the frame is published, so consumers switch once the device sends the new frame.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] config Configuration with the full, uncompacted ASI layout.
+ * @param[in,out] publisher Publisher (may be NULL).
+ * @param[out] frame Frame in effect (may be NULL).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_frame_apply(const taa3040_t *const dev, const taa3040_config_t *const config, taa3040_frame_publisher_t *const publisher,
+                         taa3040_frame_t *const frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_FRAME_H */
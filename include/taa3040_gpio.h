@@ -0,0 +1,168 @@
+/**
+ * @file taa3040_gpio.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Cached output writes and debounced input monitoring of the GPIO pins
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_GPIO_H
+#define TAA3040_GPIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * Pins configured as general purpose outputs and inputs (see taa3040_set_gpio_config)
+ * are cheap enough to drive LEDs and read buttons, as long as each access stays a single
+ * transfer.
+ *
+ * Outputs keep a copy of GPO_VALUE, so any combination of the four outputs changes with
+ * one write and no read back, and a write that changes nothing skips the bus entirely.
+ * The copy is only valid while nothing else writes GPO_VALUE.
+ *
+ * Inputs are sampled with one burst over GPIO1_MONITOR through GPI_MONITOR, the four
+ * registers in between being read along. Samples feed a monitor that debounces each
+ * input in software and reports edges through a callback.
+ */
+
+/* === Input Bits === */
+/* Levels of the inputs as returned by taa3040_gpi_sample, GPI1 in bit 7 down to GPI4 in bit 4 as in GPI_MONITOR */
+#define TAA3040_GPI_NUM_INPUTS      (TAA3040_NUM_GPI + 1)   ///< The GPIs and GPIO1
+#define TAA3040_GPI_INPUT_GPIO1     (TAA3040_NUM_GPI)       ///< Input index of GPIO1
+#define TAA3040_GPI_INPUT_BIT(i)    ((uint8_t)(1 << (7 - (i)))) ///< Level bit of input index i (0 - 4)
+#define TAA3040_GPI_INPUTS_MASK     (0xF8)                  ///< Every input level bit
+
+/* === Outputs === */
+
+/**
+ * @brief Cached GPO_VALUE of one device.
+ */
+typedef struct {
+    uint8_t value;      ///< GPO_VALUE as last written, GPO1 in bit 7 down to GPO4 in bit 4
+} taa3040_gpo_t;
+
+/**
+ * @brief Write the initial output levels and start caching them.
+ *
+ * @param[out] gpo Output cache.
+ * @param[in] dev Device handle.
+ * @param[in] levels Output levels, GPO1 in bit 7 down to GPO4 in bit 4.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_gpo_init(taa3040_gpo_t *const gpo, const taa3040_t *const dev, const uint8_t levels);
+
+/**
+ * @brief Change any of the outputs in a single write, skipped when nothing changes.
+ *
+ * @param[in,out] gpo Output cache.
+ * @param[in] dev Device handle.
+ * @param[in] mask Outputs to change, GPO1 in bit 7 down to GPO4 in bit 4.
+ * @param[in] levels New levels of the outputs in mask.
+ * @return true if successful, false otherwise (the cache is left unchanged).
+ */
+bool taa3040_gpo_write(taa3040_gpo_t *const gpo, const taa3040_t *const dev, const uint8_t mask, const uint8_t levels);
+
+/**
+ * @brief Set one output.
+ *
+ * @param[in,out] gpo Output cache.
+ * @param[in] dev Device handle.
+ * @param[in] index Output index (0 - 3).
+ * @param[in] level New level.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_gpo_set(taa3040_gpo_t *const gpo, const taa3040_t *const dev, const uint8_t index, const bool level);
+
+/**
+ * @brief Invert one output.
+ *
+ * @param[in,out] gpo Output cache.
+ * @param[in] dev Device handle.
+ * @param[in] index Output index (0 - 3).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_gpo_toggle(taa3040_gpo_t *const gpo, const taa3040_t *const dev, const uint8_t index);
+
+/* === Inputs === */
+
+/**
+ * @brief Read the level of every input in one transfer.
+ *
+ * @param[in] dev Device handle.
+ * @param[out] levels Input levels, TAA3040_GPI_INPUT_BIT of each input index.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_gpi_sample(const taa3040_t *const dev, uint8_t *const levels);
+
+/**
+ * @brief Called for each debounced edge.
+ *
+ * @param[in] context Context given to the monitor.
+ * @param[in] input Input index (0 - 4, TAA3040_GPI_INPUT_GPIO1 for GPIO1).
+ * @param[in] level New level of the input.
+ */
+typedef void (*taa3040_gpi_edge_fn)(void *const context, const uint8_t input, const bool level);
+
+/**
+ * @brief Debounced edge detection over successive samples.
+ */
+typedef struct {
+    uint8_t levels;                             ///< Debounced levels
+    uint8_t rising_mask;                        ///< Inputs reporting rising edges
+    uint8_t falling_mask;                       ///< Inputs reporting falling edges
+    uint8_t debounce;                           ///< Samples a new level must hold before it is accepted
+    uint8_t counts[TAA3040_GPI_NUM_INPUTS];     ///< Samples each input has differed from its debounced level
+    bool primed;                                ///< A first sample set the debounced levels
+    taa3040_gpi_edge_fn on_edge;                ///< Edge callback (may be NULL)
+    void* context;                              ///< Passed to on_edge
+} taa3040_gpi_monitor_t;
+
+/**
+ * @brief Initialize an input monitor.
+ *
+ * The first sample sets the debounced levels without reporting edges.
+ *
+ * @param[out] mon Monitor to initialize.
+ * @param[in] debounce Consecutive samples a level must hold, 0 or 1 accepts every change at once.
+ * @param[in] rising_mask Inputs whose rising edges are reported.
+ * @param[in] falling_mask Inputs whose falling edges are reported.
+ * @param[in] on_edge Edge callback (may be NULL).
+ * @param[in] context Passed to on_edge.
+ */
+void taa3040_gpi_monitor_init(taa3040_gpi_monitor_t *const mon, const uint8_t debounce, const uint8_t rising_mask,
+                              const uint8_t falling_mask, const taa3040_gpi_edge_fn on_edge, void *const context);
+
+/**
+ * @brief Feed one sample taken elsewhere to a monitor.
+ *
+ * @param[in,out] mon Input monitor.
+ * @param[in] levels Sampled levels, as returned by taa3040_gpi_sample.
+ * @return Inputs whose debounced level changed.
+ */
+uint8_t taa3040_gpi_monitor_update(taa3040_gpi_monitor_t *const mon, const uint8_t levels);
+
+/**
+ * @brief Sample the inputs and feed the monitor.
+ *
+ * @param[in,out] mon Input monitor.
+ * @param[in] dev Device handle.
+ * @param[out] changed Inputs whose debounced level changed (may be NULL).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_gpi_monitor_poll(taa3040_gpi_monitor_t *const mon, const taa3040_t *const dev, uint8_t *const changed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_GPIO_H */
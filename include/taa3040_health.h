@@ -0,0 +1,108 @@
+/**
+ * @file taa3040_health.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Periodic integrity checks with block level recovery
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_HEALTH_H
+#define TAA3040_HEALTH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * A bus glitch or a brown-out can leave a device running with part of its configuration
+ * lost. Resetting and reprogramming everything costs hundreds of milliseconds of audio,
+ * while usually only a handful of registers are wrong.
+ *
+ * The health monitor keeps the register image the device is meant to hold and reads the
+ * device back a few runs at a time, round robin, so each check costs a bounded amount of
+ * bus time. Where a run diverged only the span from its first to its last wrong register
+ * is rewritten, so a corrupted channel costs one 5 byte write and a corrupted biquad a
+ * write within its page. A channel repair leaves the other channels running. The biquad,
+ * mixer and IIR coefficients may only change with the channels powered down, as in the
+ * sequencer, so a coefficient repair clears IN_CHANNEL_EN around its write and then
+ * restores it, and every channel settles again as after a power up.
+ *
+ * SLEEP_CFG falls back to sleep on a reset, so a diverged SLEEP_CFG means the whole
+ * state was lost and the image is written again in full, which still avoids the reset.
+ * As in the sequencer, SLEEP_CFG goes first and the rest only after the device has had
+ * TAA3040_SEQUENCER_WAKE_US to wake.
+ *
+ * Each check also reads ASI_STATUS and the interrupt latch, which clears it. The latch
+ * is never compared. Runs the application changes on purpose, such as the enables under
+ * a power manager, are either kept current in the image or left out with skip_runs.
+ */
+
+#define TAA3040_HEALTH_ASI_ERROR        (0x01)  ///< The latch reported an ASI clock error
+#define TAA3040_HEALTH_PLL_ERROR        (0x02)  ///< The latch reported a PLL lock error
+#define TAA3040_HEALTH_DIVERGED         (0x04)  ///< At least one checked register held the wrong value
+#define TAA3040_HEALTH_RESET            (0x08)  ///< The device lost its whole state and was reprogrammed
+
+/**
+ * @brief Outcome of one check.
+ */
+typedef struct {
+    uint8_t flags;              ///< TAA3040_HEALTH_* events seen
+    uint8_t asi_status;         ///< ASI_STATUS as read
+    uint8_t latch;              ///< Interrupt latch as read
+    uint8_t runs_checked;       ///< Runs read back
+    uint8_t runs_repaired;      ///< Runs with registers rewritten
+    uint16_t bytes_checked;     ///< Registers read back
+    uint16_t bytes_repaired;    ///< Registers rewritten
+} taa3040_health_report_t;
+
+/**
+ * @brief Health monitor of one device.
+ */
+typedef struct {
+    const uint8_t* image;       ///< Register image the device should hold, TAA3040_IMAGE_SIZE bytes
+    void (*delay_us)(const uint32_t us);    ///< Block for at least us microseconds, to let the device wake
+    uint32_t skip_runs;         ///< Runs left unchecked, bit i for TAA3040_IMAGE_RUNS[i]
+    uint8_t next_run;           ///< Run the next check starts from
+    uint32_t checks;            ///< Checks done
+    uint32_t repairs;           ///< Checks that rewrote part of the image
+    uint32_t resets;            ///< Checks that rewrote the whole image
+} taa3040_health_t;
+
+/**
+ * @brief Initialize a health monitor.
+ *
+ * @param[out] health Monitor to initialize.
+ * @param[in] image Register image the device was programmed with, must outlive the monitor.
+ * @param[in] delay_us Blocks for at least the given microseconds.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_health_init(taa3040_health_t *const health, const uint8_t *const image, void (*const delay_us)(const uint32_t us));
+
+/**
+ * @brief Check part of the device against the image and repair what diverged.
+ *
+ * Reads back whole runs, continuing from where the previous check stopped, until at
+ * least budget registers were read or every run was checked once. Ends on page 0.
+ *
+ * @param[in,out] health Health monitor.
+ * @param[in] dev Device handle.
+ * @param[in] budget Registers to read back, TAA3040_IMAGE_SIZE checks every run.
+ * @param[out] report Outcome of the check (may be NULL).
+ * @return true if the check and any repair completed, false on a bus error.
+ */
+bool taa3040_health_check(taa3040_health_t *const health, const taa3040_t *const dev, const uint16_t budget,
+                          taa3040_health_report_t *const report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_HEALTH_H */
@@ -0,0 +1,173 @@
+/**
+ * @file taa3040_image.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Conversion between configuration structures and device register contents
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_IMAGE_H
+#define TAA3040_IMAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "taa3040_types.h"
+#include "taa3040_registers.h"
+
+/*
+ * The block codecs work on a page shadow: a TAA3040_PAGE_SIZE byte buffer indexed by
+ * register address. Encoders only touch the registers of their block and decoders only
+ * read them, so one shadow can be shared by every block on a page.
+ *
+ * A register image is the compact form of a whole taa3040_config_t: the contents of
+ * every register the configuration controls, laid out run after run in the order of
+ * TAA3040_IMAGE_RUNS, which is also the order they should be programmed in. Its size,
+ * TAA3040_IMAGE_SIZE, lives in taa3040_types.h next to taa3040_packed_config_t.
+ */
+
+#define TAA3040_IMAGE_NUM_RUNS          (17)    ///< Contiguous register runs in a register image
+#define TAA3040_IMAGE_ALL_RUNS          ((1u << TAA3040_IMAGE_NUM_RUNS) - 1u)   ///< Run mask selecting every run
+
+/* === Register Image Layout === */
+#define TAA3040_IMAGE_OFFSET_SLEEP      (0)     ///< SLEEP_CFG
+#define TAA3040_IMAGE_OFFSET_SHUTDOWN   (1)     ///< SHUTDOWN_CFG
+#define TAA3040_IMAGE_OFFSET_ASI        (2)     ///< ASI_CONFIG0-2
+#define TAA3040_IMAGE_OFFSET_ASI_SLOTS  (5)     ///< ASI channel slots through MASTER_CONFIG1
+#define TAA3040_IMAGE_OFFSET_CLOCK_SRC  (15)    ///< CLOCK_SOURCE
+#define TAA3040_IMAGE_OFFSET_PDM        (16)    ///< PDMCLK_CONFIG and PDMIN_CONFIG
+#define TAA3040_IMAGE_OFFSET_GPO        (18)    ///< GPO configuration
+#define TAA3040_IMAGE_OFFSET_GPI        (22)    ///< GPI configuration
+#define TAA3040_IMAGE_OFFSET_INTERRUPT  (24)    ///< Interrupt configuration, mask and latch
+#define TAA3040_IMAGE_OFFSET_CHANNEL    (27)    ///< Channel block, 5 registers per channel
+#define TAA3040_IMAGE_OFFSET_DSP        (67)    ///< DSP_CONFIG0-1
+#define TAA3040_IMAGE_OFFSET_AGC        (69)    ///< AGC_CONFIG
+#define TAA3040_IMAGE_OFFSET_BIQUAD_1   (70)    ///< Biquads 0-5 (page 2)
+#define TAA3040_IMAGE_OFFSET_BIQUAD_2   (190)   ///< Biquads 6-11 (page 3)
+#define TAA3040_IMAGE_OFFSET_MIXER      (310)   ///< Mixer matrix (page 4)
+#define TAA3040_IMAGE_OFFSET_IIR        (374)   ///< Custom high pass filter (page 4)
+#define TAA3040_IMAGE_OFFSET_ENABLES    (386)   ///< IN_CHANNEL_EN, ASI_OUT_CHANNEL_EN and POWER_CONFIG
+
+/** @brief Offset of a channel block register, such as TAA3040_REG_CH_GAIN(ch), in a register image */
+#define TAA3040_IMAGE_OFFSET_CH_REG(reg) (TAA3040_IMAGE_OFFSET_CHANNEL + (reg) - TAA3040_BLOCK_CHANNEL_START)
+
+/** @brief Offset of biquad i (0-11) in a register image */
+#define TAA3040_IMAGE_OFFSET_BIQUAD(i)  (((i) < TAA3040_BIQUADS_PER_PAGE? TAA3040_IMAGE_OFFSET_BIQUAD_1: TAA3040_IMAGE_OFFSET_BIQUAD_2) \
+                                            + ((i) % TAA3040_BIQUADS_PER_PAGE) * TAA3040_BIQUAD_SECTION_BYTES)
+
+/**
+ * @brief A contiguous range of registers in a register image.
+ */
+typedef struct {
+    uint8_t page;       ///< Page of the run
+    uint8_t reg;        ///< First register of the run
+    uint8_t length;     ///< Number of registers in the run
+    uint16_t offset;    ///< Byte offset of the run in the register image
+} taa3040_image_run_t;
+
+/** @brief Register runs making up a register image, in programming order */
+extern const taa3040_image_run_t TAA3040_IMAGE_RUNS[TAA3040_IMAGE_NUM_RUNS];
+
+/* === Register Image === */
+
+/**
+ * @brief Encode a full configuration into a register image.
+ *
+ * The sleep configuration is encoded with the device awake. Fields without a backing
+ * register (asi_config.auto_clock_enabled, system_config.advanced.fixed_i2c_address)
+ * are not stored.
+ *
+ * @param[in] config Configuration to encode.
+ * @param[out] image Buffer of TAA3040_IMAGE_SIZE bytes.
+ */
+void taa3040_image_encode(const taa3040_config_t *const config, uint8_t *const image);
+
+/**
+ * @brief Decode a register image into a full configuration.
+ *
+ * @param[in] image Buffer of TAA3040_IMAGE_SIZE bytes.
+ * @param[out] config Configuration to fill; fields without a backing register are left untouched.
+ */
+void taa3040_image_decode(const uint8_t *const image, taa3040_config_t *const config);
+
+/**
+ * @brief Find where a register is stored in a register image.
+ *
+ * @param[in] page Page of the register.
+ * @param[in] reg Register address.
+ * @return Byte offset in the image, or -1 if the register is not part of the image.
+ */
+int taa3040_image_offset(const uint8_t page, const uint8_t reg);
+
+/* === Block Codecs (Page 0) === */
+
+/** @brief Encode the system configuration into SLEEP_CFG, SHUTDOWN_CFG, PDM and POWER_CONFIG */
+void taa3040_encode_system_config(const taa3040_system_config_t *const config, uint8_t *const page0);
+/** @brief Decode the system configuration from SLEEP_CFG, SHUTDOWN_CFG, PDM and POWER_CONFIG */
+void taa3040_decode_system_config(const uint8_t *const page0, taa3040_system_config_t *const config);
+
+/** @brief Encode the ASI configuration into the ASI block and ASI_OUT_CHANNEL_EN */
+void taa3040_encode_asi_config(const taa3040_asi_config_t *const asi_config, uint8_t *const page0);
+/** @brief Decode the ASI configuration from the ASI block and ASI_OUT_CHANNEL_EN */
+void taa3040_decode_asi_config(const uint8_t *const page0, taa3040_asi_config_t *const asi_config);
+
+/** @brief Encode one channel into its 5-register block and its IN_CHANNEL_EN bit */
+void taa3040_encode_channel_config(const uint8_t channel, const taa3040_channel_config_t *const ch_config, uint8_t *const page0);
+/** @brief Decode one channel from its 5-register block and its IN_CHANNEL_EN bit */
+void taa3040_decode_channel_config(const uint8_t *const page0, const uint8_t channel, taa3040_channel_config_t *const ch_config);
+
+/** @brief Encode the GPO and GPI configuration registers */
+void taa3040_encode_gpio_config(const taa3040_gpio_config_t *const gpio_config, uint8_t *const page0);
+/** @brief Decode the GPO and GPI configuration registers */
+void taa3040_decode_gpio_config(const uint8_t *const page0, taa3040_gpio_config_t *const gpio_config);
+
+/** @brief Encode the interrupt configuration, mask and latch registers */
+void taa3040_encode_interrupt_config(const taa3040_interrupt_config_t *const int_config, uint8_t *const page0);
+/** @brief Decode the interrupt configuration, mask and latch registers */
+void taa3040_decode_interrupt_config(const uint8_t *const page0, taa3040_interrupt_config_t *const int_config);
+
+/** @brief Encode DSP_CONFIG0/1 and AGC_CONFIG (filters live on other pages) */
+void taa3040_encode_dsp_config(const taa3040_dsp_config_t *const dsp_config, uint8_t *const page0);
+/** @brief Decode DSP_CONFIG0/1 and AGC_CONFIG (filters live on other pages) */
+void taa3040_decode_dsp_config(const uint8_t *const page0, taa3040_dsp_config_t *const dsp_config);
+
+/* === Coefficient Codecs === */
+
+/** @brief Store a coefficient as 4 big-endian register bytes */
+static inline void taa3040_encode_i32(const int32_t v, uint8_t *const b)
+{
+    b[0] = (uint8_t)((uint32_t)v >> 24);
+    b[1] = (uint8_t)((uint32_t)v >> 16);
+    b[2] = (uint8_t)((uint32_t)v >> 8);
+    b[3] = (uint8_t)v;
+}
+
+/** @brief Load a coefficient from 4 big-endian register bytes */
+static inline int32_t taa3040_decode_i32(const uint8_t *const b)
+{
+    return (int32_t)(((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3]);
+}
+
+/** @brief Encode a biquad as its 20 coefficient register bytes */
+void taa3040_encode_biquad(const taa3040_biquad_filter_t *const filter, uint8_t *const regs);
+/** @brief Decode a biquad from its 20 coefficient register bytes */
+void taa3040_decode_biquad(const uint8_t *const regs, taa3040_biquad_filter_t *const filter);
+
+/** @brief Encode the first order IIR as its 12 coefficient register bytes */
+void taa3040_encode_iir(const taa3040_iir_filter_t *const filter, uint8_t *const regs);
+/** @brief Decode the first order IIR from its 12 coefficient register bytes */
+void taa3040_decode_iir(const uint8_t *const regs, taa3040_iir_filter_t *const filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_IMAGE_H */
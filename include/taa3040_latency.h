@@ -0,0 +1,148 @@
+/**
+ * @file taa3040_latency.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Capture latency of a configuration, from the analog input to the ASI bus
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_LATENCY_H
+#define TAA3040_LATENCY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * The latency of a channel is the sum of:
+ *
+ *  - the decimation filter's group delay, a fixed number of samples per filter type;
+ *  - the group delay of the high pass filter and of the channel's biquads at a chosen
+ *    frequency, computed from their coefficients (the preset high pass filters are
+ *    first order with a cutoff of fs/4000, fs/500 or fs/125);
+ *  - the ASI framing: the frame of buffering before a sample is sent, then the BCLK
+ *    cycles up to the last bit of the channel's slot, counting the offset, the half
+ *    frame of the right hand slots (32 - 63) in I2S and LJ, and the extra cycle of I2S.
+ *
+ * The sample rate and BCLK ratio are those of asi_config.master_mode, which in slave
+ * mode must describe the clocking the host runs. The modulator, the mixer and the
+ * volume control add no delay worth counting.
+ *
+ * The low latency and ultra low latency filters are IIR, so their delay varies a little
+ * across the passband; the figures below are their typical values at low frequencies.
+ */
+
+#ifndef TAA3040_LATENCY_DELAY_LIN_PHASE
+#define TAA3040_LATENCY_DELAY_LIN_PHASE             (17.1f)     ///< Linear phase filter group delay in samples, may be overridden at build time
+#endif
+#ifndef TAA3040_LATENCY_DELAY_LOW_LATENCY
+#define TAA3040_LATENCY_DELAY_LOW_LATENCY           (7.6f)      ///< Low latency filter group delay in samples, may be overridden at build time
+#endif
+#ifndef TAA3040_LATENCY_DELAY_ULTRA_LOW_LATENCY
+#define TAA3040_LATENCY_DELAY_ULTRA_LOW_LATENCY     (4.3f)      ///< Ultra low latency filter group delay in samples, may be overridden at build time
+#endif
+
+#ifndef TAA3040_LATENCY_PASSBAND_LIN_PHASE
+#define TAA3040_LATENCY_PASSBAND_LIN_PHASE          (0.454f)    ///< Linear phase filter passband edge over the sample rate, may be overridden at build time
+#endif
+#ifndef TAA3040_LATENCY_PASSBAND_LOW_LATENCY
+#define TAA3040_LATENCY_PASSBAND_LOW_LATENCY        (0.365f)    ///< Low latency filter passband edge over the sample rate, may be overridden at build time
+#endif
+#ifndef TAA3040_LATENCY_PASSBAND_ULTRA_LOW_LATENCY
+#define TAA3040_LATENCY_PASSBAND_ULTRA_LOW_LATENCY  (0.325f)    ///< Ultra low latency filter passband edge over the sample rate, may be overridden at build time
+#endif
+
+#ifndef TAA3040_LATENCY_RIPPLE_LIN_PHASE
+#define TAA3040_LATENCY_RIPPLE_LIN_PHASE            (0.05f)     ///< Linear phase filter passband ripple in dB, may be overridden at build time
+#endif
+#ifndef TAA3040_LATENCY_RIPPLE_LOW_LATENCY
+#define TAA3040_LATENCY_RIPPLE_LOW_LATENCY          (0.015f)    ///< Low latency filter passband ripple in dB, may be overridden at build time
+#endif
+#ifndef TAA3040_LATENCY_RIPPLE_ULTRA_LOW_LATENCY
+#define TAA3040_LATENCY_RIPPLE_ULTRA_LOW_LATENCY    (0.04f)     ///< Ultra low latency filter passband ripple in dB, may be overridden at build time
+#endif
+
+#ifndef TAA3040_LATENCY_ASI_FRAMES
+#define TAA3040_LATENCY_ASI_FRAMES                  (1u)        ///< Frames a sample waits before it is sent, may be overridden at build time
+#endif
+
+/**
+ * @brief Latency of one channel.
+ */
+typedef struct {
+    float decimation_us;        ///< Decimation filter group delay
+    float high_pass_us;         ///< High pass filter group delay at the frequency
+    float biquad_us;            ///< Group delay of the channel's biquads at the frequency
+    float asi_us;               ///< From the end of the sample's frame to the last bit of its slot
+    float total_us;             ///< Sum of the above
+    uint32_t sample_rate_hz;    ///< Sample rate the figures are for
+} taa3040_latency_t;
+
+/**
+ * @brief Requirements on the capture path.
+ */
+typedef struct {
+    float low_hz;               ///< Lowest frequency of the passband
+    float high_hz;              ///< Highest frequency of the passband
+    float max_droop_db;         ///< Largest high pass filter loss allowed at low_hz
+    float max_ripple_db;        ///< Largest decimation filter ripple allowed
+    float frequency_hz;         ///< Frequency the latency is evaluated at
+    bool linear_phase;          ///< Only the linear phase decimation filter will do
+    uint32_t max_sample_rate_hz;///< Highest sample rate to consider, 0 to keep the configured rate
+} taa3040_latency_spec_t;
+
+/**
+ * @brief Latency of a channel.
+ *
+ * @param[in] config Configuration.
+ * @param[in] channel Channel (0 - 7).
+ * @param[in] frequency_hz Frequency the filter delays are evaluated at.
+ * @param[out] latency Latency of the channel.
+ * @return true if successful, false if the arguments or the clocking are invalid.
+ */
+bool taa3040_latency_channel(const taa3040_config_t *const config, const uint8_t channel, const float frequency_hz,
+                             taa3040_latency_t *const latency);
+
+/**
+ * @brief Latency of the slowest channel enabled on the ASI bus.
+ *
+ * @param[in] config Configuration.
+ * @param[in] frequency_hz Frequency the filter delays are evaluated at.
+ * @param[out] latency Latency of that channel.
+ * @param[out] channel That channel (may be NULL).
+ * @return true if successful, false if no channel is enabled or the arguments are invalid.
+ */
+bool taa3040_latency_worst(const taa3040_config_t *const config, const float frequency_hz, taa3040_latency_t *const latency,
+                           uint8_t *const channel);
+
+/**
+ * @brief Find the settings with the lowest latency that still meet a passband spec.
+ *
+ * Tries every decimation filter, high pass filter and, up to spec->max_sample_rate_hz,
+ * sample rate of the configured family, keeping the BCLK ratio, and picks the lowest
+ * worst channel latency, preferring lower sample rates on a tie. A rate must fit the
+ * frame within the BCLK limit and, with PDM channels, be served by the configured PDM
+ * clock. Biquads are kept as they are, so they need designing again for a new rate.
+ *
+ * @param[in] config Configuration to start from.
+ * @param[in] spec Requirements.
+ * @param[out] recommended config with the chosen decimation filter, high pass filter and sample rate.
+ * @param[out] latency Latency of the recommendation (may be NULL).
+ * @return true if a setting meets the spec, false otherwise.
+ */
+bool taa3040_latency_recommend(const taa3040_config_t *const config, const taa3040_latency_spec_t *const spec,
+                               taa3040_config_t *const recommended, taa3040_latency_t *const latency);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_LATENCY_H */
@@ -0,0 +1,173 @@
+/**
+ * @file taa3040_linux.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief HAL for Linux i2c-dev buses (/dev/i2c-N) and a file sink for the recorder
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_LINUX_H
+#define TAA3040_LINUX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+#include "taa3040_recorder.h"
+
+/*
+ * Each transfer of the HAL is a single I2C_RDWR ioctl, so a register read is the
+ * address write and the repeated start read in one call into the kernel rather than a
+ * write() and a read().
+ *
+ * Page select writes are held back per device and go out as the first message of that
+ * device's next transfer, so selecting a page and the burst on it also take a single
+ * ioctl. Of several selects held for one device only the last is sent. The page select
+ * that returns the device to page 0 at the end of a driver call is carried into its next
+ * call the same way. A failure of a held page select is reported by the device's
+ * transfer it went out with. Before a transfer to another device, selects held for other
+ * devices are sent in an ioctl of their own, never ahead of another device's messages;
+ * their failures are counted in held_failures. taa3040_linux_i2c_flush sends held
+ * writes on their own, e.g. before handing the bus to another process or powering the
+ * device down.
+ *
+ * Adapters without plain I2C support, such as the i2c-stub module, are driven with SMBus
+ * I2C block transfers of up to 32 bytes, or single bytes when those are missing too. The
+ * bench runs every driver call over a bus given as its second argument:
+ *
+ *   modprobe i2c-dev && modprobe i2c-stub chip_addr=0x4c
+ *   ./TAA3040_bench 100 /dev/i2c-N
+ *
+ * i2c-stub only covers that SMBus fallback. It has no plain I2C, so neither the I2C_RDWR
+ * transfers nor the held page selects are reached through it. For those the bench builds
+ * the HAL with TAA3040_LINUX_IOCTL naming a function of ioctl's signature, which the HAL
+ * then calls instead of the kernel, and runs it over a modelled adapter: the bus argument
+ * "model-i2c" gives it plain I2C, "model-smbus" only the SMBus transfers.
+ *
+ * With TAA3040_HAL_CONTEXT the HAL's i2c_context is the bus, so any number of buses can
+ * be open. Without it the HAL functions share one bus: taa3040_linux_i2c_hal binds it and
+ * fails for any other bus until it is closed.
+ */
+
+/*
+ * The recorder sink writes each file with pwrite from the writer thread. With direct set
+ * the files are opened O_DIRECT, so the blocks go from the ring to the device without a
+ * copy into the page cache. The ring and header buffers must then be aligned to the
+ * logical block size of the file system, 4096 covers every common one, and header_bytes
+ * and block_bytes must be multiples of it. File systems that refuse O_DIRECT, such as
+ * tmpfs, get buffered writes instead. A closed file is trimmed to its length and, with
+ * sync set, flushed to storage.
+ */
+
+#ifndef TAA3040_LINUX_MAX_HELD
+#define TAA3040_LINUX_MAX_HELD  (4)     ///< Devices with a page select held for their next transfer, may be overridden at build time
+#endif
+
+#ifndef TAA3040_LINUX_MAX_PATH
+#define TAA3040_LINUX_MAX_PATH  (256)   ///< Longest recording file path, may be overridden at build time
+#endif
+
+/**
+ * @brief An open i2c-dev bus.
+ */
+typedef struct {
+    int fd;                                     ///< File descriptor of /dev/i2c-N, -1 when closed
+    unsigned long functionality;                ///< I2C_FUNC_* bits of the adapter
+    int16_t slave;                              ///< Address bound with I2C_SLAVE for SMBus transfers, -1 for none
+    uint8_t held_count;                         ///< Page select writes held
+    uint8_t held_address[TAA3040_LINUX_MAX_HELD];   ///< Device of each held write, one write per device
+    uint8_t held[TAA3040_LINUX_MAX_HELD][2];        ///< Held writes: page select register, page
+    uint32_t held_failures;                     ///< Held writes of other devices that failed when sent ahead of a transfer
+    uint32_t ioctls;                            ///< Calls into the kernel so far
+} taa3040_linux_i2c_t;
+
+/**
+ * @brief Recording files, the context of a recorder sink.
+ */
+typedef struct {
+    const char* pattern;    ///< printf pattern of the file path, given the file index, e.g. "/data/take%03u.wav"
+    bool direct;            ///< Open the files O_DIRECT where the file system allows it
+    bool sync;              ///< Flush each file to storage when it is closed
+    uint32_t writes;        ///< pwrite calls so far
+    uint64_t bytes;         ///< Bytes written so far
+} taa3040_linux_files_t;
+
+/**
+ * @brief Open an i2c-dev bus.
+ *
+ * @param[out] bus Bus to open.
+ * @param[in] path Device node, e.g. "/dev/i2c-1".
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_linux_i2c_open(taa3040_linux_i2c_t *const bus, const char *const path);
+
+/**
+ * @brief Send held writes, then close the bus, unbinding it from the HAL.
+ *
+ * @param[in,out] bus Bus.
+ */
+void taa3040_linux_i2c_close(taa3040_linux_i2c_t *const bus);
+
+/**
+ * @brief Send held page select writes now.
+ *
+ * @param[in,out] bus Bus.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_linux_i2c_flush(taa3040_linux_i2c_t *const bus);
+
+/**
+ * @brief Fill in a HAL for devices on the bus. The enable pin is left unset.
+ *
+ * @param[in] bus Bus, must outlive the devices using the HAL.
+ * @param[out] hal HAL to fill in, for taa3040_init.
+ * @return true if successful, false if, without TAA3040_HAL_CONTEXT, another bus is bound.
+ */
+bool taa3040_linux_i2c_hal(taa3040_linux_i2c_t *const bus, taa3040_hal_t *const hal);
+
+/**
+ * @brief Read registers from a device on the bus.
+ *
+ * @param[in,out] bus Bus.
+ * @param[in] address 7-bit I2C address.
+ * @param[in] reg First register.
+ * @param[out] data Bytes read.
+ * @param[in] length Bytes to read.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_linux_i2c_read(taa3040_linux_i2c_t *const bus, const uint8_t address, const uint8_t reg, void *const data, const uint8_t length);
+
+/**
+ * @brief Write registers of a device on the bus.
+ *
+ * @param[in,out] bus Bus.
+ * @param[in] address 7-bit I2C address.
+ * @param[in] reg First register.
+ * @param[in] data Bytes to write.
+ * @param[in] length Bytes to write.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_linux_i2c_write(taa3040_linux_i2c_t *const bus, const uint8_t address, const uint8_t reg, const void *const data,
+                             const uint8_t length);
+
+/**
+ * @brief Fill in a synchronous recorder sink writing the files with pwrite.
+ *
+ * @param[in] files Path pattern and options, must outlive the recorder.
+ * @param[out] sink Sink to fill in, for taa3040_recorder_init.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_linux_recorder_sink(taa3040_linux_files_t *const files, taa3040_recorder_sink_t *const sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_LINUX_H */
@@ -0,0 +1,166 @@
+/**
+ * @file taa3040_manager.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Management of many devices spread over several I2C buses
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_MANAGER_H
+#define TAA3040_MANAGER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * Devices are registered with the index of the bus they sit on. A job is run on every
+ * device by handing one work item per bus to an executor: devices sharing a bus are
+ * handled one after the other inside their work item, while buses proceed in parallel
+ * on however many workers the executor provides. Configuring a rack then takes as long
+ * as its most populated bus rather than the sum of every device.
+ *
+ * Build with TAA3040_HAL_CONTEXT so that devices can share HAL functions and tell their
+ * bus and enable pin apart through i2c_context and enable_context.
+ */
+
+#ifndef TAA3040_MANAGER_MAX_DEVICES
+#define TAA3040_MANAGER_MAX_DEVICES     (16)    ///< Devices a manager can hold, may be overridden at build time
+#endif
+
+#ifndef TAA3040_MANAGER_MAX_BUSES
+#define TAA3040_MANAGER_MAX_BUSES       (4)     ///< I2C buses a manager can hold, may be overridden at build time
+#endif
+
+/**
+ * @brief Work run on one device.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] arg Argument given to taa3040_manager_run.
+ * @return true if successful, false otherwise.
+ */
+typedef bool (*taa3040_manager_job_fn)(taa3040_t *const dev, void *const arg);
+
+/** @brief Work item handed to an executor */
+typedef void (*taa3040_work_fn)(void *const arg);
+
+/**
+ * @brief Runs work items, typically on a pool of threads or RTOS tasks.
+ */
+typedef struct {
+    void (*submit)(void *const context, const taa3040_work_fn work, void *const arg);    ///< Start work(arg) on a free worker
+    void (*wait)(void *const context);                                                  ///< Block until all submitted work has returned, required with submit
+    void* context;                                                                      ///< Passed to submit and wait
+} taa3040_executor_t;
+
+struct taa3040_manager;
+
+/**
+ * @brief Work item covering every device on one bus.
+ */
+typedef struct {
+    struct taa3040_manager* manager;    ///< Manager the bus belongs to
+    uint8_t bus;                        ///< Bus index
+    uint8_t failures;                   ///< Devices on the bus whose job failed during the last run
+} taa3040_manager_bus_t;
+
+/**
+ * @brief A set of devices and the buses they are on.
+ */
+typedef struct taa3040_manager {
+    taa3040_t* devices[TAA3040_MANAGER_MAX_DEVICES];        ///< Registered devices
+    uint8_t device_bus[TAA3040_MANAGER_MAX_DEVICES];        ///< Bus index of each device
+    bool device_ok[TAA3040_MANAGER_MAX_DEVICES];            ///< Result of the last job run on each device
+    taa3040_manager_bus_t buses[TAA3040_MANAGER_MAX_BUSES]; ///< Work item of each bus
+    uint8_t device_count;                                   ///< Number of registered devices
+    taa3040_manager_job_fn job;                             ///< Job of the run in progress
+    void* job_arg;                                          ///< Argument of the run in progress
+} taa3040_manager_t;
+
+/**
+ * @brief Initialize a manager with no devices.
+ *
+ * @param[out] manager Manager to initialize.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_manager_init(taa3040_manager_t *const manager);
+
+/**
+ * @brief Register an initialized device.
+ *
+ * Jobs reach the devices of a bus in the order they were registered.
+ *
+ * @param[in,out] manager Manager.
+ * @param[in] dev Device handle, already set up with taa3040_init. Must outlive the manager.
+ * @param[in] bus Index of the I2C bus the device is on, below TAA3040_MANAGER_MAX_BUSES.
+ * @return true if successful, false if the manager is full or the bus is out of range.
+ */
+bool taa3040_manager_add(taa3040_manager_t *const manager, taa3040_t *const dev, const uint8_t bus);
+
+/**
+ * @brief Run a job on every device of one bus, one device after the other.
+ *
+ * Executors that manage their own queues can call this directly from one task per bus.
+ *
+ * @param[in,out] manager Manager.
+ * @param[in] bus Bus index.
+ * @param[in] job Job to run.
+ * @param[in] arg Argument passed to the job.
+ * @return Number of devices on the bus whose job failed.
+ */
+uint8_t taa3040_manager_run_bus(taa3040_manager_t *const manager, const uint8_t bus, const taa3040_manager_job_fn job, void *const arg);
+
+/**
+ * @brief Run a job on every device, with the buses in parallel.
+ *
+ * Every bus with devices is submitted to the executor as one work item, then the executor
+ * is waited on. Without an executor the buses are run in turn on the calling thread. An
+ * executor with submit but no wait is refused without running the job.
+ *
+ * @param[in,out] manager Manager.
+ * @param[in] job Job to run.
+ * @param[in] arg Argument passed to the job, shared by every worker.
+ * @param[in] executor Executor to run the buses on (may be NULL).
+ * @return Number of devices whose job failed, see device_ok for which ones; every device if the executor is refused.
+ */
+uint8_t taa3040_manager_run(taa3040_manager_t *const manager, const taa3040_manager_job_fn job, void *const arg, const taa3040_executor_t *const executor);
+
+/**
+ * @brief Drive the enable pin of every device high.
+ *
+ * Pins are toggled back to back on the calling thread, so every device powers up at once.
+ *
+ * @param[in] manager Manager.
+ */
+void taa3040_manager_startup(const taa3040_manager_t *const manager);
+
+/**
+ * @brief Drive the enable pin of every device low.
+ *
+ * @param[in] manager Manager.
+ */
+void taa3040_manager_shutdown(const taa3040_manager_t *const manager);
+
+/**
+ * @brief Apply one configuration to every device.
+ *
+ * @param[in,out] manager Manager.
+ * @param[in] config Configuration to apply.
+ * @param[in] executor Executor to run the buses on (may be NULL).
+ * @return Number of devices that could not be configured.
+ */
+uint8_t taa3040_manager_set_device_config(taa3040_manager_t *const manager, const taa3040_config_t *const config, const taa3040_executor_t *const executor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_MANAGER_H */
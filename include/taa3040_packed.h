@@ -0,0 +1,213 @@
+/**
+ * @file taa3040_packed.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Packed, register-native configuration and its accessors
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_PACKED_H
+#define TAA3040_PACKED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+#include "taa3040_image.h"
+#include "taa3040_registers.h"
+
+/*
+ * taa3040_packed_config_t keeps a configuration as the register bytes the device holds,
+ * so the frequently changed fields below are a mask and shift away and writing the whole
+ * configuration is a straight copy of its runs. Build with TAA3040_PACKED_CONFIG to cache
+ * the configuration of each taa3040_t in this form.
+ */
+
+/* === Conversion === */
+
+/**
+ * @brief Convert a configuration into its packed form.
+ *
+ * @param[in] config Configuration to convert.
+ * @param[out] packed Packed configuration.
+ */
+void taa3040_pack_config(const taa3040_config_t *const config, taa3040_packed_config_t *const packed);
+
+/**
+ * @brief Convert a packed configuration back into a full configuration.
+ *
+ * Every field in range for its register survives a pack and unpack unchanged.
+ *
+ * @param[in] packed Packed configuration.
+ * @param[out] config Configuration to fill.
+ */
+void taa3040_unpack_config(const taa3040_packed_config_t *const packed, taa3040_config_t *const config);
+
+/* === Device Access === */
+
+/**
+ * @brief Apply a packed configuration, one transfer per register run.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] packed Packed configuration.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_set_packed_config(const taa3040_t *const dev, const taa3040_packed_config_t *const packed);
+
+/**
+ * @brief Read the device configuration in packed form.
+ *
+ * @param[in] dev Device handle.
+ * @param[in,out] packed Packed configuration; flags are left untouched as they have no register.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_get_packed_config(const taa3040_t *const dev, taa3040_packed_config_t *const packed);
+
+/* === Field Accessors === */
+
+/* --- Internal Helpers --- */
+static inline uint8_t taa3040_packed_channel_bit(const uint8_t channel)
+{
+    return TAA3040_CHANNEL_BIT(channel);
+}
+
+static inline void taa3040_packed_update(uint8_t *const reg, const uint8_t mask, const uint8_t value)
+{
+    *reg = (uint8_t)((*reg & ~mask) | (value & mask));
+}
+
+/** @brief If an input channel is enabled (IN_CHANNEL_EN) */
+static inline bool taa3040_packed_get_channel_enabled(const taa3040_packed_config_t *const p, const uint8_t channel)
+{
+    return !!(p->image[TAA3040_IMAGE_OFFSET_ENABLES] & taa3040_packed_channel_bit(channel));
+}
+
+/** @brief Enable or disable an input channel (IN_CHANNEL_EN) */
+static inline void taa3040_packed_set_channel_enabled(taa3040_packed_config_t *const p, const uint8_t channel, const bool enabled)
+{
+    taa3040_packed_update(&p->image[TAA3040_IMAGE_OFFSET_ENABLES], taa3040_packed_channel_bit(channel), enabled? 0xFF: 0);
+}
+
+/** @brief If an ASI output channel is enabled (ASI_OUT_CHANNEL_EN) */
+static inline bool taa3040_packed_get_output_enabled(const taa3040_packed_config_t *const p, const uint8_t channel)
+{
+    return !!(p->image[TAA3040_IMAGE_OFFSET_ENABLES + 1] & taa3040_packed_channel_bit(channel));
+}
+
+/** @brief Enable or disable an ASI output channel (ASI_OUT_CHANNEL_EN) */
+static inline void taa3040_packed_set_output_enabled(taa3040_packed_config_t *const p, const uint8_t channel, const bool enabled)
+{
+    taa3040_packed_update(&p->image[TAA3040_IMAGE_OFFSET_ENABLES + 1], taa3040_packed_channel_bit(channel), enabled? 0xFF: 0);
+}
+
+/** @brief Analog gain setting of a channel */
+static inline uint8_t taa3040_packed_get_gain_db(const taa3040_packed_config_t *const p, const uint8_t channel)
+{
+    return (p->image[TAA3040_IMAGE_OFFSET_CH_REG(TAA3040_REG_CH_GAIN(channel))] & TAA3040_CHANNEL_GAIN_MASK) >> TAA3040_CHANNEL_GAIN_SHIFT;
+}
+
+/** @brief Set the analog gain setting of a channel */
+static inline void taa3040_packed_set_gain_db(taa3040_packed_config_t *const p, const uint8_t channel, const uint8_t gain_db)
+{
+    taa3040_packed_update(&p->image[TAA3040_IMAGE_OFFSET_CH_REG(TAA3040_REG_CH_GAIN(channel))],
+        TAA3040_CHANNEL_GAIN_MASK, (uint8_t)(gain_db << TAA3040_CHANNEL_GAIN_SHIFT));
+}
+
+/** @brief Digital volume code of a channel */
+static inline uint8_t taa3040_packed_get_digital_volume(const taa3040_packed_config_t *const p, const uint8_t channel)
+{
+    return (p->image[TAA3040_IMAGE_OFFSET_CH_REG(TAA3040_REG_CH_VOLUME(channel))] & TAA3040_CHANNEL_VOLUME_MASK) >> TAA3040_CHANNEL_VOLUME_SHIFT;
+}
+
+/** @brief Set the digital volume code of a channel */
+static inline void taa3040_packed_set_digital_volume(taa3040_packed_config_t *const p, const uint8_t channel, const uint8_t volume_code)
+{
+    taa3040_packed_update(&p->image[TAA3040_IMAGE_OFFSET_CH_REG(TAA3040_REG_CH_VOLUME(channel))],
+        TAA3040_CHANNEL_VOLUME_MASK, (uint8_t)(volume_code << TAA3040_CHANNEL_VOLUME_SHIFT));
+}
+
+/** @brief ASI slot a channel is transmitted in */
+static inline uint8_t taa3040_packed_get_slot(const taa3040_packed_config_t *const p, const uint8_t channel)
+{
+    return (p->image[TAA3040_IMAGE_OFFSET_ASI_SLOTS + channel] & TAA3040_ASI_CHANNEL_SLOT_MASK) >> TAA3040_ASI_CHANNEL_SLOT_SHIFT;
+}
+
+/** @brief Set the ASI slot a channel is transmitted in */
+static inline void taa3040_packed_set_slot(taa3040_packed_config_t *const p, const uint8_t channel, const uint8_t slot)
+{
+    taa3040_packed_update(&p->image[TAA3040_IMAGE_OFFSET_ASI_SLOTS + channel],
+        TAA3040_ASI_CHANNEL_SLOT_MASK, (uint8_t)(slot << TAA3040_ASI_CHANNEL_SLOT_SHIFT));
+}
+
+/** @brief If the ADC is powered (POWER_CONFIG) */
+static inline bool taa3040_packed_get_adc_enabled(const taa3040_packed_config_t *const p)
+{
+    return !!(p->image[TAA3040_IMAGE_OFFSET_ENABLES + 2] & TAA3040_ADC_ENABLE_MASK);
+}
+
+/** @brief Power the ADC up or down (POWER_CONFIG) */
+static inline void taa3040_packed_set_adc_enabled(taa3040_packed_config_t *const p, const bool enabled)
+{
+    taa3040_packed_update(&p->image[TAA3040_IMAGE_OFFSET_ENABLES + 2], TAA3040_ADC_ENABLE_MASK, enabled? 0xFF: 0);
+}
+
+/** @brief Number of biquads per channel */
+static inline uint8_t taa3040_packed_get_biquads_per_channel(const taa3040_packed_config_t *const p)
+{
+    return (p->image[TAA3040_IMAGE_OFFSET_DSP + 1] & TAA3040_BIQUAD_COUNT_MASK) >> TAA3040_BIQUAD_COUNT_SHIFT;
+}
+
+/** @brief Set the number of biquads per channel */
+static inline void taa3040_packed_set_biquads_per_channel(taa3040_packed_config_t *const p, const uint8_t biquads)
+{
+    taa3040_packed_update(&p->image[TAA3040_IMAGE_OFFSET_DSP + 1], TAA3040_BIQUAD_COUNT_MASK, (uint8_t)(biquads << TAA3040_BIQUAD_COUNT_SHIFT));
+}
+
+/** @brief Weight of an input in the mix of an output channel */
+static inline int8_t taa3040_packed_get_mixer(const taa3040_packed_config_t *const p, const uint8_t channel, const uint8_t input)
+{
+    return (int8_t)p->image[TAA3040_IMAGE_OFFSET_MIXER + channel * TAA3040_MIXER_CHANNEL_STRIDE + input];
+}
+
+/** @brief Set the weight of an input in the mix of an output channel */
+static inline void taa3040_packed_set_mixer(taa3040_packed_config_t *const p, const uint8_t channel, const uint8_t input, const int8_t weight)
+{
+    p->image[TAA3040_IMAGE_OFFSET_MIXER + channel * TAA3040_MIXER_CHANNEL_STRIDE + input] = (uint8_t)weight;
+}
+
+/** @brief Coefficients of biquad index (0-11) */
+static inline void taa3040_packed_get_biquad(const taa3040_packed_config_t *const p, const uint8_t index, taa3040_biquad_filter_t *const filter)
+{
+    taa3040_decode_biquad(&p->image[TAA3040_IMAGE_OFFSET_BIQUAD(index)], filter);
+}
+
+/** @brief Set the coefficients of biquad index (0-11) */
+static inline void taa3040_packed_set_biquad(taa3040_packed_config_t *const p, const uint8_t index, const taa3040_biquad_filter_t *const filter)
+{
+    taa3040_encode_biquad(filter, &p->image[TAA3040_IMAGE_OFFSET_BIQUAD(index)]);
+}
+
+/** @brief If automatic clock detection is enabled (no backing register) */
+static inline bool taa3040_packed_get_auto_clock(const taa3040_packed_config_t *const p)
+{
+    return !!(p->flags & TAA3040_PACKED_AUTO_CLOCK_MASK);
+}
+
+/** @brief Enable or disable automatic clock detection (no backing register) */
+static inline void taa3040_packed_set_auto_clock(taa3040_packed_config_t *const p, const bool enabled)
+{
+    taa3040_packed_update(&p->flags, TAA3040_PACKED_AUTO_CLOCK_MASK, enabled? 0xFF: 0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_PACKED_H */
@@ -0,0 +1,159 @@
+/**
+ * @file taa3040_power.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Activity driven channel power management
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_POWER_H
+#define TAA3040_POWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * An always-on array rarely needs every channel while the room is quiet. The power
+ * manager watches the capture stream with a cheap energy detector per channel and powers
+ * channels down once they have been idle for a while, leaving a few listening channels
+ * (the sentinels) powered. As soon as a sentinel hears activity every managed channel is
+ * powered back up in a single write of IN_CHANNEL_EN.
+ *
+ * The detector tracks a noise floor per channel, falling to quiet blocks at once and
+ * rising slowly to loud ones, and compares the energy of each block against it. Activity
+ * starts above on_ratio times the floor and ends below off_ratio times the floor, so a
+ * level between the two never toggles a channel. A channel is only powered down after
+ * hang_blocks idle blocks in a row.
+ *
+ * Switching channels while others record should be done with dynamic_power_mode enabled
+ * in the system configuration and dynamic_mode_channels covering every managed channel,
+ * otherwise the device may glitch the channels that stay powered. The manager is given
+ * the same dynamic_mode_channels and refuses a managed channel outside of it.
+ *
+ * Every change of the enables is appended to a caller supplied ring of events, which
+ * together with the per channel powered time is what thresholds are tuned against.
+ */
+
+/**
+ * @brief Power manager tuning.
+ *
+ * Channel masks are in IN_CHANNEL_EN order, channel 1 in bit 7 down to channel 8 in bit 0.
+ * Ratios are Q8, 256 is the noise floor itself (0 dB), 1024 is 6 dB above it.
+ */
+typedef struct {
+    uint8_t sentinel_mask;          ///< Channels that stay powered and wake the others
+    uint8_t managed_mask;           ///< Channels that may be powered down, within dynamic_channels
+    taa3040_dynamic_mode_channels_t dynamic_channels;   ///< dynamic_mode_channels of the system configuration
+    uint16_t on_ratio;              ///< Energy above the floor at which activity starts (Q8)
+    uint16_t off_ratio;             ///< Energy above the floor below which activity ends (Q8, at most on_ratio)
+    uint32_t min_energy;            ///< Energy (16 bit samples squared) below which a block is always idle
+    uint16_t hang_blocks;           ///< Consecutive idle blocks before a channel is powered down
+    uint8_t floor_rise_shift;       ///< Floor rises by 1 / 2^shift of the difference on a louder block
+} taa3040_power_config_t;
+
+#define TAA3040_POWER_TRIGGER_IDLE  (0xFF)  ///< Event trigger of channels powered down for being idle
+
+/**
+ * @brief One change of the channel enables.
+ */
+typedef struct {
+    uint32_t timestamp;             ///< Caller timestamp of the block that caused the change
+    uint32_t block;                 ///< Block index since the manager was initialized
+    uint32_t energy;                ///< Energy of the trigger channel in that block
+    uint32_t floor;                 ///< Noise floor of the trigger channel
+    uint16_t detect_blocks;         ///< Blocks from the trigger first passing off_ratio to passing on_ratio
+    uint8_t enabled_before;         ///< IN_CHANNEL_EN before the change
+    uint8_t enabled_after;          ///< IN_CHANNEL_EN after the change
+    uint8_t trigger;                ///< Channel (0 - 7) that woke the others, TAA3040_POWER_TRIGGER_IDLE for a power down
+} taa3040_power_event_t;
+
+/**
+ * @brief Detector state of one channel.
+ */
+typedef struct {
+    uint32_t energy;                ///< Mean square of the last block
+    uint32_t floor;                 ///< Tracked noise floor
+    uint16_t idle_blocks;           ///< Consecutive idle blocks, saturates
+    uint16_t rising_blocks;         ///< Consecutive blocks above off_ratio while inactive, saturates
+    bool active;                    ///< Activity detected, with hysteresis
+    uint32_t powered_blocks;        ///< Blocks the channel spent powered
+} taa3040_power_channel_t;
+
+/**
+ * @brief Power manager of one device.
+ */
+typedef struct {
+    taa3040_power_config_t config;
+    taa3040_power_channel_t channels[TAA3040_NUM_CHANNELS];
+    uint8_t enabled;                        ///< IN_CHANNEL_EN as last written
+    uint32_t blocks;                        ///< Blocks processed
+    taa3040_power_event_t* events;          ///< Caller supplied ring storage (may be NULL)
+    uint32_t event_capacity;                ///< Events the ring holds
+    uint32_t events_written;                ///< Events written since init, the newest at (events_written - 1) % event_capacity
+} taa3040_power_manager_t;
+
+/**
+ * @brief Reasonable defaults: channel 1 as sentinel, the other dynamic mode channels managed,
+ *        on at 12 dB and off at 6 dB above the floor, powered down after hang_blocks idle blocks.
+ *
+ * @param[out] config Configuration to fill.
+ * @param[in] dynamic_channels dynamic_mode_channels of the system configuration.
+ * @param[in] hang_blocks Idle blocks before power down.
+ */
+void taa3040_power_default_config(taa3040_power_config_t *const config, const taa3040_dynamic_mode_channels_t dynamic_channels,
+                                  const uint16_t hang_blocks);
+
+/**
+ * @brief Initialize a power manager.
+ *
+ * @param[out] pm Manager to initialize.
+ * @param[in] config Tuning, copied.
+ * @param[in] enabled IN_CHANNEL_EN the device is currently running with.
+ * @param[in] events Ring of events, must outlive the manager (may be NULL).
+ * @param[in] capacity Events in the ring.
+ * @return true if successful, false if the configuration is inconsistent.
+ */
+bool taa3040_power_init(taa3040_power_manager_t *const pm, const taa3040_power_config_t *const config, const uint8_t enabled,
+                        taa3040_power_event_t *const events, const uint32_t capacity);
+
+/**
+ * @brief Run the detectors over one block of capture and power channels up or down.
+ *
+ * Samples are interleaved frames of left justified 32 bit words, channel n at position n
+ * of each frame, as they come off a TDM bus with the channels in slot order. Channels at
+ * or beyond stride are treated as silent. Powered down channels are not measured.
+ *
+ * @param[in,out] pm Power manager.
+ * @param[in] dev Device handle.
+ * @param[in] samples Interleaved capture.
+ * @param[in] frames Frames in samples.
+ * @param[in] stride Words per frame.
+ * @param[in] timestamp Caller time of the block, recorded in events.
+ * @return true if successful, false if the enables could not be written.
+ */
+bool taa3040_power_process(taa3040_power_manager_t *const pm, const taa3040_t *const dev, const int32_t *const samples,
+                           const uint32_t frames, const uint8_t stride, const uint32_t timestamp);
+
+/**
+ * @brief Fraction of the blocks a channel spent powered.
+ *
+ * @param[in] pm Power manager.
+ * @param[in] ch Channel index (0 - 7).
+ * @return Duty cycle in Q16, 65536 for always powered.
+ */
+uint32_t taa3040_power_duty(const taa3040_power_manager_t *const pm, const uint8_t ch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_POWER_H */
@@ -0,0 +1,124 @@
+/**
+ * @file taa3040_preset.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Preset bank with precomputed transitions between configurations
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_PRESET_H
+#define TAA3040_PRESET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "taa3040_types.h"
+#include "taa3040_image.h"
+#include "taa3040_blob.h"
+
+/*
+ * Every preset is kept as a register image. When a preset is added, the register runs
+ * that differ from every other preset are computed once, in both directions, and stored
+ * in a caller supplied buffer. Switching presets then only replays the stored script,
+ * in the same [page][reg][length][data] format as a blob payload.
+ */
+
+#ifndef TAA3040_PRESET_MAX_PRESETS
+#define TAA3040_PRESET_MAX_PRESETS      (4)     ///< Presets a bank can hold, may be overridden at build time
+#endif
+
+#define TAA3040_PRESET_NONE             (0xFF)  ///< No preset is known to be programmed
+
+/**
+ * @brief Registers that are unchanged but lie between two changed registers closer than this
+ * are rewritten instead of starting a new run, since a new transfer costs more bytes on the bus.
+ */
+#define TAA3040_PRESET_MERGE_GAP        (2)
+
+/** @brief Upper bound on the size of one transition script */
+#define TAA3040_PRESET_SCRIPT_MAX_SIZE  ((TAA3040_BLOB_RUN_HEADER + 1) * TAA3040_IMAGE_SIZE)
+
+/**
+ * @brief A bank of presets and the transition scripts between them.
+ */
+typedef struct {
+    uint8_t images[TAA3040_PRESET_MAX_PRESETS][TAA3040_IMAGE_SIZE];         ///< Register image of each preset
+    uint16_t script_offset[TAA3040_PRESET_MAX_PRESETS][TAA3040_PRESET_MAX_PRESETS]; ///< Start of the script [from][to] in storage
+    uint16_t script_length[TAA3040_PRESET_MAX_PRESETS][TAA3040_PRESET_MAX_PRESETS]; ///< Bytes in the script [from][to]
+    uint8_t* storage;           ///< Buffer holding every script
+    uint16_t storage_capacity;  ///< Size of storage
+    uint16_t storage_used;      ///< Bytes of storage in use
+    uint8_t count;              ///< Number of presets added
+    uint8_t current;            ///< Preset last programmed into the device, or TAA3040_PRESET_NONE
+} taa3040_preset_bank_t;
+
+/**
+ * @brief Initialize an empty preset bank.
+ *
+ * A pair of very different presets needs at most TAA3040_PRESET_SCRIPT_MAX_SIZE bytes in each
+ * direction, but typical scene changes only touch a few dozen registers.
+ *
+ * @param[out] bank Bank to initialize.
+ * @param[in] storage Buffer for the transition scripts, must outlive the bank.
+ * @param[in] capacity Size of storage.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_preset_bank_init(taa3040_preset_bank_t *const bank, uint8_t *const storage, const uint16_t capacity);
+
+/**
+ * @brief Add a preset and compute its transitions to and from every existing preset.
+ *
+ * @param[in,out] bank Preset bank.
+ * @param[in] config Configuration of the preset.
+ * @param[out] index Index assigned to the preset (may be NULL).
+ * @return true if successful, false if the bank or its script storage is full.
+ */
+bool taa3040_preset_add(taa3040_preset_bank_t *const bank, const taa3040_config_t *const config, uint8_t *const index);
+
+/**
+ * @brief Program every register of a preset, regardless of the current device state.
+ *
+ * Use this once after a reset or whenever the device contents are unknown.
+ *
+ * @param[in] dev Device handle.
+ * @param[in,out] bank Preset bank.
+ * @param[in] index Preset to program.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_preset_apply(const taa3040_t *const dev, taa3040_preset_bank_t *const bank, const uint8_t index);
+
+/**
+ * @brief Switch from the current preset to another by replaying the stored transition.
+ *
+ * Falls back to taa3040_preset_apply if no preset is known to be programmed.
+ *
+ * @param[in] dev Device handle.
+ * @param[in,out] bank Preset bank.
+ * @param[in] index Preset to switch to.
+ * @return true if successful, false otherwise. On failure the current preset becomes unknown.
+ */
+bool taa3040_preset_switch(const taa3040_t *const dev, taa3040_preset_bank_t *const bank, const uint8_t index);
+
+/**
+ * @brief Size of the transition script between two presets.
+ *
+ * @param[in] bank Preset bank.
+ * @param[in] from Preset switched from.
+ * @param[in] to Preset switched to.
+ * @return Bytes of register runs replayed by the switch, 0 if the presets are identical or invalid.
+ */
+uint16_t taa3040_preset_script_length(const taa3040_preset_bank_t *const bank, const uint8_t from, const uint8_t to);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_PRESET_H */
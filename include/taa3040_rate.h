@@ -0,0 +1,122 @@
+/**
+ * @file taa3040_rate.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Decoding and tracking of the clocking detected on the ASI bus
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_RATE_H
+#define TAA3040_RATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * As a slave the device measures FSYNC against its internal clock and reports the
+ * detected rate range and the BCLK cycles per frame in ASI_STATUS. Both read as invalid
+ * while the bus is stopped or unsupported.
+ *
+ * The rate only distinguishes ranges, 44.1 kHz and 48 kHz read the same; which family
+ * the host runs is known to the host, see TAA3040_SAMPLE_RATE_HZ.
+ *
+ * The watcher polls ASI_STATUS and reports a change once the new clocking has been read
+ * the same a number of polls in a row, so the host pipeline can resize its buffers and
+ * change its deinterleaving when upstream changes rate, instead of capturing garbage.
+ */
+
+/**
+ * @brief Clocking detected on the ASI bus.
+ */
+typedef struct {
+    bool valid;                             ///< Both the rate and the ratio were detected
+    taa3040_sampling_rate_t sample_rate;    ///< Detected FSYNC rate range
+    uint16_t bclk_ratio;                    ///< BCLK cycles per frame, 0 when not detected
+    uint8_t status;                         ///< ASI_STATUS as read
+} taa3040_detected_clock_t;
+
+/**
+ * @brief Decode ASI_STATUS.
+ *
+ * @param[in] asi_status ASI_STATUS register value.
+ * @param[out] clock Decoded clocking.
+ * @return true if both the rate and the ratio were detected, false otherwise.
+ */
+bool taa3040_rate_decode(const uint8_t asi_status, taa3040_detected_clock_t *const clock);
+
+/**
+ * @brief Read and decode the detected clocking.
+ *
+ * @param[in] dev Device handle.
+ * @param[out] clock Decoded clocking.
+ * @return true if successful (the clocking may still be invalid), false otherwise.
+ */
+bool taa3040_rate_read(const taa3040_t *const dev, taa3040_detected_clock_t *const clock);
+
+/**
+ * @brief Called when the detected clocking changes.
+ *
+ * @param[in] context Context given to the watcher.
+ * @param[in] previous Clocking reported before, invalid on the first report.
+ * @param[in] current Clocking now detected.
+ */
+typedef void (*taa3040_rate_change_fn)(void *const context, const taa3040_detected_clock_t *const previous,
+                                       const taa3040_detected_clock_t *const current);
+
+/**
+ * @brief Watches the detected clocking for changes.
+ */
+typedef struct {
+    taa3040_detected_clock_t current;   ///< Clocking last reported
+    uint8_t candidate;                  ///< ASI_STATUS differing from current, waiting to be confirmed
+    uint8_t confirmations;              ///< Consecutive polls candidate was read
+    uint8_t stable_polls;               ///< Polls a new clocking must be read before it is reported
+    uint32_t changes;                   ///< Changes reported
+    taa3040_rate_change_fn on_change;   ///< Change callback (may be NULL)
+    void* context;                      ///< Passed to on_change
+} taa3040_rate_watch_t;
+
+/**
+ * @brief Initialize a watcher, starting from invalid clocking.
+ *
+ * @param[out] watch Watcher to initialize.
+ * @param[in] stable_polls Polls a new clocking must be read in a row, 0 or 1 reports at once.
+ * @param[in] on_change Change callback (may be NULL).
+ * @param[in] context Passed to on_change.
+ */
+void taa3040_rate_watch_init(taa3040_rate_watch_t *const watch, const uint8_t stable_polls,
+                             const taa3040_rate_change_fn on_change, void *const context);
+
+/**
+ * @brief Feed one ASI_STATUS read elsewhere to a watcher.
+ *
+ * @param[in,out] watch Watcher.
+ * @param[in] asi_status ASI_STATUS register value.
+ * @return true if a change was reported.
+ */
+bool taa3040_rate_watch_update(taa3040_rate_watch_t *const watch, const uint8_t asi_status);
+
+/**
+ * @brief Read ASI_STATUS and feed the watcher.
+ *
+ * @param[in,out] watch Watcher.
+ * @param[in] dev Device handle.
+ * @param[out] changed Whether a change was reported (may be NULL).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_rate_watch_poll(taa3040_rate_watch_t *const watch, const taa3040_t *const dev, bool *const changed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_RATE_H */
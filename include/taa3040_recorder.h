@@ -0,0 +1,174 @@
+/**
+ * @file taa3040_recorder.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Multichannel WAV / RF64 recording that never blocks the capture thread
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_RECORDER_H
+#define TAA3040_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "taa3040_types.h"
+
+/*
+ * The recorder splits recording between two threads. The capture thread only copies
+ * interleaved frames into a ring of fixed size blocks and never waits. When no block is
+ * free the frames are counted as dropped instead of stalling capture. The writer thread
+ * drains full blocks to a sink.
+ *
+ * The block storage and the header buffer come from the caller. They can be aligned and
+ * registered for direct I/O. Every write is a whole block at an offset that is a multiple
+ * of the block size past the header. The header is padded with a JUNK chunk so the audio
+ * starts on the alignment boundary. Only the last block of a file can be partial, and it
+ * is written padded to a full block. The sink is told the true length when it closes the
+ * file, so it can trim the padding.
+ *
+ * The sink performs the I/O: plain pwrite, O_DIRECT, io_uring with registered buffers, or
+ * an RTOS file system. An asynchronous sink only queues each block write. It reports
+ * completions in order with taa3040_recorder_complete, and only then is the block reused.
+ * A file's lengths are filled in and it is closed only once its last block completed. One
+ * file closes at a time, so a rotation waits on the drain for the previous file's writes.
+ *
+ * Files start as WAVE_FORMAT_EXTENSIBLE with 32 bit containers and unknown lengths, which
+ * most tools read while they grow. When a file is closed its lengths are filled in. A
+ * file past 4 GiB becomes RF64, whose ds64 chunk takes the space the JUNK chunk reserved.
+ * Recordings rotate to a new file once one reaches max_file_bytes.
+ */
+
+#define TAA3040_RECORDER_RIFF_BYTES     (12)    ///< RIFF chunk header and WAVE form type
+#define TAA3040_RECORDER_CHUNK_BYTES    (8)     ///< Chunk id and size ahead of every chunk payload
+#define TAA3040_RECORDER_DS64_BYTES     (28)    ///< ds64 payload: RIFF, data and sample sizes and an empty table
+#define TAA3040_RECORDER_FMT_BYTES      (40)    ///< WAVE_FORMAT_EXTENSIBLE fmt payload
+
+/** @brief Smallest header buffer: RIFF, the JUNK / ds64 and fmt chunks, the aligning JUNK and the data chunk headers */
+#define TAA3040_RECORDER_MIN_HEADER     (TAA3040_RECORDER_RIFF_BYTES + TAA3040_RECORDER_CHUNK_BYTES + TAA3040_RECORDER_DS64_BYTES \
+                                         + TAA3040_RECORDER_CHUNK_BYTES + TAA3040_RECORDER_FMT_BYTES + 2 * TAA3040_RECORDER_CHUNK_BYTES)
+
+/**
+ * @brief Performs the file I/O of a recorder, from the writer thread.
+ */
+typedef struct {
+    /** @brief Create file index of the recording, NULL on failure */
+    void* (*open)(void *const context, const uint32_t index);
+    /** @brief Write at offset; the header (offset 0) must be consumed before returning */
+    bool (*write)(void *const context, void *const file, const uint64_t offset, const void *const data, const size_t length);
+    /** @brief Close a file once its block writes completed, after its final header write, trimming it to length */
+    bool (*close)(void *const context, void *const file, const uint64_t length);
+    bool async;         ///< Block writes complete later, reported with taa3040_recorder_complete
+    void* context;      ///< Passed to every call
+} taa3040_recorder_sink_t;
+
+/**
+ * @brief Recording format and storage.
+ */
+typedef struct {
+    uint8_t channels;           ///< Words per frame (1 - 8)
+    uint8_t valid_bits;         ///< Significant bits of each 32 bit word, e.g. 24
+    uint32_t sample_rate;       ///< Frames per second
+    uint8_t* blocks;            ///< Ring storage of block_count * block_bytes bytes
+    uint32_t block_bytes;       ///< Bytes per block, a multiple of the frame size and the I/O alignment
+    uint32_t block_count;       ///< Blocks in the ring, at least 2
+    uint8_t* header;            ///< Header buffer, written at the start of every file
+    uint32_t header_bytes;      ///< Header size, the I/O alignment (at least TAA3040_RECORDER_MIN_HEADER)
+    uint64_t max_file_bytes;    ///< Audio bytes per file before rotating, 0 never rotates
+} taa3040_recorder_config_t;
+
+/**
+ * @brief Recorder state shared by the capture and writer threads.
+ */
+typedef struct {
+    taa3040_recorder_config_t config;
+    taa3040_recorder_sink_t sink;
+    uint32_t fill;                  ///< Bytes in the block being filled (capture thread)
+    volatile uint32_t filled;       ///< Blocks handed to the writer (capture thread)
+    uint32_t flush_end;             ///< Blocks handed over when the current file ends
+    volatile uint32_t flush_bytes;  ///< Bytes in the last block of the file, 0 when no flush is pending
+    uint32_t submitted;             ///< Blocks passed to the sink (writer thread)
+    volatile uint32_t completed;    ///< Blocks written and free again (writer thread)
+    volatile uint64_t dropped;      ///< Frames dropped for want of a free block (capture thread)
+    void* file;                     ///< File being written, NULL before the first block
+    void* closing;                  ///< File waiting for its last block to complete before it is closed
+    uint64_t closing_bytes;         ///< Audio bytes of the closing file
+    uint32_t closing_end;           ///< Blocks submitted when the closing file ended
+    uint32_t file_index;            ///< Index of the next file to open
+    uint64_t file_bytes;            ///< Audio bytes written to the current file
+    bool failed;                    ///< The sink failed, the recording stopped
+} taa3040_recorder_t;
+
+/**
+ * @brief Initialize a recorder.
+ *
+ * @param[out] rec Recorder to initialize.
+ * @param[in] config Format and storage, copied.
+ * @param[in] sink File I/O, copied.
+ * @return true if successful, false if the configuration is inconsistent.
+ */
+bool taa3040_recorder_init(taa3040_recorder_t *const rec, const taa3040_recorder_config_t *const config,
+                           const taa3040_recorder_sink_t *const sink);
+
+/**
+ * @brief Queue captured frames, from the capture thread. Never blocks.
+ *
+ * @param[in,out] rec Recorder.
+ * @param[in] frames Interleaved frames of config.channels 32 bit words.
+ * @param[in] count Frames to queue.
+ * @return Frames queued, the rest were dropped.
+ */
+size_t taa3040_recorder_push(taa3040_recorder_t *const rec, const int32_t *const frames, const size_t count);
+
+/**
+ * @brief End the current file after the frames queued so far, from the capture thread.
+ *
+ * Hands the partly filled block to the writer, which closes the file once it wrote it.
+ * Frames pushed afterwards start a new file.
+ *
+ * @param[in,out] rec Recorder.
+ * @return true if successful, false if the previous flush was not drained yet.
+ */
+bool taa3040_recorder_flush(taa3040_recorder_t *const rec);
+
+/**
+ * @brief Write every block handed over so far, from the writer thread.
+ *
+ * @param[in,out] rec Recorder.
+ * @return true if successful, false once the sink failed.
+ */
+bool taa3040_recorder_drain(taa3040_recorder_t *const rec);
+
+/**
+ * @brief Report block writes of an asynchronous sink as done, in submission order.
+ *
+ * @param[in,out] rec Recorder.
+ * @param[in] blocks Blocks completed.
+ */
+void taa3040_recorder_complete(taa3040_recorder_t *const rec, const uint32_t blocks);
+
+/**
+ * @brief Drain, then fill in the lengths of the current file and close it, from the writer thread.
+ *
+ * Call after taa3040_recorder_flush once capture stopped. Frames not flushed are not written.
+ * With an asynchronous sink the file closes only once its writes completed: until then the
+ * call returns false with failed unset, and is repeated after reporting completions.
+ *
+ * @param[in,out] rec Recorder.
+ * @return true once the last file is closed, false while writes are outstanding or on failure.
+ */
+bool taa3040_recorder_finish(taa3040_recorder_t *const rec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_RECORDER_H */
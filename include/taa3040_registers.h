@@ -15,6 +15,8 @@
 
 #include <stdint.h>
 
+#define TAA3040_PAGE_SIZE                           (128) ///< Registers per page
+
 /* === Core Registers (Page 0) === */
 #define TAA3040_REG_PAGE_SELECT                     0x00 ///< Page selection register
 #define TAA3040_REG_SW_RESET                        0x01 ///< Software reset
@@ -89,17 +91,19 @@
 
 /* === Page 2: Biquad Filter Set 1 === */
 #define TAA3040_PAGE_BIQUAD_FILTER_1                0x02
-#define TAA3040_REG_BIQUAD_COEFF_BASE               0x00
+#define TAA3040_REG_BIQUAD_COEFF_BASE               0x08 ///< Coefficients fill 0x08-0x7F, after the page select register
 
 /* === Page 3: Biquad Filter Set 2 === */
 #define TAA3040_PAGE_BIQUAD_FILTER_2                0x03
 
 #define TAA3040_BIQUAD_COEFF_WORDS_PER_SECTION      (5) ///< b0, b1, b2, a1, a2
 #define TAA3040_BIQUAD_CHANNEL_STRIDE               (5)
+#define TAA3040_BIQUAD_SECTION_BYTES                (TAA3040_BIQUAD_COEFF_WORDS_PER_SECTION * 4)
+#define TAA3040_BIQUADS_PER_PAGE                    (6)
 
 /* === Page 4: Mixer Matrix === */
 #define TAA3040_PAGE_MIXER_CONTROL                  0x04
-#define TAA3040_REG_MIXER_MATRIX_BASE               0x00
+#define TAA3040_REG_MIXER_MATRIX_BASE               0x08 ///< Matrix fills 0x08-0x47, up to the IIR coefficients
 
 /* === Mixer Matrix Helper Constants === */
 #define TAA3040_MIXER_MATRIX_ENTRIES_PER_CHANNEL    (8)
@@ -115,6 +119,26 @@
 
 #define TAA3040_IIR_COEFF_WORDS_PER_SECTION         (3)
 
+/* === Contiguous Register Blocks (Page 0) === */
+#define TAA3040_BLOCK_ASI_START                     TAA3040_REG_ASI_CONFIG0         ///< ASI format, slots, master mode and clock source
+#define TAA3040_BLOCK_ASI_END                       TAA3040_REG_CLOCK_SOURCE
+#define TAA3040_BLOCK_ASI_LENGTH                    (TAA3040_BLOCK_ASI_END - TAA3040_BLOCK_ASI_START + 1)
+
+#define TAA3040_BLOCK_GPIO_START                    TAA3040_REG_GPIO1_CONFIG        ///< GPIO, GPO, GPI and interrupt configuration
+#define TAA3040_BLOCK_GPIO_END                      TAA3040_REG_INTERRUPT_LATCH
+#define TAA3040_BLOCK_GPIO_LENGTH                   (TAA3040_BLOCK_GPIO_END - TAA3040_BLOCK_GPIO_START + 1)
+
+#define TAA3040_BLOCK_CHANNEL_START                 TAA3040_REG_CHANNEL_CONFIG_BASE ///< All eight 5-register channel blocks
+#define TAA3040_BLOCK_CHANNEL_LENGTH                (8 * TAA3040_CHANNEL_REGISTER_ENTRIES)
+#define TAA3040_BLOCK_CHANNEL_END                   (TAA3040_BLOCK_CHANNEL_START + TAA3040_BLOCK_CHANNEL_LENGTH - 1)
+
+#define TAA3040_BLOCK_DSP_START                     TAA3040_REG_DSP_CONFIG0         ///< DSP, AGC, channel enables and power
+#define TAA3040_BLOCK_DSP_END                       TAA3040_REG_POWER_CONFIG
+#define TAA3040_BLOCK_DSP_LENGTH                    (TAA3040_BLOCK_DSP_END - TAA3040_BLOCK_DSP_START + 1)
+
+#define TAA3040_BLOCK_MIXER_LENGTH                  (TAA3040_MIXER_CHANNEL_STRIDE * 8)  ///< Whole mixer matrix (Page 4)
+#define TAA3040_BLOCK_IIR_LENGTH                    (TAA3040_IIR_COEFF_WORDS_PER_SECTION * 4) ///< n0, n1, d1 (Page 4)
+
 /* === Bit Masks and Field Definitions === */
 
 /* --- SW_RESET (0x01) --- */
@@ -124,7 +148,7 @@
 #define TAA3040_SLEEP_DISABLE_SHIFT                 (0x0)
 #define TAA3040_SLEEP_DISABLE_MASK                  (0x01 << TAA3040_SLEEP_DISABLE_SHIFT)
 #define TAA3040_I2C_BROADCAST_SHIFT                 (0x2)
-#define TAA3040_I2C_BROADCAST_MASK                  (0x01 << TAA3040_SLEEP_ENABLE_SHIFT)
+#define TAA3040_I2C_BROADCAST_MASK                  (0x01 << TAA3040_I2C_BROADCAST_SHIFT)
 #define TAA3040_VREF_QCHRG_SHIFT                    (0x3)
 #define TAA3040_VREF_QCHRG_MASK                     (0x3 << TAA3040_VREF_QCHRG_SHIFT)
 #define TAA3040_AREG_SELECT_SHIFT                   (0x7)
@@ -194,16 +218,17 @@
 #define TAA3040_FSYNC_RATE_MASK                     (0xF << TAA3040_FSYNC_RATE_SHIFT)
 
 /* --- ASI Status (0x15) --- */
-#define TAA3040_FSYNC_RATIO_STATUS_SHIFT            (4)
+#define TAA3040_FSYNC_RATIO_STATUS_SHIFT            (0)
 #define TAA3040_FSYNC_RATIO_STATUS_MASK             (0xF << TAA3040_FSYNC_RATIO_STATUS_SHIFT)
-#define TAA3040_FSYNC_RATE_STATUS_SHIFT             (0)
-#define TAA3040_FSYNC_RATE_STATUS_MASK              (0xF << TAA3040_FSYNC_RATE_SHIFT)
+#define TAA3040_FSYNC_RATE_STATUS_SHIFT             (4)
+#define TAA3040_FSYNC_RATE_STATUS_MASK              (0xF << TAA3040_FSYNC_RATE_STATUS_SHIFT)
+#define TAA3040_FSYNC_STATUS_INVALID                (0xF)  ///< Rate or ratio not detected
 
 /* --- Clock Source (0x16) --- */
 #define TAA3040_MCLK_RATIO_SEL_SHIFT                (3)
 #define TAA3040_MCLK_RATIO_SEL_MASK                 (0x7 <<  TAA3040_MCLK_RATIO_SEL_SHIFT)
 #define TAA3040_MCLK_FREQ_SEL_SHIFT                 (6)
-#define TAA3040_MCLK_FREQ_SEL_MASK                  (0x1 << TAA3040_MCLK_FREQ_SELECT_SHIFT)
+#define TAA3040_MCLK_FREQ_SEL_MASK                  (0x1 << TAA3040_MCLK_FREQ_SEL_SHIFT)
 #define TAA3040_SLAVE_CLOCK_SOURCE_SHIFT            (7)
 #define TAA3040_SLAVE_CLOCK_SOURCE_MASK             (0x1 << TAA3040_SLAVE_CLOCK_SOURCE_SHIFT)
 
@@ -308,10 +333,13 @@
 // Config 1
 #define TAA3040_CHANNEL_GAIN_SHIFT                  (0x2)
 #define TAA3040_CHANNEL_GAIN_MASK                   (0x3F << TAA3040_CHANNEL_GAIN_SHIFT)
+#define TAA3040_CHANNEL_GAIN_MAX                    (42)    ///< Largest gain, 1 dB per step
 
 // Config 2
 #define TAA3040_CHANNEL_VOLUME_SHIFT                (0x0)
 #define TAA3040_CHANNEL_VOLUME_MASK                 (0xFF << TAA3040_CHANNEL_VOLUME_SHIFT)
+#define TAA3040_CHANNEL_VOLUME_MUTE                 (0)     ///< Muted
+#define TAA3040_CHANNEL_VOLUME_0DB                  (201)   ///< 0 dB, 0.5 dB per step from -100 dB at 1 to +27 dB at 255
 
 // Config 3
 #define TAA3040_CHANNEL_GAIN_CAL_SHIFT              (0x4)
@@ -356,7 +384,7 @@
 #define TAA3040_CHANNEL4_ENABLE_MASK                (0x1 << TAA3040_CHANNEL4_ENABLE_SHIFT)
 #define TAA3040_CHANNEL5_ENABLE_SHIFT               (0x3)
 #define TAA3040_CHANNEL5_ENABLE_MASK                (0x1 << TAA3040_CHANNEL5_ENABLE_SHIFT)
-#define TAA3040_CHANNEL6_ENABLE_SHIFT               (0x3)
+#define TAA3040_CHANNEL6_ENABLE_SHIFT               (0x2)
 #define TAA3040_CHANNEL6_ENABLE_MASK                (0x1 << TAA3040_CHANNEL6_ENABLE_SHIFT)
 #define TAA3040_CHANNEL7_ENABLE_SHIFT               (0x1)
 #define TAA3040_CHANNEL7_ENABLE_MASK                (0x1 << TAA3040_CHANNEL7_ENABLE_SHIFT)
@@ -374,7 +402,7 @@
 #define TAA3040_ASI_CHANNEL4_ENABLE_MASK            (0x1 << TAA3040_ASI_CHANNEL4_ENABLE_SHIFT)
 #define TAA3040_ASI_CHANNEL5_ENABLE_SHIFT           (0x3)
 #define TAA3040_ASI_CHANNEL5_ENABLE_MASK            (0x1 << TAA3040_ASI_CHANNEL5_ENABLE_SHIFT)
-#define TAA3040_ASI_CHANNEL6_ENABLE_SHIFT           (0x3)
+#define TAA3040_ASI_CHANNEL6_ENABLE_SHIFT           (0x2)
 #define TAA3040_ASI_CHANNEL6_ENABLE_MASK            (0x1 << TAA3040_ASI_CHANNEL6_ENABLE_SHIFT)
 #define TAA3040_ASI_CHANNEL7_ENABLE_SHIFT           (0x1)
 #define TAA3040_ASI_CHANNEL7_ENABLE_MASK            (0x1 << TAA3040_ASI_CHANNEL7_ENABLE_SHIFT)
@@ -385,7 +413,7 @@
 #define TAA3040_DYNAMIC_POWER_SHIFT                 (0x4)
 #define TAA3040_DYNAMIC_POWER_MASK                  (0x1 << TAA3040_DYNAMIC_POWER_SHIFT)
 #define TAA3040_DYNAMIC_POWER_CHANNELS_SHIFT        (0x2)
-#define TAA3040_DYNAMIC_POWER_CHANNELS_MASK         (0x3 << TAA3040_DYNAMIC_POWER_SHIFT)
+#define TAA3040_DYNAMIC_POWER_CHANNELS_MASK         (0x3 << TAA3040_DYNAMIC_POWER_CHANNELS_SHIFT)
 #define TAA3040_PLL_ENABLE_SHIFT                    (0x5)
 #define TAA3040_PLL_ENABLE_MASK                     (0x1 << TAA3040_PLL_ENABLE_SHIFT)
 #define TAA3040_ADC_ENABLE_SHIFT                    (0x6)
@@ -404,7 +432,7 @@
 #define TAA3040_CHANNEL4_STATUS_MASK                (0x1 << TAA3040_CHANNEL4_STATUS_SHIFT)
 #define TAA3040_CHANNEL5_STATUS_SHIFT               (0x3)
 #define TAA3040_CHANNEL5_STATUS_MASK                (0x1 << TAA3040_CHANNEL5_STATUS_SHIFT)
-#define TAA3040_CHANNEL6_STATUS_SHIFT               (0x3)
+#define TAA3040_CHANNEL6_STATUS_SHIFT               (0x2)
 #define TAA3040_CHANNEL6_STATUS_MASK                (0x1 << TAA3040_CHANNEL6_STATUS_SHIFT)
 #define TAA3040_CHANNEL7_STATUS_SHIFT               (0x1)
 #define TAA3040_CHANNEL7_STATUS_MASK                (0x1 << TAA3040_CHANNEL7_STATUS_SHIFT)
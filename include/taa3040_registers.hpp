@@ -0,0 +1,476 @@
+/**
+ * @file taa3040_registers.hpp
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Header-only C++ typed register access for the TAA3040
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_REGISTERS_HPP
+#define TAA3040_REGISTERS_HPP
+
+#include <stdint.h>
+#include "taa3040.h"
+#include "taa3040_registers.h"
+
+/*
+ * Registers and fields are types built from the definitions in taa3040_registers.h, so
+ * their page, address, mask and access are known at compile time:
+ *
+ *   namespace taa = crablabs::taa3040;
+ *   taa::page_session<0> page0(&dev);
+ *   page0.modify(taa::regs::asi_format::set<TAA3040_ASI_MODE_I2S>(),
+ *                taa::regs::asi_word_length::set<TAA3040_ASI_WORD_LENGTH_32BITS>());
+ *
+ * Values are range checked, fields are checked to be on the session's page, writable and
+ * in one register, and every field passed to one call is merged into a single transfer.
+ * Writes that cover every bit of a register skip the read. Only C++11 is required and the
+ * C API is used underneath, so nothing changes for C builds.
+ */
+
+namespace crablabs
+{
+namespace taa3040   // nested, as the C device struct already owns the global name
+{
+
+/** @brief Whether a register can be written */
+enum class access : uint8_t
+{
+    read_write,
+    read_only
+};
+
+/**
+ * @brief A register, identified by its page and address.
+ */
+template <uint8_t Page, uint8_t Address, access Access = access::read_write>
+struct reg
+{
+    static_assert(Address != TAA3040_REG_PAGE_SELECT, "the page select register is owned by page_session");
+    static_assert(Address < TAA3040_PAGE_SIZE, "register address is beyond the end of the page");
+
+    static constexpr uint8_t page = Page;
+    static constexpr uint8_t address = Address;
+    static constexpr bool writable = Access == access::read_write;
+};
+
+template <typename Field>
+struct field_value;
+
+/**
+ * @brief A bit field of a register, with the shift and in-place mask used in taa3040_registers.h.
+ */
+template <typename Reg, uint8_t Shift, uint8_t Mask>
+struct field
+{
+    static_assert(Mask != 0, "field has no bits");
+    static_assert(Shift < 8 && ((Mask >> Shift) << Shift) == Mask, "mask must start at the field shift");
+
+    typedef Reg register_type;
+    static constexpr uint8_t shift = Shift;
+    static constexpr uint8_t mask = Mask;
+    static constexpr uint8_t max = Mask >> Shift;   ///< Largest value the field holds
+
+    /** @brief A compile-time value, rejected if it does not fit */
+    template <uint8_t Value>
+    static constexpr field_value<field> set()
+    {
+        static_assert(Value <= max, "value does not fit in the field");
+        return field_value<field>(static_cast<uint8_t>(Value << Shift));
+    }
+
+    /** @brief A run-time value, truncated to the field width */
+    static constexpr field_value<field> of(const uint8_t value)
+    {
+        return field_value<field>(static_cast<uint8_t>((value << Shift) & Mask));
+    }
+
+    /** @brief Extract the field from a register value */
+    static constexpr uint8_t get(const uint8_t register_value)
+    {
+        return static_cast<uint8_t>((register_value & Mask) >> Shift);
+    }
+};
+
+/**
+ * @brief A value for a field, already shifted into place.
+ */
+template <typename Field>
+struct field_value
+{
+    typedef Field field_type;
+    uint8_t bits;
+
+    constexpr explicit field_value(const uint8_t b) : bits(b) {}
+};
+
+/** @brief A single bit field */
+template <typename Reg, uint8_t Shift>
+using flag = field<Reg, Shift, static_cast<uint8_t>(1u << Shift)>;
+
+namespace detail
+{
+
+constexpr unsigned bit_count(const uint8_t v)
+{
+    return v == 0? 0: (v & 1u) + bit_count(static_cast<uint8_t>(v >> 1));
+}
+
+template <typename... Fields>
+struct fields;
+
+template <>
+struct fields<>
+{
+    static constexpr uint8_t mask = 0;
+    static constexpr unsigned bit_count = 0;
+    template <typename Reg> static constexpr bool same_register() { return true; }
+};
+
+template <typename First, typename... Rest>
+struct fields<First, Rest...>
+{
+    static constexpr uint8_t mask = First::mask | fields<Rest...>::mask;
+    static constexpr unsigned bit_count = detail::bit_count(First::mask) + fields<Rest...>::bit_count;
+
+    template <typename Reg>
+    static constexpr bool same_register()
+    {
+        return First::register_type::address == Reg::address && First::register_type::page == Reg::page
+            && fields<Rest...>::template same_register<Reg>();
+    }
+};
+
+constexpr uint8_t combine() { return 0; }
+
+template <typename First, typename... Rest>
+constexpr uint8_t combine(const First first, const Rest... rest)
+{
+    return static_cast<uint8_t>(first.bits | combine(rest...));
+}
+
+} // namespace detail
+
+/**
+ * @brief Register access on one page.
+ *
+ * Selects the page on construction and returns to page 0 on destruction, also after a
+ * failed access or a failed select. Page 0 sessions never touch the page select register,
+ * as every driver call already leaves the device there.
+ */
+template <uint8_t Page>
+class page_session
+{
+public:
+    explicit page_session(const taa3040_t *const dev)
+        : dev_(dev), selected_(dev != nullptr && Page != 0), ok_(dev != nullptr && (Page == 0 || taa3040_set_page(dev, Page)))
+    {
+    }
+
+    ~page_session()
+    {
+        if (selected_)
+            taa3040_set_page(dev_, 0);
+    }
+
+    page_session(const page_session&) = delete;
+    page_session& operator=(const page_session&) = delete;
+
+    /** @brief If the page was selected and every access so far succeeded */
+    bool ok() const { return ok_; }
+
+    /** @brief Read a whole register */
+    template <typename Reg>
+    bool read(uint8_t &value)
+    {
+        static_assert(Reg::page == Page, "register is on a different page than the session");
+        return step(taa3040_read_registers(dev_, Reg::address, &value, 1));
+    }
+
+    /** @brief Read one field */
+    template <typename Field>
+    bool read_field(uint8_t &value)
+    {
+        uint8_t raw = 0;
+        if (!read<typename Field::register_type>(raw))
+            return false;
+        value = Field::get(raw);
+        return true;
+    }
+
+    /** @brief Write a whole register */
+    template <typename Reg>
+    bool write(const uint8_t value)
+    {
+        static_assert(Reg::page == Page, "register is on a different page than the session");
+        static_assert(Reg::writable, "register is read only");
+        return step(taa3040_write_registers(dev_, Reg::address, &value, 1));
+    }
+
+    /**
+     * @brief Set fields of one register and clear every other bit, without reading it.
+     */
+    template <typename First, typename... Rest>
+    bool assign(const field_value<First> first, const field_value<Rest>... rest)
+    {
+        check_fields<First, Rest...>();
+        return write<typename First::register_type>(detail::combine(first, rest...));
+    }
+
+    /**
+     * @brief Set fields of one register and keep every other bit.
+     *
+     * All fields are merged into one write, preceded by a single read unless they cover the whole register.
+     */
+    template <typename First, typename... Rest>
+    bool modify(const field_value<First> first, const field_value<Rest>... rest)
+    {
+        typedef typename First::register_type register_type;
+        check_fields<First, Rest...>();
+
+        const uint8_t bits = detail::combine(first, rest...);
+        const uint8_t mask = detail::fields<First, Rest...>::mask;
+        if (mask == 0xFF)
+            return write<register_type>(bits);
+
+        uint8_t value = 0;
+        if (!read<register_type>(value))
+            return false;
+        return write<register_type>(static_cast<uint8_t>((value & ~mask) | bits));
+    }
+
+private:
+    template <typename First, typename... Rest>
+    static constexpr bool check_fields()
+    {
+        static_assert(First::register_type::page == Page, "field is on a different page than the session");
+        static_assert(First::register_type::writable, "field is in a read only register");
+        static_assert(detail::fields<Rest...>::template same_register<typename First::register_type>(),
+            "fields written together must be in the same register");
+        static_assert(detail::fields<First, Rest...>::bit_count == detail::bit_count(detail::fields<First, Rest...>::mask),
+            "fields written together must not overlap");
+        return true;
+    }
+
+    bool step(const bool result)
+    {
+        ok_ = ok_ && result;
+        return result;
+    }
+
+    const taa3040_t *dev_;
+    bool selected_;     // Page select was sent, the device may be off page 0
+    bool ok_;
+};
+
+/** @brief Set fields of one register in a single call, including the page switch when needed */
+template <typename First, typename... Rest>
+inline bool modify(const taa3040_t *const dev, const field_value<First> first, const field_value<Rest>... rest)
+{
+    page_session<First::register_type::page> session(dev);
+    return session.ok() && session.modify(first, rest...);
+}
+
+/** @brief Read one field in a single call, including the page switch when needed */
+template <typename Field>
+inline bool read_field(const taa3040_t *const dev, uint8_t &value)
+{
+    page_session<Field::register_type::page> session(dev);
+    return session.ok() && session.template read_field<Field>(value);
+}
+
+/* === Register Map === */
+namespace regs
+{
+
+/* --- Power and Sleep --- */
+typedef reg<0, TAA3040_REG_SLEEP_CFG> sleep_cfg;
+typedef field<sleep_cfg, TAA3040_SLEEP_DISABLE_SHIFT, TAA3040_SLEEP_DISABLE_MASK> sleep_disable;
+typedef field<sleep_cfg, TAA3040_I2C_BROADCAST_SHIFT, TAA3040_I2C_BROADCAST_MASK> i2c_broadcast;
+typedef field<sleep_cfg, TAA3040_VREF_QCHRG_SHIFT, TAA3040_VREF_QCHRG_MASK> vref_qchrg;
+typedef field<sleep_cfg, TAA3040_AREG_SELECT_SHIFT, TAA3040_AREG_SELECT_MASK> areg_select;
+
+typedef reg<0, TAA3040_REG_SHUTDOWN_CFG> shutdown_cfg;
+typedef field<shutdown_cfg, TAA3040_DREG_KA_TIME_SHIFT, TAA3040_DREG_KA_TIME_MASK> dreg_ka_time;
+typedef field<shutdown_cfg, TAA3040_SHDNZ_CFG_SHIFT, TAA3040_SHDNZ_CFG_MASK> shdnz_cfg;
+typedef field<shutdown_cfg, TAA3040_INCAP_QCHG_SHIFT, TAA3040_INCAP_QCHG_MASK> incap_qchg;
+
+typedef reg<0, TAA3040_REG_POWER_CONFIG> power_config;
+typedef field<power_config, TAA3040_DYNAMIC_POWER_CHANNELS_SHIFT, TAA3040_DYNAMIC_POWER_CHANNELS_MASK> dynamic_power_channels;
+typedef field<power_config, TAA3040_DYNAMIC_POWER_SHIFT, TAA3040_DYNAMIC_POWER_MASK> dynamic_power;
+typedef field<power_config, TAA3040_PLL_ENABLE_SHIFT, TAA3040_PLL_ENABLE_MASK> pll_enable;
+typedef field<power_config, TAA3040_ADC_ENABLE_SHIFT, TAA3040_ADC_ENABLE_MASK> adc_enable;
+typedef field<power_config, TAA3040_MIC_BIAS_ENABLE_SHIFT, TAA3040_MIC_BIAS_ENABLE_MASK> mic_bias_enable;
+
+typedef reg<0, TAA3040_REG_BIAS_CONFIG> bias_config;
+typedef field<bias_config, TAA3040_MIC_BIAS_SHIFT, TAA3040_MIC_BIAS_MASK> mic_bias;
+typedef field<bias_config, TAA3040_ADC_SCALE_SHIFT, TAA3040_ADC_SCALE_MASK> adc_scale;
+
+/* --- ASI --- */
+typedef reg<0, TAA3040_REG_ASI_CONFIG0> asi_config0;
+typedef field<asi_config0, TAA3040_ASI_FORMAT_SHIFT, TAA3040_ASI_FORMAT_MASK> asi_format;
+typedef field<asi_config0, TAA3040_ASI_WORD_LENGTH_SHIFT, TAA3040_ASI_WORD_LENGTH_MASK> asi_word_length;
+typedef field<asi_config0, TAA3040_FSYNC_POLARITY_SHIFT, TAA3040_FSYNC_POLARITY_MASK> fsync_polarity;
+typedef field<asi_config0, TAA3040_BCLK_POLARITY_SHIFT, TAA3040_BLCK_POLARITY_MASK> bclk_polarity;
+typedef field<asi_config0, TAA3040_TRANSMIT_EDGE_SHIFT, TAA3040_TRANSMIT_EDGE_MASK> transmit_edge;
+typedef field<asi_config0, TAA3040_TRANSMIT_FILL_SHIFT, TAA3040_TRANSMIT_FILL_MASK> transmit_fill;
+
+typedef reg<0, TAA3040_REG_ASI_CONFIG1> asi_config1;
+typedef field<asi_config1, TAA3040_TRANSMIT_LSB_SHIFT, TAA3040_TRANSMIT_LSB_MASK> transmit_lsb;
+typedef field<asi_config1, TAA3040_TRANSMIT_KEEPER_SHIFT, TAA3040_TRANSMIT_KEEPER_MASK> transmit_keeper;
+typedef field<asi_config1, TAA3040_TRANSMIT_OFFSET_SHIFT, TAA3040_TRANSMIT_OFFSET_MASK> transmit_offset;
+
+typedef reg<0, TAA3040_REG_ASI_CONFIG2> asi_config2;
+typedef field<asi_config2, TAA3040_ASI_DAISY_SHIFT, TAA3040_ASI_DAISY_MASK> asi_daisy;
+typedef field<asi_config2, TAA3040_ASI_ERROR_SHIFT, TAA3040_ASI_ERROR_MASK> asi_error;
+typedef field<asi_config2, TAA3040_ASI_ERROR_RECOVERY_SHIFT, TAA3040_ASI_ERROR_RECOVERY_MASK> asi_error_recovery;
+
+/** @brief ASI slot register of an output channel (0-7) */
+template <uint8_t Channel>
+struct asi_channel
+{
+    static_assert(Channel < TAA3040_NUM_CHANNELS, "channel out of range");
+    typedef reg<0, TAA3040_REG_ASI_CHANNEL_BASE + Channel> config;
+    typedef field<config, TAA3040_ASI_CHANNEL_SLOT_SHIFT, TAA3040_ASI_CHANNEL_SLOT_MASK> slot;
+    typedef field<config, TAA3040_ASI_CHANNEL_OUTPUT_SHIFT, TAA3040_ASI_CHANNEL_OUTPUT_MASK> output;
+};
+
+typedef reg<0, TAA3040_REG_MASTER_CONFIG0> master_config0;
+typedef field<master_config0, TAA3040_MCLK_FREQ_SELECT_SHIFT, TAA3040_MCLK_FREQ_SELECT_MASK> mclk_freq_select;
+typedef field<master_config0, TAA3040_SAMPLE_RATE_SHIFT, TAA3040_SAMPLE_RATE_MASK> sample_rate;
+typedef field<master_config0, TAA3040_BCLK_FSYNC_GATE_SHIFT, TAA3040_BCLK_FSYNC_GATE_MASK> bclk_fsync_gate;
+typedef field<master_config0, TAA3040_AUTO_MODE_PLL_SHIFT, TAA3040_AUTO_MODE_PLL_MASK> auto_mode_pll;
+typedef field<master_config0, TAA3040_AUTO_CLOCK_CONFIG_SHIFT, TAA3040_AUTO_CLOCK_CONFIG_MASK> auto_clock_config;
+typedef field<master_config0, TAA3040_MASTER_SLAVE_CONFIG_SHIFT, TAA3040_MASTER_SLAVE_CONFIG_MASK> master_slave;
+
+typedef reg<0, TAA3040_REG_MASTER_CONFIG1> master_config1;
+typedef field<master_config1, TAA3040_FSYNC_BCLK_RATIO_SHIFT, TAA3040_FSYNC_BCLK_RATIO_MASK> fsync_bclk_ratio;
+typedef field<master_config1, TAA3040_FSYNC_RATE_SHIFT, TAA3040_FSYNC_RATE_MASK> fsync_rate;
+
+typedef reg<0, TAA3040_REG_ASI_STATUS, access::read_only> asi_status;
+typedef field<asi_status, TAA3040_FSYNC_RATIO_STATUS_SHIFT, TAA3040_FSYNC_RATIO_STATUS_MASK> fsync_ratio_status;
+typedef field<asi_status, TAA3040_FSYNC_RATE_STATUS_SHIFT, TAA3040_FSYNC_RATE_STATUS_MASK> fsync_rate_status;
+
+typedef reg<0, TAA3040_REG_CLOCK_SOURCE> clock_source;
+typedef field<clock_source, TAA3040_MCLK_RATIO_SEL_SHIFT, TAA3040_MCLK_RATIO_SEL_MASK> mclk_ratio_sel;
+typedef field<clock_source, TAA3040_MCLK_FREQ_SEL_SHIFT, TAA3040_MCLK_FREQ_SEL_MASK> mclk_freq_sel;
+typedef field<clock_source, TAA3040_SLAVE_CLOCK_SOURCE_SHIFT, TAA3040_SLAVE_CLOCK_SOURCE_MASK> slave_clock_source;
+
+/* --- PDM --- */
+typedef reg<0, TAA3040_REG_PDMCLK_CONFIG> pdmclk_config;
+typedef field<pdmclk_config, TAA3040_PDMCLK_DIVIDER_SHIFT, TAA3040_PDMCLK_DIVIDER_MASK> pdmclk_divider;
+
+typedef reg<0, TAA3040_REG_PDMIN_CONFIG> pdmin_config;
+typedef field<pdmin_config, TAA3040_PDMDIN1_EDGE_SHIFT, TAA3040_PDMDIN1_EDGE_MASK> pdmdin1_edge;
+typedef field<pdmin_config, TAA3040_PDMDIN2_EDGE_SHIFT, TAA3040_PDMDIN2_EDGE_MASK> pdmdin2_edge;
+typedef field<pdmin_config, TAA3040_PDMDIN3_EDGE_SHIFT, TAA3040_PDMDIN3_EDGE_MASK> pdmdin3_edge;
+typedef field<pdmin_config, TAA3040_PDMDIN4_EDGE_SHIFT, TAA3040_PDMDIN4_EDGE_MASK> pdmdin4_edge;
+
+/* --- GPIO and Interrupts --- */
+typedef reg<0, TAA3040_REG_GPIO1_CONFIG> gpio1_config;
+typedef field<gpio1_config, TAA3040_GPIO_CONFIG_SHIFT, TAA3040_GPIO_CONFIG_MASK> gpio1_mode;
+typedef field<gpio1_config, TAA3040_GPIO_DRIVE_MODE_SHIFT, TAA3040_GPIO_DRIVE_MODE_MASK> gpio1_drive;
+
+/** @brief Configuration register of a general purpose output (0-3) */
+template <uint8_t Index>
+struct gpo
+{
+    static_assert(Index < TAA3040_NUM_GPO, "GPO out of range");
+    typedef reg<0, TAA3040_REG_GPO_CONFIG_BASE + Index> config;
+    typedef field<config, TAA3040_GPO_CONFIG_SHIFT, TAA3040_GPO_CONFIG_MASK> mode;
+    typedef field<config, TAA3040_GPO_DRIVE_MODE_SHIFT, TAA3040_GPO_DRIVE_MODE_MASK> drive;
+    typedef flag<reg<0, TAA3040_REG_GPO_VALUE>, TAA3040_GPO1_VALUE_SHIFT - Index> value;
+};
+
+typedef reg<0, TAA3040_REG_GPO_VALUE> gpo_value;
+typedef reg<0, TAA3040_REG_GPIO1_MONITOR, access::read_only> gpio1_monitor;
+typedef field<gpio1_monitor, TAA3040_GPIO1_MON_SHIFT, TAA3040_GPIO1_MON_MASK> gpio1_level;
+
+typedef reg<0, TAA3040_REG_GPI_CONFIG_BASE> gpi_config1;
+typedef field<gpi_config1, TAA3040_GPI1_CONFIG_SHIFT, TAA3040_GPI1_CONFIG_MASK> gpi1_mode;
+typedef field<gpi_config1, TAA3040_GPI2_CONFIG_SHIFT, TAA3040_GPI2_CONFIG_MASK> gpi2_mode;
+typedef reg<0, TAA3040_REG_GPI_CONFIG_BASE + 1> gpi_config2;
+typedef field<gpi_config2, TAA3040_GPI3_CONFIG_SHIFT, TAA3040_GPI3_CONFIG_MASK> gpi3_mode;
+typedef field<gpi_config2, TAA3040_GPI4_CONFIG_SHIFT, TAA3040_GPI4_CONFIG_MASK> gpi4_mode;
+
+typedef reg<0, TAA3040_REG_GPI_MONITOR, access::read_only> gpi_monitor;
+typedef field<gpi_monitor, TAA3040_GPI1_MONITOR_SHIFT, TAA3040_GPI1_MONITOR_MASK> gpi1_level;
+typedef field<gpi_monitor, TAA3040_GPI2_MONITOR_SHIFT, TAA3040_GPI2_MONITOR_MASK> gpi2_level;
+typedef field<gpi_monitor, TAA3040_GPI3_MONITOR_SHIFT, TAA3040_GPI3_MONITOR_MASK> gpi3_level;
+typedef field<gpi_monitor, TAA3040_GPI4_MONITOR_SHIFT, TAA3040_GPI4_MONITOR_MASK> gpi4_level;
+
+typedef reg<0, TAA3040_REG_INTERRUPT_CONFIG> interrupt_config;
+typedef field<interrupt_config, TAA3040_INTERRUPT_POLARITY_SHIFT, TAA3040_INTERRUPT_POLARITY_MASK> interrupt_polarity;
+typedef field<interrupt_config, TAA3040_INTERRUPT_EVENT_SHIFT, TAA3040_INTERRUPT_EVENT_MASK> interrupt_event;
+typedef field<interrupt_config, TAA3040_INTERRUPT_LATCH_SHIFT, TAA3040_INTERRUPT_LATCH_MASK> interrupt_latch_enable;
+
+typedef reg<0, TAA3040_REG_INTERRUPT_MASK> interrupt_mask;
+typedef field<interrupt_mask, TAA3040_INTERRUPT_ASI_ERROR_SHIFT, TAA3040_INTERRUPT_ASI_ERROR_MASK> mask_asi_error;
+typedef field<interrupt_mask, TAA3040_INTERRUPT_PLL_ERROR_SHIFT, TAA3040_INTERRUPT_PLL_ERROR_MASK> mask_pll_error;
+
+typedef reg<0, TAA3040_REG_INTERRUPT_LATCH> interrupt_latch;
+typedef field<interrupt_latch, TAA3040_INTERRUPT_ASI_ERROR_SHIFT, TAA3040_INTERRUPT_ASI_ERROR_MASK> latched_asi_error;
+typedef field<interrupt_latch, TAA3040_INTERRUPT_PLL_ERROR_SHIFT, TAA3040_INTERRUPT_PLL_ERROR_MASK> latched_pll_error;
+
+/* --- Channels --- */
+
+/** @brief The five registers of an input channel (0-7) */
+template <uint8_t Channel>
+struct channel
+{
+    static_assert(Channel < TAA3040_NUM_CHANNELS, "channel out of range");
+
+    typedef reg<0, TAA3040_REG_CH_CONFIG(Channel)> config;
+    typedef field<config, TAA3040_CHANNEL_AGC_EN_SHIFT, TAA3040_CHANNEL_AGC_EN_MASK> agc_enable;
+    typedef field<config, TAA3040_CHANNEL_IMPEDANCE_SHIFT, TAA3040_CHANNEL_IMPEDANCE_MASK> impedance;
+    typedef field<config, TAA3040_CHANNEL_COUPLING_SHIFT, TAA3040_CHANNEL_COUPLING_MASK> coupling;
+    typedef field<config, TAA3040_CHANNEL_SOURCE_SHIFT, TAA3040_CHANNEL_SOURCE_MASK> source;
+    typedef field<config, TAA3040_CHANNEL_INPUT_TYPE_SHIFT, TAA3040_CHANNEL_INPUT_TYPE_MASK> input_type;
+
+    typedef field<reg<0, TAA3040_REG_CH_GAIN(Channel)>, TAA3040_CHANNEL_GAIN_SHIFT, TAA3040_CHANNEL_GAIN_MASK> gain;
+    typedef field<reg<0, TAA3040_REG_CH_VOLUME(Channel)>, TAA3040_CHANNEL_VOLUME_SHIFT, TAA3040_CHANNEL_VOLUME_MASK> volume;
+    typedef field<reg<0, TAA3040_REG_CH_GAIN_CAL(Channel)>, TAA3040_CHANNEL_GAIN_CAL_SHIFT, TAA3040_CHANNEL_GAIN_CAL_MASK> gain_calibration;
+    typedef field<reg<0, TAA3040_REG_CH_PHASE_CAL(Channel)>, TAA3040_CHANNEL_PHASE_CAL_SHIFT, TAA3040_CHANNEL_PHASE_CAL_MASK> phase_calibration;
+
+    /* Enable and status bits run from channel 1 in bit 7 down to channel 8 in bit 0 */
+    typedef flag<reg<0, TAA3040_REG_IN_CHANNEL_EN>, TAA3040_NUM_CHANNELS - 1 - Channel> input_enable;
+    typedef flag<reg<0, TAA3040_REG_ASI_OUT_CHANNEL_EN>, TAA3040_NUM_CHANNELS - 1 - Channel> output_enable;
+    typedef flag<reg<0, TAA3040_REG_STATUS0, access::read_only>, TAA3040_NUM_CHANNELS - 1 - Channel> powered;
+};
+
+typedef reg<0, TAA3040_REG_IN_CHANNEL_EN> in_channel_en;
+typedef reg<0, TAA3040_REG_ASI_OUT_CHANNEL_EN> asi_out_channel_en;
+
+/* --- DSP --- */
+typedef reg<0, TAA3040_REG_DSP_CONFIG0> dsp_config0;
+typedef field<dsp_config0, TAA3040_DECIMATION_FILTER_SHIFT, TAA3040_DECIMATION_FILTER_MASK> decimation_filter;
+typedef field<dsp_config0, TAA3040_CHANNEL_SUM_MODE_SHIFT, TAA3040_CHANNEL_SUM_MODE_MASK> channel_sum_mode;
+typedef field<dsp_config0, TAA3040_HIGH_PASS_FILTER_SHIFT, TAA3040_HIGH_PASS_FILTER_MASK> high_pass_filter;
+
+typedef reg<0, TAA3040_REG_DSP_CONFIG1> dsp_config1;
+typedef field<dsp_config1, TAA3040_VOLUME_GANGED_SHIFT, TAA3040_VOLUME_GANGED_MASK> volume_ganged;
+typedef field<dsp_config1, TAA3040_BIQUAD_COUNT_SHIFT, TAA3040_BIQUAD_COUNT_MASK> biquad_count;
+typedef field<dsp_config1, TAA3040_SOFT_STEP_SHIFT, TAA3040_SOFT_STEP_MASK> soft_step_disable;
+typedef field<dsp_config1, TAA3040_AGC_SELECT_SHIFT, TAA3040_AGC_SELECT_MASK> agc_select;
+
+typedef reg<0, TAA3040_REG_AGC_CONFIG> agc_config;
+typedef field<agc_config, TAA3040_AGC_LEVEL_SHIFT, TAA3040_AGC_LEVEL_MASK> agc_level;
+typedef field<agc_config, TAA3040_AGC_MAX_GAIN_SHIFT, TAA3040_AGC_MAX_GAIN_MASK> agc_max_gain;
+
+/* --- Status --- */
+typedef reg<0, TAA3040_REG_STATUS0, access::read_only> status0;
+typedef reg<0, TAA3040_REG_STATUS1, access::read_only> status1;
+typedef field<status1, TAA3040_MODE_STATUS_SHIFT, TAA3040_MODE_STATUS_MASK> mode_status;
+
+} // namespace regs
+
+} // namespace taa3040
+} // namespace crablabs
+
+#endif /* TAA3040_REGISTERS_HPP */
@@ -0,0 +1,124 @@
+/**
+ * @file taa3040_sequencer.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Cold start sequencing that overlaps analog settling with register programming
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_SEQUENCER_H
+#define TAA3040_SEQUENCER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "taa3040_types.h"
+
+/*
+ * The usual bring-up writes every block and only then powers the channels, so the VREF
+ * and input capacitor quick charge and the PLL lock all follow the last register write.
+ * Only the blocks that shape the analog path or the clocks, and the biquad, mixer and
+ * IIR coefficients, which may only change while the channels are powered down, have to
+ * be in place before power up. The rest (GPIO and interrupts) only act on the digital
+ * data or the pins, and may follow.
+ *
+ * The sequencer therefore:
+ *   1. drives the enable pin and encodes the register image while the supplies come up,
+ *   2. wakes the device and writes the power-up blocks and the coefficients,
+ *   3. powers the channels, starting the analog settling,
+ *   4. writes the remaining blocks while the device settles,
+ *   5. waits out whatever settling time is left.
+ *
+ * Settling times come from the quick charge settings in the image itself; the fixed
+ * delays below are conservative and may be overridden at build time. The device does
+ * not report when its data turns valid, so the first sample time in the report is an
+ * estimate from these figures, not a measurement.
+ */
+
+#ifndef TAA3040_SEQUENCER_READY_US
+#define TAA3040_SEQUENCER_READY_US      (1000)  ///< Enable pin high until the device accepts I2C
+#endif
+
+#ifndef TAA3040_SEQUENCER_WAKE_US
+#define TAA3040_SEQUENCER_WAKE_US       (1000)  ///< Leaving sleep until other registers may be written
+#endif
+
+#ifndef TAA3040_SEQUENCER_PLL_LOCK_US
+#define TAA3040_SEQUENCER_PLL_LOCK_US   (5000)  ///< PLL power up until lock, with the ASI clocks running
+#endif
+
+/**
+ * @brief Time source for the sequencer.
+ */
+typedef struct {
+    uint32_t (*now_us)(void);               ///< Free running microsecond counter
+    void (*delay_us)(const uint32_t us);    ///< Block for at least us microseconds
+} taa3040_sequencer_timer_t;
+
+/**
+ * @brief Timeline of a start, in microseconds from the enable pin going high.
+ */
+typedef struct {
+    uint32_t ready_us;                  ///< Device accepted I2C
+    uint32_t power_up_us;               ///< Channels powered, analog settling started
+    uint32_t programmed_us;             ///< Last register written
+    uint32_t settle_us;                 ///< Analog settling time of the configuration
+    uint32_t first_sample_estimate_us;  ///< Estimated first valid sample: programming done and settle_us over
+    uint32_t sequential_us;             ///< Estimated first valid sample had every block been written before power up
+    uint8_t device_status;              ///< TAA3040_STATUS_* mode read once the device settled
+} taa3040_sequencer_report_t;
+
+/**
+ * @brief Analog settling time of a register image.
+ *
+ * VREF quick charge, followed by the input capacitor quick charge when an enabled channel
+ * is AC coupled, or the PLL lock time if longer and the PLL is enabled.
+ *
+ * @param[in] image Register image, TAA3040_IMAGE_SIZE bytes.
+ * @return Settling time in microseconds, 0 if the ADC is not enabled.
+ */
+uint32_t taa3040_sequencer_settle_us(const uint8_t *const image);
+
+/**
+ * @brief Program a register image into a device that was just enabled, overlapping settling.
+ *
+ * The device must be on page 0 and out of reset, either fresh from its enable pin or
+ * from taa3040_reset. Ends on page 0 with every register of the image written.
+ *
+ * @param[in] dev Device handle.
+ * @param[in] image Register image, TAA3040_IMAGE_SIZE bytes.
+ * @param[in] timer Time source.
+ * @param[in] start Timer value the device was enabled at.
+ * @param[out] report Timeline (may be NULL).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_sequencer_program(const taa3040_t *const dev, const uint8_t *const image, const taa3040_sequencer_timer_t *const timer,
+                               const uint32_t start, taa3040_sequencer_report_t *const report);
+
+/**
+ * @brief Cold start a device into a configuration.
+ *
+ * Drives the enable pin, encodes the configuration while the device comes up, then
+ * runs taa3040_sequencer_program.
+ *
+ * @param[in] dev Device handle, set up with taa3040_init.
+ * @param[in] config Configuration to start in.
+ * @param[in] timer Time source.
+ * @param[out] report Timeline (may be NULL).
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_sequencer_start(const taa3040_t *const dev, const taa3040_config_t *const config, const taa3040_sequencer_timer_t *const timer,
+                             taa3040_sequencer_report_t *const report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_SEQUENCER_H */
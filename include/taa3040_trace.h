@@ -0,0 +1,221 @@
+/**
+ * @file taa3040_trace.h
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief Recording of bus transactions for timeline analysis
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#pragma once
+
+#ifndef TAA3040_TRACE_H
+#define TAA3040_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "taa3040_types.h"
+
+/*
+ * Build with TAA3040_TRACE to record every I2C transaction of a device, along with the
+ * entry and exit of each public call, into a fixed ring of records. The ring keeps the
+ * most recent records and is written by the thread using the device only, so it can be
+ * exported from another thread at any time without locking. Records overwritten during
+ * an export are dropped from it rather than torn.
+ *
+ * The export is Chrome trace event JSON, which chrome://tracing and the Perfetto UI both
+ * open directly. Public calls appear as nested slices and transactions as slices within them.
+ *
+ * Without TAA3040_TRACE the device carries no trace pointer and the driver records nothing.
+ */
+
+#if defined(TAA3040_TRACE) && !(defined(__GNUC__) || defined(__clang__))
+#error "TAA3040_TRACE relies on the cleanup attribute and atomic builtins of GCC or Clang"
+#endif
+
+/**
+ * @brief Public calls transactions are attributed to.
+ */
+typedef enum {
+    TAA3040_TRACE_API_NONE = 0,
+    TAA3040_TRACE_API_RESET,
+    TAA3040_TRACE_API_SLEEP,
+    TAA3040_TRACE_API_WAKE,
+    TAA3040_TRACE_API_SET_DEVICE_CONFIG,
+    TAA3040_TRACE_API_GET_DEVICE_CONFIG,
+    TAA3040_TRACE_API_SET_ASI_CONFIG,
+    TAA3040_TRACE_API_GET_ASI_CONFIG,
+    TAA3040_TRACE_API_SET_CHANNEL_CONFIG,
+    TAA3040_TRACE_API_GET_CHANNEL_CONFIG,
+    TAA3040_TRACE_API_SET_MIXER_CHANNEL_CONFIG,
+    TAA3040_TRACE_API_GET_MIXER_CHANNEL_CONFIG,
+    TAA3040_TRACE_API_SET_MIXER_CONFIG,
+    TAA3040_TRACE_API_GET_MIXER_CONFIG,
+    TAA3040_TRACE_API_SET_SYSTEM_CONFIG,
+    TAA3040_TRACE_API_SET_DSP_CONFIG,
+    TAA3040_TRACE_API_GET_DSP_CONFIG,
+    TAA3040_TRACE_API_SET_GPIO_CONFIG,
+    TAA3040_TRACE_API_GET_GPIO_CONFIG,
+    TAA3040_TRACE_API_SET_INTERRUPT_CONFIG,
+    TAA3040_TRACE_API_GET_INTERRUPT_CONFIG,
+    TAA3040_TRACE_API_SET_GAIN_DB,
+    TAA3040_TRACE_API_GET_GAIN_DB,
+    TAA3040_TRACE_API_SET_DIGITAL_VOLUME,
+    TAA3040_TRACE_API_GET_DIGITAL_VOLUME,
+    TAA3040_TRACE_API_GET_FILTER,
+    TAA3040_TRACE_API_SET_FILTER,
+    TAA3040_TRACE_API_ENABLE_CHANNEL,
+    TAA3040_TRACE_API_DISABLE_CHANNEL,
+    TAA3040_TRACE_API_GET_STATUS,
+    TAA3040_TRACE_API_SET_PAGE,
+    TAA3040_TRACE_API_WRITE_REGISTERS,
+    TAA3040_TRACE_API_READ_REGISTERS,
+    TAA3040_TRACE_API_WRITE_IMAGE,
+    TAA3040_TRACE_API_READ_IMAGE,
+    TAA3040_TRACE_API_UPLOAD_BEGIN,
+    TAA3040_TRACE_API_UPLOAD_END,
+    TAA3040_TRACE_API_UPLOAD_DEVICE_CONFIG,
+    TAA3040_TRACE_API_SET_CHANNEL_CONFIGS,
+    TAA3040_TRACE_API_GET_CHANNEL_CONFIGS,
+    TAA3040_TRACE_API_SET_LEVELS,
+    TAA3040_TRACE_API_GET_LEVELS,
+    TAA3040_TRACE_API_COUNT
+} taa3040_trace_api_t;
+
+/* Kind of record, in the low bits of taa3040_trace_record_t.flags */
+#define TAA3040_TRACE_KIND_MASK     (0x03)
+#define TAA3040_TRACE_WRITE         (0x00)  ///< I2C write
+#define TAA3040_TRACE_READ          (0x01)  ///< I2C read
+#define TAA3040_TRACE_API_BEGIN     (0x02)  ///< A public call started
+#define TAA3040_TRACE_API_END       (0x03)  ///< A public call returned
+
+#define TAA3040_TRACE_OK_MASK       (0x80)  ///< The transaction succeeded
+
+/**
+ * @brief One trace record.
+ */
+typedef struct {
+    uint32_t timestamp;     ///< Start of the event, from the trace clock
+    uint16_t duration;      ///< Length of a transaction, from the trace clock (saturates)
+    uint8_t page;           ///< Page selected when the transaction started
+    uint8_t reg;            ///< First register of the transaction
+    uint8_t length;         ///< Bytes transferred
+    uint8_t flags;          ///< TAA3040_TRACE_* kind and TAA3040_TRACE_OK_MASK
+    uint8_t api;            ///< Innermost public call in progress, a taa3040_trace_api_t
+} taa3040_trace_record_t;
+
+/**
+ * @brief Timestamp source, in microseconds for the export to be to scale.
+ */
+typedef uint32_t (*taa3040_trace_clock_fn)(void);
+
+/**
+ * @brief Receives exported text.
+ *
+ * @param[in] context Context given to the export.
+ * @param[in] text Text to append, not nul terminated.
+ * @param[in] length Characters in text.
+ */
+typedef void (*taa3040_trace_sink_fn)(void *const context, const char *const text, const size_t length);
+
+/**
+ * @brief Ring of trace records of one device.
+ */
+typedef struct taa3040_trace {
+    taa3040_trace_record_t* records;    ///< Caller supplied ring storage
+    uint32_t capacity;                  ///< Records the ring holds
+    volatile uint32_t written;          ///< Records written since the trace was initialized
+    taa3040_trace_clock_fn clock;       ///< Timestamp source
+    uint8_t address;                    ///< I2C address of the traced device, used as the export process id
+    uint8_t page;                       ///< Page the device is on, followed from page select writes
+    uint8_t api;                        ///< Innermost public call in progress
+} taa3040_trace_t;
+
+/**
+ * @brief Initialize an empty trace.
+ *
+ * @param[out] trace Trace to initialize.
+ * @param[in] records Ring storage, must outlive the trace.
+ * @param[in] capacity Records in storage.
+ * @param[in] clock Timestamp source.
+ * @return true if successful, false otherwise.
+ */
+bool taa3040_trace_init(taa3040_trace_t *const trace, taa3040_trace_record_t *const records, const uint32_t capacity, const taa3040_trace_clock_fn clock);
+
+/**
+ * @brief Start tracing a device.
+ *
+ * Call after taa3040_init, which detaches any trace. The device is assumed to be on page 0.
+ *
+ * @param[in,out] dev Device handle.
+ * @param[in] trace Trace to record into (NULL stops tracing).
+ * @return true if successful, false if the driver was built without TAA3040_TRACE.
+ */
+bool taa3040_trace_attach(taa3040_t *const dev, taa3040_trace_t *const trace);
+
+/**
+ * @brief Copy out the records still in the ring, oldest first.
+ *
+ * @param[in] trace Trace.
+ * @param[out] records Buffer for the records.
+ * @param[in] capacity Records the buffer holds.
+ * @return Number of records copied.
+ */
+uint32_t taa3040_trace_snapshot(const taa3040_trace_t *const trace, taa3040_trace_record_t *const records, const uint32_t capacity);
+
+/**
+ * @brief Name of a public call.
+ *
+ * @param[in] api A taa3040_trace_api_t.
+ * @return Name of the function, "unknown" if out of range.
+ */
+const char* taa3040_trace_api_name(const uint8_t api);
+
+/**
+ * @brief Export records as Chrome trace event JSON.
+ *
+ * @param[in] records Records, oldest first, as returned by taa3040_trace_snapshot.
+ * @param[in] count Number of records.
+ * @param[in] address I2C address of the device, used as the process id.
+ * @param[in] sink Receives the JSON text.
+ * @param[in] context Passed to sink.
+ */
+void taa3040_trace_export_chrome(const taa3040_trace_record_t *const records, const uint32_t count, const uint8_t address,
+                                 const taa3040_trace_sink_fn sink, void *const context);
+
+/* === Driver Hooks === */
+
+/** @brief Public call scope, closed automatically when it goes out of scope */
+typedef struct {
+    taa3040_trace_t* trace;     ///< Trace of the device, NULL when not tracing
+    uint8_t outer;              ///< Public call that was in progress on entry
+} taa3040_trace_scope_t;
+
+/** @brief Record the entry of a public call */
+taa3040_trace_scope_t taa3040_trace_enter(taa3040_trace_t *const trace, const uint8_t api);
+/** @brief Record the exit of a public call */
+void taa3040_trace_leave(const taa3040_trace_scope_t *const scope);
+/** @brief Record one transaction that started at start */
+void taa3040_trace_transaction(taa3040_trace_t *const trace, const uint8_t kind, const uint8_t reg, const uint8_t *const data,
+                               const uint8_t length, const bool ok, const uint32_t start);
+
+#ifdef TAA3040_TRACE
+/** @brief Attribute the transactions of the enclosing public call, placed at the top of its body */
+#define TAA3040_TRACE_API(dev, api) \
+    const taa3040_trace_scope_t taa3040_trace_scope __attribute__((cleanup(taa3040_trace_leave), unused)) \
+        = taa3040_trace_enter((dev)? (dev)->trace: NULL, (api))
+#else
+#define TAA3040_TRACE_API(dev, api) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAA3040_TRACE_H */
@@ -23,6 +23,9 @@
 #define TAA3040_NUM_BIQUADS     12  ///< Numbers of filters
 #define TAA3040_NUM_MIXERS      8   ///< Channel Mixers
 
+/** @brief Bit of a channel (0 - 7) in a channel mask, IN_CHANNEL_EN order: channel 0 in bit 7 */
+#define TAA3040_CHANNEL_BIT(ch) ((uint8_t)(1u << (TAA3040_NUM_CHANNELS - 1u - (unsigned)(ch))))
+
 /* === Enumerations === */
 
 /** @brief Audio Output Modes */
@@ -355,6 +358,7 @@ typedef struct {
     taa3040_asi_word_length_t word_length;  ///< ASI word length (16, 20, 24, 32 bits)
 
     bool slave_mode;                ///< True if device is ASI slave
+    bool slave_mclk_source;         ///< In slave mode with the PLL off, MCLK instead of BCLK is the audio root clock
     bool auto_clock_enabled;        ///< Auto-detect clock rate
     bool fsync_polarity_inverted;   ///< Frame Sync polarity (normal/inverted)
     bool bclk_polarity_inverted;    ///< Bit Clock polarity (normal/inverted)
@@ -372,6 +376,7 @@ typedef struct {
         bool pll_disabled_autoclock;            ///< If the PLL is shutoff when auto clock generation is enabled
         bool gate_clocks;                       ///< If the clocks should be gated (BLCK and FSYNC)
         bool sample_rate_48khz;                 ///< If the clock is a submultiple of 48KHz
+        bool mclk_ratio_mode;                   ///< If MCLK is given by mclk_fsync_ratio instead of mclk_freq
     } master_mode;
 
     taa3040_asi_channel_config_t channel_configs[TAA3040_NUM_CHANNELS]; ///< Per-channel slot mapping
@@ -507,6 +512,48 @@ typedef struct {
 
 /* === HAL Function Pointer Types === */
 
+/*
+ * Defining TAA3040_HAL_CONTEXT gives every HAL function a leading context pointer, taken
+ * from the HAL structure, so one set of functions can serve devices on several I2C
+ * controllers and enable pins without a trampoline per device.
+ */
+
+#ifdef TAA3040_HAL_CONTEXT
+
+/**
+ * @brief I2C write function type.
+ *
+ * @param[in] context The HAL's i2c_context, such as the I2C controller handle.
+ * @param[in] address 7-bit I2C device address.
+ * @param[in] reg First register address to write.
+ * @param[in] data Bytes to write.
+ * @param[in] length Number of bytes to write.
+ * @return true on success, false on failure.
+ */
+typedef bool (*taa3040_i2c_write_fn)(void* const context, const uint8_t address, const uint8_t reg, const void* const data, const uint8_t length);
+
+/**
+ * @brief I2C read function type.
+ *
+ * @param[in] context The HAL's i2c_context, such as the I2C controller handle.
+ * @param[in] address 7-bit I2C device address.
+ * @param[in] reg First register address to read.
+ * @param[out] data Buffer for the bytes read.
+ * @param[in] length Number of bytes to read.
+ * @return true on success, false on failure.
+ */
+typedef bool (*taa3040_i2c_read_fn)(void* const context, const uint8_t address, const uint8_t reg, void* const data, const uint8_t length);
+
+/**
+ * @brief GPIO control function type.
+ *
+ * @param[in] context The HAL's enable_context, such as the enable pin.
+ * @param[in] state True = set high, false = set low.
+ */
+typedef void (*taa3040_gpio_set_fn)(void* const context, const bool state);
+
+#else
+
 /**
  * @brief I2C write function type.
  * 
@@ -534,6 +581,8 @@ typedef bool (*taa3040_i2c_read_fn)(const uint8_t address, const uint8_t reg, vo
  */
 typedef void (*taa3040_gpio_set_fn)(const bool state);
 
+#endif
+
 /* === HAL Context Structure === */
 
 /**
@@ -545,15 +594,72 @@ typedef struct {
 #ifndef TAA3040_REDUCED_HAL
     taa3040_gpio_set_fn enable_write;   ///< Enable GPIO control (optional)
 #endif
+#ifdef TAA3040_HAL_CONTEXT
+    void* i2c_context;                  ///< Passed to i2c_read and i2c_write
+#ifndef TAA3040_REDUCED_HAL
+    void* enable_context;               ///< Passed to enable_write
+#endif
+#endif
 } taa3040_hal_t;
 
+/* === Checksum Verified Upload === */
+
+/**
+ * @brief A single register write, addressed by page and register.
+ */
+typedef struct {
+    uint8_t page;   ///< Page the register lives on
+    uint8_t reg;    ///< Register address within the page
+    uint8_t value;  ///< Value written to the register
+} taa3040_register_write_t;
+
+/**
+ * @brief State of a checksum verified upload.
+ *
+ * While attached to a device every successful write is folded into the expected
+ * checksum and, if a log is provided, appended to it so that mismatches can be located.
+ * Registers written more than once are only resolved to their last value on a mismatch.
+ */
+typedef struct taa3040_upload {
+    uint8_t checksum;                   ///< Expected value of the device's I2C checksum register
+    uint8_t page;                       ///< Page currently selected on the device
+    taa3040_register_write_t* log;      ///< Every register write, in order (optional)
+    uint16_t log_capacity;              ///< Number of entries the log can hold
+    uint16_t log_count;                 ///< Number of entries currently in the log
+    bool log_overflow;                  ///< If registers were written that did not fit in the log
+} taa3040_upload_t;
+
+/* === Packed Configuration === */
+
+#define TAA3040_IMAGE_SIZE                      (389)   ///< Bytes in a register image (see taa3040_image.h)
+
+#define TAA3040_PACKED_AUTO_CLOCK_MASK          (0x01)  ///< asi_config.auto_clock_enabled
+#define TAA3040_PACKED_FIXED_I2C_ADDRESS_MASK   (0x02)  ///< system_config.advanced.fixed_i2c_address
+
+/**
+ * @brief A full configuration stored as the contents of the registers it controls.
+ *
+ * Holds the same settings as taa3040_config_t in a fraction of the memory and can be
+ * written to the device without any encoding. See taa3040_packed.h for accessors.
+ */
+typedef struct {
+    uint8_t image[TAA3040_IMAGE_SIZE];  ///< Register image, laid out as TAA3040_IMAGE_RUNS
+    uint8_t flags;                      ///< Settings without a backing register (TAA3040_PACKED_*_MASK)
+} taa3040_packed_config_t;
+
 /**
  * @brief Device instance object.
  */
 typedef struct taa3040 {
     taa3040_hal_t hal;          ///< HAL (I2C, GPIO control)
     uint8_t address;            ///< 7-bit I2C address
-#ifndef TAA3040_MINIMAL_RAM
+    taa3040_upload_t* upload;   ///< Active checksum verified upload (NULL when none)
+#ifdef TAA3040_TRACE
+    struct taa3040_trace* trace; ///< Transaction trace, see taa3040_trace.h (NULL when none)
+#endif
+#if defined(TAA3040_PACKED_CONFIG)
+    taa3040_packed_config_t config; ///< Cached device configuration, as register contents
+#elif !defined(TAA3040_MINIMAL_RAM)
     taa3040_config_t config;    ///< Cached device configuration
 #endif
 } taa3040_t;
@@ -572,6 +678,7 @@ static const taa3040_asi_config_t TAA3040_DEFAULT_ASI_CONFIG =
     .mode = TAA3040_ASI_MODE_TDM,
     .word_length = TAA3040_ASI_WORD_LENGTH_24BITS,
     .slave_mode = false,  // Device set as master by default
+    .slave_mclk_source = false,
     .auto_clock_enabled = true,
     .fsync_polarity_inverted = false,
     .bclk_polarity_inverted = false,
@@ -584,7 +691,8 @@ static const taa3040_asi_config_t TAA3040_DEFAULT_ASI_CONFIG =
         .automatic_clock_config = true,
         .pll_disabled_autoclock = false,
         .gate_clocks = false,
-        .sample_rate_48khz = true
+        .sample_rate_48khz = true,
+        .mclk_ratio_mode = false
     },
     .channel_configs = 
     {
@@ -658,25 +766,25 @@ static const taa3040_mixer_config_t TAA3040_DEFAULT_MIXER_CONFIG =
 
 static const taa3040_interrupt_config_t TAA3040_DEFAULT_INTERRUPT_CONFIG = 
 {
+    .polarity = TAA3040_INTERRUPT_POLARITY_ACTIVE_LOW,
     .event = TAA3040_INTERRUPT_EVENT_ASSERT,
-    .polarity = false, // active low
     .latch_enable = false,
-    .mask_asi_interrupt = true,
-    .latch_asi_interrupt = false,
     .mask_pll_interrupt = true,
-    .latch_pll_interrupt = false
+    .latch_pll_interrupt = false,
+    .mask_asi_interrupt = true,
+    .latch_asi_interrupt = false
 };
 
 static const taa3040_channel_config_t TAA3040_DEFAULT_CHANNEL_CONFIG = 
 {
     .enabled = false,
     .is_microphone = true,
-    .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
     .dc_coupled = false,
-    .gain_db = 0,
+    .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
     .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-    .digital_volume_setting = 0xC9,
+    .gain_db = 0,
     .automatic_gain_control = false,
+    .digital_volume_setting = 0xC9,
     .advanced = 
     {
         .gain_calibration = 8,
@@ -759,11 +867,30 @@ static const taa3040_gpio_config_t default_gpio_config =
 
 static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
 {
+    .system_config = 
+    {
+        .adc_enabled = true,
+        .mic_bias_enabled = true,
+        .pll_enabled = true,
+        .dynamic_power_mode = true,
+        .avdd_is_3v3 = false,
+        .shutdown_mode = TAA3040_SHUTDOWN_DREG_MODE_WAIT,
+        .advanced = 
+        {
+            .vref_qc_time = TAA3040_VREF_QC_3500US,
+            .input_qc_time = TAA3040_INPUT_QC_2500US,
+            .fixed_i2c_address = false,
+            .pdm_clock = TAA3040_PDM_CLOCK_3072KHZ,
+            .dynamic_mode_channels = TAA3040_DYNAMIC_MODE_CHANNELS_1_2,
+            .dreg_shutdown_time = TAA3040_DREG_SHUTDOWN_TIME_30MS
+        }
+    },
     .asi_config = 
     {
         .mode = TAA3040_ASI_MODE_TDM,
         .word_length = TAA3040_ASI_WORD_LENGTH_24BITS,
         .slave_mode = false,  // Device set as master by default
+        .slave_mclk_source = false,
         .auto_clock_enabled = true,
         .fsync_polarity_inverted = false,
         .bclk_polarity_inverted = false,
@@ -776,7 +903,8 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
             .automatic_clock_config = true,
             .pll_disabled_autoclock = false,
             .gate_clocks = false,
-            .sample_rate_48khz = true
+            .sample_rate_48khz = true,
+            .mclk_ratio_mode = false
         },
         .channel_configs = 
         {
@@ -836,12 +964,12 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
         {
             .enabled = false,
             .is_microphone = true,
-            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .dc_coupled = false,
-            .gain_db = 0,
+            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-            .digital_volume_setting = 0xC9,
+            .gain_db = 0,
             .automatic_gain_control = false,
+            .digital_volume_setting = 0xC9,
             .advanced = 
             {
                 .gain_calibration = 8,
@@ -851,12 +979,12 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
         {
             .enabled = false,
             .is_microphone = true,
-            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .dc_coupled = false,
-            .gain_db = 0,
+            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-            .digital_volume_setting = 0xC9,
+            .gain_db = 0,
             .automatic_gain_control = false,
+            .digital_volume_setting = 0xC9,
             .advanced = 
             {
                 .gain_calibration = 8,
@@ -866,12 +994,12 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
         {
             .enabled = false,
             .is_microphone = true,
-            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .dc_coupled = false,
-            .gain_db = 0,
+            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-            .digital_volume_setting = 0xC9,
+            .gain_db = 0,
             .automatic_gain_control = false,
+            .digital_volume_setting = 0xC9,
             .advanced = 
             {
                 .gain_calibration = 8,
@@ -881,12 +1009,12 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
         {
             .enabled = false,
             .is_microphone = true,
-            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .dc_coupled = false,
-            .gain_db = 0,
+            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-            .digital_volume_setting = 0xC9,
+            .gain_db = 0,
             .automatic_gain_control = false,
+            .digital_volume_setting = 0xC9,
             .advanced = 
             {
                 .gain_calibration = 8,
@@ -896,12 +1024,12 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
         {
             .enabled = false,
             .is_microphone = true,
-            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .dc_coupled = false,
-            .gain_db = 0,
+            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-            .digital_volume_setting = 0xC9,
+            .gain_db = 0,
             .automatic_gain_control = false,
+            .digital_volume_setting = 0xC9,
             .advanced = 
             {
                 .gain_calibration = 8,
@@ -911,12 +1039,12 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
         {
             .enabled = false,
             .is_microphone = true,
-            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .dc_coupled = false,
-            .gain_db = 0,
+            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-            .digital_volume_setting = 0xC9,
+            .gain_db = 0,
             .automatic_gain_control = false,
+            .digital_volume_setting = 0xC9,
             .advanced = 
             {
                 .gain_calibration = 8,
@@ -926,12 +1054,12 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
         {
             .enabled = false,
             .is_microphone = true,
-            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .dc_coupled = false,
-            .gain_db = 0,
+            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-            .digital_volume_setting = 0xC9,
+            .gain_db = 0,
             .automatic_gain_control = false,
+            .digital_volume_setting = 0xC9,
             .advanced = 
             {
                 .gain_calibration = 8,
@@ -941,12 +1069,12 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
         {
             .enabled = false,
             .is_microphone = true,
-            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .dc_coupled = false,
-            .gain_db = 0,
+            .mode = TAA3040_CHANNEL_MODE_ANALOG_DIFF,
             .input_impedance = TAA3040_CHANNEL_IMPEDANCE_2K5,
-            .digital_volume_setting = 0xC9,
+            .gain_db = 0,
             .automatic_gain_control = false,
+            .digital_volume_setting = 0xC9,
             .advanced = 
             {
                 .gain_calibration = 8,
@@ -954,22 +1082,6 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
             }
         }
     },
-    .dsp_config = 
-    {
-        .volume_ganged = false,
-        .biquads_per_channel = 0,
-        .automatic_gain_control = true,
-        .high_pass_filter = TAA3040_HIGH_PASS_FILTER_FS_500,
-        .decimation_filter = TAA3040_DECIMATION_FILTER_LIN_PHASE,
-        .channel_summing = TAA3040_CHANNEL_SUMMING_MODE_NONE,
-        .biquad_filters = {{0}}, /* Initialize all to zero */
-        .advanced = {
-            .soft_stepping = true,
-            .automatic_gain_control_level = 10,
-            .automatic_gain_control_max_gain = 13,
-            .custom_high_pass_filter = {0, 0, 0}
-        }
-    },
     .gpio_config = 
     {
         .gpo_configs = 
@@ -995,6 +1107,22 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
             TAA3040_GPI_MODE_INPUT, TAA3040_GPI_MODE_INPUT, TAA3040_GPI_MODE_INPUT, TAA3040_GPI_MODE_INPUT
         }
     },
+    .dsp_config = 
+    {
+        .volume_ganged = false,
+        .biquads_per_channel = 0,
+        .automatic_gain_control = true,
+        .high_pass_filter = TAA3040_HIGH_PASS_FILTER_FS_500,
+        .decimation_filter = TAA3040_DECIMATION_FILTER_LIN_PHASE,
+        .channel_summing = TAA3040_CHANNEL_SUMMING_MODE_NONE,
+        .biquad_filters = {{0}}, /* Initialize all to zero */
+        .advanced = {
+            .soft_stepping = true,
+            .automatic_gain_control_level = 10,
+            .automatic_gain_control_max_gain = 13,
+            .custom_high_pass_filter = {0, 0, 0}
+        }
+    },
     .mixer_config = 
     {
         .channels = {
@@ -1008,33 +1136,15 @@ static const taa3040_config_t TAA3040_DEFAULT_CONFIG =
             { { 0, 0, 0, 0, 0, 0, 0, 1 } }  // Mixer configuration for channel 8
         }
     },
-    .system_config = 
-    {
-        .adc_enabled = true,
-        .mic_bias_enabled = true,
-        .pll_enabled = true,
-        .dynamic_power_mode = true,
-        .avdd_is_3v3 = false,
-        .shutdown_mode = TAA3040_SHUTDOWN_DREG_MODE_WAIT,
-        .advanced = 
-        {
-            .vref_qc_time = TAA3040_VREF_QC_3500US,
-            .input_qc_time = TAA3040_INPUT_QC_2500US,
-            .fixed_i2c_address = false,
-            .pdm_clock = TAA3040_PDM_CLOCK_3072KHZ,
-            .dynamic_mode_channels = TAA3040_DYNAMIC_MODE_CHANNELS_1_2,
-            .dreg_shutdown_time = TAA3040_DREG_SHUTDOWN_TIME_30MS
-        }
-    },
     .interrupt_config = 
     {
+        .polarity = TAA3040_INTERRUPT_POLARITY_ACTIVE_LOW,
         .event = TAA3040_INTERRUPT_EVENT_ASSERT,
-        .polarity = false, // active low
         .latch_enable = false,
-        .mask_asi_interrupt = true,
-        .latch_asi_interrupt = false,
         .mask_pll_interrupt = true,
-        .latch_pll_interrupt = false
+        .latch_pll_interrupt = false,
+        .mask_asi_interrupt = true,
+        .latch_asi_interrupt = false
     }
 };
 
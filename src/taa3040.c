@@ -12,42 +12,177 @@
 
 #include "taa3040.h"
 #include "taa3040_registers.h"
+#include "taa3040_image.h"
+#include "taa3040_packed.h"
+#include "taa3040_trace.h"
+#include <math.h>
 #include <string.h>
 
 #include <stdio.h>
 
 /* --- Internal Helpers --- */
+static inline uint8_t taa3040_gain_code(const float db)
+{
+    if(!(db > 0.0f))
+        return 0;
+    if(db >= TAA3040_CHANNEL_GAIN_MAX)
+        return TAA3040_CHANNEL_GAIN_MAX;
+    return (uint8_t)(db + 0.5f);
+}
+
+static inline uint8_t taa3040_volume_code(const float db)
+{
+    // Half dB steps around 0 dB at 201, -100 dB at 1; anything quieter mutes
+    const float steps = 2.0f * db;
+    if(!(steps >= 1 - TAA3040_CHANNEL_VOLUME_0DB - 0.5f))
+        return TAA3040_CHANNEL_VOLUME_MUTE;
+    if(steps >= UINT8_MAX - TAA3040_CHANNEL_VOLUME_0DB)
+        return UINT8_MAX;
+
+    const int code = TAA3040_CHANNEL_VOLUME_0DB + (int)(steps + (steps < 0? -0.5f: 0.5f));
+    return (uint8_t)(code < 1? 1: code);
+}
+
+static inline uint8_t taa3040_checksum_update(const uint8_t checksum, const uint8_t data)
+{
+    return (uint8_t)(checksum + data); // The device sums every data byte it receives
+}
+
+static void taa3040_upload_record(taa3040_upload_t *const upload, const uint8_t reg, const uint8_t* const data, const uint8_t length)
+{
+    for(uint8_t i = 0; i < length; ++i)
+    {
+        upload->checksum = taa3040_checksum_update(upload->checksum, data[i]);
+
+        const uint8_t addr = reg + i;
+        if(addr == TAA3040_REG_PAGE_SELECT)
+        {
+            upload->page = data[i];
+            continue;
+        }
+
+        if(!upload->log)
+            continue;
+
+        // Appended in write order, rewrites are resolved only if the checksum disagrees
+        if(upload->log_count == upload->log_capacity)
+        {
+            upload->log_overflow = true;
+            continue;
+        }
+
+        upload->log[upload->log_count++] = (taa3040_register_write_t){ .page = upload->page, .reg = addr, .value = data[i] };
+    }
+}
+
+/** @brief Keep only the last write to each register, in write order, and return how many are left */
+static uint16_t taa3040_upload_resolve(taa3040_upload_t *const upload)
+{
+    taa3040_register_write_t *const log = upload->log;
+
+    uint8_t pages[32] = {0};
+    for(uint16_t entry = 0; entry < upload->log_count; ++entry)
+        pages[log[entry].page >> 3] |= (uint8_t)(1u << (log[entry].page & 7));
+
+    // Newest first, so an older write to a register already seen is superseded. The page
+    // select register is never logged, which makes it free to mark the superseded ones
+    for(uint16_t page = 0; page < 256; ++page)
+    {
+        if(!(pages[page >> 3] & (1u << (page & 7))))
+            continue;
+
+        uint8_t seen[32] = {0};
+        for(uint16_t entry = upload->log_count; entry-- > 0;)
+        {
+            if(log[entry].page != page)
+                continue;
+
+            const uint8_t reg = log[entry].reg;
+            if(seen[reg >> 3] & (1u << (reg & 7)))
+                log[entry].reg = TAA3040_REG_PAGE_SELECT;
+            seen[reg >> 3] |= (uint8_t)(1u << (reg & 7));
+        }
+    }
+
+    uint16_t count = 0;
+    for(uint16_t entry = 0; entry < upload->log_count; ++entry)
+        if(log[entry].reg != TAA3040_REG_PAGE_SELECT)
+            log[count++] = log[entry];
+    return count;
+}
+
+#ifdef TAA3040_HAL_CONTEXT
+#define TAA3040_HAL_I2C(dev)    (dev)->hal.i2c_context, (dev)->address
+#define TAA3040_HAL_ENABLE(dev) (dev)->hal.enable_context,
+#else
+#define TAA3040_HAL_I2C(dev)    (dev)->address
+#define TAA3040_HAL_ENABLE(dev)
+#endif
+
+static inline bool taa3040_read(const taa3040_t *const dev, const uint8_t reg, void* const data, const uint8_t length)
+{
+#ifdef TAA3040_TRACE
+    const uint32_t start = dev->trace? dev->trace->clock(): 0;
+    const bool ok = dev->hal.i2c_read(TAA3040_HAL_I2C(dev), reg, data, length);
+    taa3040_trace_transaction(dev->trace, TAA3040_TRACE_READ, reg, NULL, length, ok, start);
+    return ok;
+#else
+    return dev->hal.i2c_read(TAA3040_HAL_I2C(dev), reg, data, length);
+#endif
+}
+
+static inline bool taa3040_write(const taa3040_t *const dev, const uint8_t reg, const uint8_t* const data, const uint8_t length)
+{
+#ifdef TAA3040_TRACE
+    const uint32_t start = dev->trace? dev->trace->clock(): 0;
+    const bool ok = dev->hal.i2c_write(TAA3040_HAL_I2C(dev), reg, data, length);
+    taa3040_trace_transaction(dev->trace, TAA3040_TRACE_WRITE, reg, data, length, ok, start);
+    if(!ok)
+        return false;
+#else
+    if(!dev->hal.i2c_write(TAA3040_HAL_I2C(dev), reg, data, length))
+        return false;
+#endif
+
+    if(dev->upload)
+        taa3040_upload_record(dev->upload, reg, data, length);
+
+    return true;
+}
+
 static inline bool taa3040_select_page(const taa3040_t *const dev, const uint8_t page) 
 {
-    return dev->hal.i2c_write(dev->address, TAA3040_REG_PAGE_SELECT, &page, 1);
+    return taa3040_write(dev, TAA3040_REG_PAGE_SELECT, &page, 1);
 }
 
 static inline bool taa3040_write_reg(const taa3040_t *const dev, const uint8_t reg, const uint8_t val) 
 {
-    return dev->hal.i2c_write(dev->address, reg, &val, 1);
+    return taa3040_write(dev, reg, &val, 1);
 }
 
 static inline bool taa3040_read_reg(const taa3040_t *const dev, const uint8_t reg, uint8_t* const val) 
 {
-    return dev->hal.i2c_read(dev->address, reg, val, 1);
+    return taa3040_read(dev, reg, val, 1);
 }
 
 static inline bool taa3040_write_i32(const taa3040_t *const dev, const uint8_t reg, const int32_t v) 
 {
-    uint8_t b[4] = { (uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v };
-    if(!dev->hal.i2c_write(dev->address, reg, b, 1))
-        return false;
-    return true;
+    uint8_t b[sizeof(int32_t)];
+    taa3040_encode_i32(v, b);
+    return taa3040_write(dev, reg, b, sizeof(b));
 }
 
-static inline bool taa3040_read_i32(const taa3040_t *const dev, const uint8_t reg, int32_t* const v) 
-{    
-    uint8_t b[4];
-    if (!dev->hal.i2c_read(dev->address, reg, b, 4)) 
+static bool taa3040_read_custom_hpf(const taa3040_t *const dev, taa3040_iir_filter_t *const iir)
+{
+    uint8_t b[TAA3040_BLOCK_IIR_LENGTH];
+    if(!taa3040_select_page(dev, TAA3040_PAGE_IIR_COEFF))
         return false;
 
-    *v = (int32_t)((b[0]<<24)|(b[1]<<16)|(b[2]<<8)|b[3]);
+    const bool read = taa3040_read(dev, TAA3040_REG_IIR_COEFF_START, b, sizeof(b));
+    if(!taa3040_select_page(dev, 0) || !read)
+        return false;
 
+    taa3040_decode_iir(b, iir);
     return true;
 }
 
@@ -57,7 +192,13 @@ bool taa3040_init(taa3040_t *const dev, const taa3040_hal_t *const hal, const ui
     if (!dev || !hal) return false;
     dev->hal = *hal;
     dev->address = address;
-#ifndef TAA3040_MINIMAL_RAM
+    dev->upload = NULL;
+#ifdef TAA3040_TRACE
+    dev->trace = NULL;
+#endif
+#if defined(TAA3040_PACKED_CONFIG)
+    taa3040_pack_config(&TAA3040_DEFAULT_CONFIG, &dev->config);
+#elif !defined(TAA3040_MINIMAL_RAM)
     memcpy(&dev->config, &TAA3040_DEFAULT_CONFIG, sizeof(dev->config));
 #endif
     return taa3040_select_page(dev, 0);
@@ -65,11 +206,13 @@ bool taa3040_init(taa3040_t *const dev, const taa3040_hal_t *const hal, const ui
 
 inline bool taa3040_reset(const taa3040_t *const dev) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_RESET);
     return taa3040_select_page(dev, 0) && taa3040_write_reg(dev, TAA3040_REG_SW_RESET, TAA3040_SW_RESET_MASK);
 }
 
 inline bool taa3040_sleep(const taa3040_t *const dev) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SLEEP);
     uint8_t sleep_reg = 0;
     if(!taa3040_read_reg(dev, TAA3040_REG_SLEEP_CFG, &sleep_reg))
     {
@@ -81,6 +224,7 @@ inline bool taa3040_sleep(const taa3040_t *const dev)
 
 inline bool taa3040_wake(const taa3040_t *const dev) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_WAKE);
     uint8_t cfg = 0;
     if(!taa3040_read_reg(dev, TAA3040_REG_SLEEP_CFG, &cfg))
     {
@@ -94,7 +238,7 @@ inline bool taa3040_startup(const taa3040_t *const dev)
 {
 #ifndef TAA3040_REDUCED_HAL
     if (dev->hal.enable_write) 
-        dev->hal.enable_write(true);
+        dev->hal.enable_write(TAA3040_HAL_ENABLE(dev) true);
 #endif
     return true; // powers up everything
 }
@@ -103,7 +247,7 @@ inline bool taa3040_shutdown(const taa3040_t *const dev)
 {
 #ifndef TAA3040_REDUCED_HAL
     if (dev->hal.enable_write) 
-        dev->hal.enable_write(false);
+        dev->hal.enable_write(TAA3040_HAL_ENABLE(dev) false);
 #endif
     return true;
 }
@@ -111,227 +255,132 @@ inline bool taa3040_shutdown(const taa3040_t *const dev)
 /* === ASI Configuration === */
 bool taa3040_set_asi_config(const taa3040_t *const dev, const taa3040_asi_config_t *const a) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_ASI_CONFIG);
     if (!dev || !a) 
         return false;
 
-    taa3040_select_page(dev,0);
-    const uint8_t config0 = ((a->mode << TAA3040_ASI_FORMAT_SHIFT) & TAA3040_ASI_FORMAT_MASK)
-                        |   ((a->word_length << TAA3040_ASI_WORD_LENGTH_SHIFT) & TAA3040_ASI_WORD_LENGTH_MASK)
-                        |   (a->fsync_polarity_inverted? TAA3040_FSYNC_POLARITY_MASK : 0)
-                        |   (a->bclk_polarity_inverted? TAA3040_BLCK_POLARITY_MASK : 0)
-                        |   (a->transmit_edge_inverted? TAA3040_TRANSMIT_EDGE_MASK : 0)
-                        |   (a->fill_zeros? TAA3040_TRANSMIT_FILL_MASK : 0);
-
-    if (!taa3040_write_reg(dev, TAA3040_REG_ASI_CONFIG0, config0)) 
-        return false;
-
-    const uint8_t config1 = (a->advanced.transmit_lsb_hiz ? TAA3040_TRANSMIT_LSB_MASK : 0)
-                        |   ((a->advanced.keeper_mode << TAA3040_TRANSMIT_KEEPER_SHIFT) & TAA3040_TRANSMIT_KEEPER_MASK)
-                        |   ((a->advanced.transmission_offset_cycles << TAA3040_TRANSMIT_OFFSET_SHIFT) & TAA3040_TRANSMIT_OFFSET_MASK);
-
-    if (!taa3040_write_reg(dev, TAA3040_REG_ASI_CONFIG1, config1)) 
+    if (!taa3040_select_page(dev, 0))
         return false;
 
-    const uint8_t config2 = (a->advanced.daisy_chain_connection? TAA3040_ASI_DAISY_MASK : 0)
-                        |   (a->advanced.error_detection? 0: TAA3040_ASI_ERROR_MASK)
-                        |   (a->advanced.error_recovery? 0: TAA3040_ASI_ERROR_RECOVERY_MASK);
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+    taa3040_encode_asi_config(a, page0);
 
-    if (!taa3040_write_reg(dev, TAA3040_REG_ASI_CONFIG2, config2))
-        return false;
-
-    const uint8_t master0 = (a->slave_mode? 0: TAA3040_MASTER_SLAVE_CONFIG_MASK)
-                        |   (a->master_mode.sample_rate_48khz? 0: TAA3040_SAMPLE_RATE_MASK)
-                        |   (a->master_mode.automatic_clock_config? 0: TAA3040_AUTO_CLOCK_CONFIG_MASK)
-                        |   (a->master_mode.pll_disabled_autoclock? TAA3040_AUTO_MODE_PLL_MASK : 0)
-                        |   (a->master_mode.gate_clocks? TAA3040_BCLK_FSYNC_GATE_MASK : 0)
-                        |   ((a->master_mode.mclk_freq << TAA3040_MCLK_FREQ_SELECT_SHIFT) & TAA3040_MCLK_FREQ_SELECT_MASK);
-
-    if (!taa3040_write_reg(dev, TAA3040_REG_MASTER_CONFIG0, master0))
-        return false;
-
-    const uint8_t master1 = ((a->master_mode.bclk_fsync_ratio << TAA3040_FSYNC_BCLK_RATIO_SHIFT) & TAA3040_FSYNC_BCLK_RATIO_MASK)
-                        |   ((a->master_mode.sample_rate << TAA3040_FSYNC_RATE_SHIFT) & TAA3040_FSYNC_RATE_MASK);
+    for (uint8_t reg = TAA3040_REG_ASI_CONFIG0; reg <= TAA3040_REG_ASI_CONFIG2; ++reg)
+        if (!taa3040_write_reg(dev, reg, page0[reg]))
+            return false;
 
-    if (!taa3040_write_reg(dev, TAA3040_REG_MASTER_CONFIG1, master1)) 
+    if (!taa3040_write_reg(dev, TAA3040_REG_MASTER_CONFIG0, page0[TAA3040_REG_MASTER_CONFIG0])
+    ||  !taa3040_write_reg(dev, TAA3040_REG_MASTER_CONFIG1, page0[TAA3040_REG_MASTER_CONFIG1])
+    ||  !taa3040_write_reg(dev, TAA3040_REG_CLOCK_SOURCE, page0[TAA3040_REG_CLOCK_SOURCE]))
         return false;
 
-    uint8_t channel_en = 0;
-    for(uint8_t channel = 0; channel < TAA3040_NUM_CHANNELS; ++channel)
-    {
-        const taa3040_asi_channel_config_t cc = a->channel_configs[channel];
-        const uint8_t v  = ((cc.slot << TAA3040_ASI_CHANNEL_SLOT_SHIFT) & TAA3040_ASI_CHANNEL_SLOT_MASK)
-                        |  (cc.gpio_output? TAA3040_ASI_CHANNEL_OUTPUT_MASK : 0);
-
-        if (cc.enabled)
-            channel_en |= (1 << (TAA3040_NUM_CHANNELS - channel - 1));
-        
-        if(!taa3040_write_reg(dev, TAA3040_REG_ASI_CHANNEL_BASE + channel, v))
+    for (uint8_t channel = 0; channel < TAA3040_NUM_CHANNELS; ++channel)
+        if (!taa3040_write_reg(dev, TAA3040_REG_ASI_CHANNEL_BASE + channel, page0[TAA3040_REG_ASI_CHANNEL_BASE + channel]))
             return false;
-    }
-
-    if (!taa3040_write_reg(dev, TAA3040_REG_ASI_OUT_CHANNEL_EN, channel_en))
-        return false;
 
-    return true;
+    return taa3040_write_reg(dev, TAA3040_REG_ASI_OUT_CHANNEL_EN, page0[TAA3040_REG_ASI_OUT_CHANNEL_EN]);
 }
 
 bool taa3040_get_asi_config(const taa3040_t *const dev, taa3040_asi_config_t *const a) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_ASI_CONFIG);
     if (!dev || !a) 
         return false;
     
-    taa3040_select_page(dev,0);
-    
-    uint8_t config0; 
-    if(!taa3040_read_reg(dev, TAA3040_REG_ASI_CONFIG0, &config0))
+    if (!taa3040_select_page(dev, 0))
         return false;
-    
-    a->mode = (config0 & TAA3040_ASI_FORMAT_MASK) >> TAA3040_ASI_FORMAT_SHIFT;
-    a->word_length = (config0 & TAA3040_ASI_WORD_LENGTH_MASK) >> TAA3040_ASI_WORD_LENGTH_SHIFT;
-    a->fsync_polarity_inverted = !!(config0 & TAA3040_FSYNC_POLARITY_MASK);
-    a->bclk_polarity_inverted = !!(config0 & TAA3040_BLCK_POLARITY_MASK);
-    a->transmit_edge_inverted = !!(config0 & TAA3040_TRANSMIT_EDGE_MASK);
-    a->fill_zeros = !!(config0 & TAA3040_TRANSMIT_FILL_MASK);
-    
-    uint8_t config1;
-    if(!taa3040_read_reg(dev, TAA3040_REG_ASI_CONFIG1, &config1))
-        return false;
-    
-    a->advanced.transmit_lsb_hiz = !!(config1 & TAA3040_TRANSMIT_LSB_MASK);
-    a->advanced.keeper_mode = (config1 & TAA3040_TRANSMIT_KEEPER_MASK) >> TAA3040_TRANSMIT_KEEPER_SHIFT;
-    a->advanced.transmission_offset_cycles = (config1 & TAA3040_TRANSMIT_OFFSET_MASK) >> TAA3040_TRANSMIT_OFFSET_SHIFT;
-    
-    uint8_t config2; 
-    if(!taa3040_read_reg(dev, TAA3040_REG_ASI_CONFIG2, &config2))
-        return false;
-
-    a->advanced.daisy_chain_connection= !!(config2 & TAA3040_ASI_DAISY_MASK);
-    a->advanced.error_detection= !!(config2 & TAA3040_ASI_ERROR_MASK);
-    a->advanced.error_recovery= !!(config2 & TAA3040_ASI_ERROR_RECOVERY_MASK);
 
-    uint8_t master0; 
-    if(!taa3040_read_reg(dev,TAA3040_REG_MASTER_CONFIG0, &master0))
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    if (!taa3040_read(dev, TAA3040_BLOCK_ASI_START, &page0[TAA3040_BLOCK_ASI_START], TAA3040_BLOCK_ASI_LENGTH))
         return false;
 
-    a->slave_mode = !(master0 & TAA3040_MASTER_SLAVE_CONFIG_MASK);
-    a->master_mode.sample_rate = (master0 & TAA3040_SAMPLE_RATE_MASK) >> TAA3040_SAMPLE_RATE_SHIFT;
-    a->master_mode.mclk_fsync_ratio = (master0 & TAA3040_FSYNC_BCLK_RATIO_MASK) >> TAA3040_FSYNC_BCLK_RATIO_SHIFT;
-    a->master_mode.automatic_clock_config = !!(master0 & TAA3040_AUTO_CLOCK_CONFIG_MASK);
-    a->master_mode.pll_disabled_autoclock = !!(master0 & TAA3040_AUTO_MODE_PLL_MASK);
-    a->master_mode.gate_clocks = !!(master0 & TAA3040_BCLK_FSYNC_GATE_MASK);
-
-    uint8_t master1; 
-    if(!taa3040_read_reg(dev,TAA3040_REG_MASTER_CONFIG1,&master1))
-        return false;
-
-    a->master_mode.sample_rate = ((master1 & TAA3040_FSYNC_RATE_MASK) >> TAA3040_FSYNC_RATE_SHIFT);
-    a->master_mode.mclk_fsync_ratio = ((master1 & TAA3040_FSYNC_BCLK_RATIO_MASK) >> TAA3040_BCLK_FSYNC_GATE_SHIFT);
-    
-    for(uint8_t channel=0; channel < TAA3040_NUM_CHANNELS; ++channel)
-    {
-        uint8_t v; 
-        if(!taa3040_read_reg(dev, TAA3040_REG_ASI_CHANNEL_BASE + channel, &v))
-            return false;
-
-        a->channel_configs[channel].gpio_output = !!(v & TAA3040_ASI_CHANNEL_OUTPUT_MASK);
-        a->channel_configs[channel].slot = (v & TAA3040_ASI_CHANNEL_SLOT_MASK) >> TAA3040_ASI_CHANNEL_SLOT_SHIFT;
-    }
-
-    uint8_t channel_en;
-    if(!taa3040_read_reg(dev, TAA3040_REG_ASI_OUT_CHANNEL_EN, &channel_en))
+    if (!taa3040_read_reg(dev, TAA3040_REG_ASI_OUT_CHANNEL_EN, &page0[TAA3040_REG_ASI_OUT_CHANNEL_EN]))
         return false;
 
-    for(uint8_t i = 0; i < TAA3040_NUM_CHANNELS; i++)
-    {
-        a->channel_configs[i].enabled = !!(channel_en & (1 << (TAA3040_NUM_CHANNELS - i - 1)));
-    }
-
+    taa3040_decode_asi_config(page0, a);
     return true;
 }
 
 /* === Channel Configuration === */
 bool taa3040_set_channel_config(const taa3040_t *const dev, uint8_t ch, const taa3040_channel_config_t *const c) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_CHANNEL_CONFIG);
     if(!dev || !c || ch >= TAA3040_NUM_CHANNELS) 
         return false;
     
-    taa3040_select_page(dev, 0);
-    
-    const uint8_t config_reg = TAA3040_REG_CH_CONFIG(ch);
-    const uint8_t cfg0 = (c->automatic_gain_control? TAA3040_CHANNEL_AGC_EN_MASK : 0)
-                        | ((c->input_impedance << TAA3040_CHANNEL_IMPEDANCE_SHIFT) & TAA3040_CHANNEL_IMPEDANCE_MASK)
-                        | (c->dc_coupled? TAA3040_CHANNEL_COUPLING_MASK : 0)
-                        | ((c->mode << TAA3040_CHANNEL_SOURCE_SHIFT) & TAA3040_CHANNEL_SOURCE_MASK)
-                        | (c->is_microphone? 0: TAA3040_CHANNEL_INPUT_TYPE_MASK);
-    if(!taa3040_write_reg(dev, config_reg, cfg0))
+    if(!taa3040_select_page(dev, 0))
         return false;
 
-    const uint8_t gain_reg = TAA3040_REG_CH_GAIN(ch);
-    const uint8_t cfg1 = (c->gain_db << TAA3040_CHANNEL_GAIN_SHIFT) & TAA3040_CHANNEL_GAIN_MASK;
-    if(!taa3040_write_reg(dev, gain_reg, cfg1))
-        return false;
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+    taa3040_encode_channel_config(ch, c, page0);
 
-    const uint8_t volume_reg = TAA3040_REG_CH_VOLUME(ch);
-    const uint8_t cfg2 = (c->digital_volume_setting << TAA3040_CHANNEL_VOLUME_SHIFT) & TAA3040_CHANNEL_VOLUME_MASK;
-    if(!taa3040_write_reg(dev, volume_reg, cfg2))
-        return false;
-    
-    const uint8_t gain_cal_reg = TAA3040_REG_CH_GAIN_CAL(ch);
-    const uint8_t cfg3 = (c->advanced.gain_calibration << TAA3040_CHANNEL_GAIN_CAL_SHIFT) & TAA3040_CHANNEL_GAIN_CAL_MASK;
-    if(!taa3040_write_reg(dev, gain_cal_reg, cfg3))
-        return false;
-    
-    const uint8_t phase_cal_reg = TAA3040_REG_CH_PHASE_CAL(ch);
-    const uint8_t cfg4 = (c->advanced.phase_calibration << TAA3040_CHANNEL_PHASE_CAL_SHIFT) & TAA3040_CHANNEL_PHASE_CAL_MASK;
-    if(!taa3040_write_reg(dev, phase_cal_reg, cfg4))
+    if(!taa3040_write(dev, TAA3040_REG_CH_CONFIG(ch), &page0[TAA3040_REG_CH_CONFIG(ch)], TAA3040_CHANNEL_REGISTER_ENTRIES))
         return false;
 
-    return c->enabled? taa3040_enable_channel(dev, ch): true;
+    return c->enabled? taa3040_enable_channel(dev, ch): taa3040_disable_channel(dev, ch);
 }
 bool taa3040_get_channel_config(const taa3040_t *const dev, uint8_t ch, taa3040_channel_config_t *const c) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_CHANNEL_CONFIG);
     if(!dev||!c||ch>=TAA3040_NUM_CHANNELS) 
         return false;
     
     memset(c, 0, sizeof(*c)); 
     
-    taa3040_select_page(dev,0);
+    if(!taa3040_select_page(dev, 0))
+        return false;
     
-    uint8_t v;
-    if(!taa3040_read_reg(dev, TAA3040_REG_CH_CONFIG(ch),&v)) 
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    if(!taa3040_read(dev, TAA3040_REG_CH_CONFIG(ch), &page0[TAA3040_REG_CH_CONFIG(ch)], TAA3040_CHANNEL_REGISTER_ENTRIES))
         return false;
 
-    c->automatic_gain_control= !!(v & TAA3040_CHANNEL_AGC_EN_MASK);
-    c->input_impedance = (v & TAA3040_CHANNEL_IMPEDANCE_MASK) >> TAA3040_CHANNEL_IMPEDANCE_SHIFT;
-    c->dc_coupled = !!(v & TAA3040_CHANNEL_COUPLING_MASK);
-    c->mode = (v & TAA3040_CHANNEL_SOURCE_MASK) >> TAA3040_CHANNEL_SOURCE_SHIFT;
+    if(!taa3040_read_reg(dev, TAA3040_REG_IN_CHANNEL_EN, &page0[TAA3040_REG_IN_CHANNEL_EN]))
+        return false;
 
-    if(!taa3040_read_reg(dev, TAA3040_REG_CH_GAIN(ch), &v)) 
-        return false; 
+    taa3040_decode_channel_config(page0, ch, c);
+    return true;
+}
+bool taa3040_set_channel_configs(const taa3040_t *const dev, const taa3040_channel_config_t c[TAA3040_NUM_CHANNELS])
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_CHANNEL_CONFIGS);
+    if(!dev || !c)
+        return false;
 
-    c->gain_db = (v & TAA3040_CHANNEL_GAIN_MASK) >> TAA3040_CHANNEL_GAIN_SHIFT;
-    
-    if(!taa3040_read_reg(dev, TAA3040_REG_CH_VOLUME(ch), &v)) 
-        return false; 
-    
-    c->digital_volume_setting = (v & TAA3040_CHANNEL_VOLUME_MASK) >> TAA3040_CHANNEL_VOLUME_SHIFT;
+    // Every enable bit comes from the configurations, so IN_CHANNEL_EN needs no read
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+    for(uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+        taa3040_encode_channel_config(ch, &c[ch], page0);
 
-    if(!taa3040_read_reg(dev,TAA3040_REG_CH_GAIN_CAL(ch), &v))
-        return false; 
-    
-    c->advanced.gain_calibration = (v & TAA3040_CHANNEL_GAIN_CAL_MASK) >> TAA3040_CHANNEL_GAIN_CAL_SHIFT;
-    
-    if(!taa3040_read_reg(dev, TAA3040_REG_CH_PHASE_CAL(ch), &v))
-        return false; 
-    
-    c->advanced.phase_calibration = (v & TAA3040_CHANNEL_PHASE_CAL_MASK) >> TAA3040_CHANNEL_PHASE_CAL_SHIFT;
+    return taa3040_select_page(dev, 0)
+        && taa3040_write(dev, TAA3040_BLOCK_CHANNEL_START, &page0[TAA3040_BLOCK_CHANNEL_START], TAA3040_BLOCK_CHANNEL_LENGTH)
+        && taa3040_write_reg(dev, TAA3040_REG_IN_CHANNEL_EN, page0[TAA3040_REG_IN_CHANNEL_EN]);
+}
+bool taa3040_get_channel_configs(const taa3040_t *const dev, taa3040_channel_config_t c[TAA3040_NUM_CHANNELS])
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_CHANNEL_CONFIGS);
+    if(!dev || !c)
+        return false;
 
+    if(!taa3040_select_page(dev, 0))
+        return false;
+
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    if(!taa3040_read(dev, TAA3040_BLOCK_CHANNEL_START, &page0[TAA3040_BLOCK_CHANNEL_START], TAA3040_BLOCK_CHANNEL_LENGTH)
+    || !taa3040_read_reg(dev, TAA3040_REG_IN_CHANNEL_EN, &page0[TAA3040_REG_IN_CHANNEL_EN]))
+        return false;
+
+    for(uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        memset(&c[ch], 0, sizeof(c[ch]));
+        taa3040_decode_channel_config(page0, ch, &c[ch]);
+    }
     return true;
 }
 
 /* === Mixer Configuration === */
 bool taa3040_set_mixer_channel_config(const taa3040_t *const dev, uint8_t ch, const taa3040_mixer_channel_config_t *const m) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_MIXER_CHANNEL_CONFIG);
     if(!dev || !m || ch >= TAA3040_NUM_CHANNELS) 
         return false;
 
@@ -339,24 +388,27 @@ bool taa3040_set_mixer_channel_config(const taa3040_t *const dev, uint8_t ch, co
     
     const uint8_t base = TAA3040_REG_MIXER_MATRIX_BASE + ch * TAA3040_MIXER_CHANNEL_STRIDE;
     
-    dev->hal.i2c_write(dev->address, base, m->coefficients, TAA3040_NUM_CHANNELS);
+    if(!taa3040_write(dev, base, (const uint8_t*)m->coefficients, TAA3040_NUM_CHANNELS))
+        return false;
  
     return taa3040_select_page(dev, 0);
 }
 bool taa3040_get_mixer_channel_config(const taa3040_t *const dev, uint8_t ch, taa3040_mixer_channel_config_t *const m) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_MIXER_CHANNEL_CONFIG);
     if(!dev || !m || ch >= TAA3040_NUM_CHANNELS) 
         return false;
 
     taa3040_select_page(dev,TAA3040_PAGE_MIXER_CONTROL);
     
     const uint8_t base = TAA3040_REG_MIXER_MATRIX_BASE + ch * TAA3040_MIXER_CHANNEL_STRIDE;
-    dev->hal.i2c_read(dev->address, base, m->coefficients, TAA3040_NUM_CHANNELS); 
+    taa3040_read(dev, base, m->coefficients, TAA3040_NUM_CHANNELS); 
     
     return taa3040_select_page(dev, 0);
 }
 bool taa3040_set_mixer_config(const taa3040_t *const dev, const taa3040_mixer_config_t *const M) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_MIXER_CONFIG);
     for(int ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
     {
         if(!taa3040_set_mixer_channel_config(dev, ch, &M->channels[ch]))
@@ -366,302 +418,229 @@ bool taa3040_set_mixer_config(const taa3040_t *const dev, const taa3040_mixer_co
 }
 bool taa3040_get_mixer_config(const taa3040_t *const dev, taa3040_mixer_config_t *const M) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_MIXER_CONFIG);
+    if(!dev || !M)
+        return false;
+
+    uint8_t regs[TAA3040_BLOCK_MIXER_LENGTH];
+    if(!taa3040_select_page(dev, TAA3040_PAGE_MIXER_CONTROL))
+        return false;
+
+    const bool read = taa3040_read(dev, TAA3040_REG_MIXER_MATRIX_BASE, regs, sizeof(regs));
+    if(!taa3040_select_page(dev, 0) || !read)
+        return false;
+
     for(int ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
-    {
-        if(!taa3040_get_mixer_channel_config(dev, ch, &M->channels[ch]))
-            return false;
-    }
+        memcpy(M->channels[ch].coefficients, &regs[ch * TAA3040_MIXER_CHANNEL_STRIDE], TAA3040_NUM_MIXERS);
+
     return true;
 }
 
 /* === GPIO & Interrupt Configuration === */
 bool taa3040_set_gpio_config(const taa3040_t *const dev, const taa3040_gpio_config_t *const g) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_GPIO_CONFIG);
     if(!dev || !g) 
         return false;
 
-    taa3040_select_page(dev, 0);
-    
-    for(int i = 0; i < TAA3040_NUM_GPO; ++i)
-    {
-        const uint8_t v = ((g->gpo_configs[i].mode << TAA3040_GPO_CONFIG_SHIFT) & TAA3040_GPO_CONFIG_MASK)
-                        | ((g->gpo_configs[i].drive << TAA3040_GPO_DRIVE_MODE_SHIFT) & TAA3040_GPO_DRIVE_MODE_MASK);
-        if(!taa3040_write_reg(dev,TAA3040_REG_GPO_CONFIG_BASE + i,v))
-            return false;
-    }
-    for(int i = 0; i < TAA3040_NUM_GPI; ++i)
-    {
-        const uint8_t addr = TAA3040_REG_GPI_CONFIG_BASE + (i/2);
-        uint8_t v; 
-        if(!taa3040_read_reg(dev, addr, &v))
-            return false;
+    if(!taa3040_select_page(dev, 0))
+        return false;
 
-        const uint8_t shift = (i % 2)? TAA3040_GPI1_CONFIG_SHIFT: TAA3040_GPI2_CONFIG_SHIFT;
-        const uint8_t mask = (i % 2)? TAA3040_GPI1_CONFIG_MASK: TAA3040_GPI2_CONFIG_MASK;
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+    taa3040_encode_gpio_config(g, page0);
 
-        v &= ~mask; // clear the mask bits
-        v |= ((g->gpi_modes[i] << shift) & mask);
+    for(int i = 0; i < TAA3040_NUM_GPO; ++i)
+        if(!taa3040_write_reg(dev, TAA3040_REG_GPO_CONFIG_BASE + i, page0[TAA3040_REG_GPO_CONFIG_BASE + i]))
+            return false;
 
-        if(!taa3040_write_reg(dev,addr,v))
+    // Both GPI configuration registers only hold GPI modes, so they are written whole
+    for(int i = 0; i < TAA3040_NUM_GPI / 2; ++i)
+        if(!taa3040_write_reg(dev, TAA3040_REG_GPI_CONFIG_BASE + i, page0[TAA3040_REG_GPI_CONFIG_BASE + i]))
             return false;
-    }
+
     return true;
 }
 bool taa3040_get_gpio_config(const taa3040_t* const dev, taa3040_gpio_config_t* const g) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_GPIO_CONFIG);
     if(!dev || !g) 
         return false;
 
-    taa3040_select_page(dev, 0);
+    if(!taa3040_select_page(dev, 0))
+        return false;
     
-    for(int i = 0; i < TAA3040_NUM_GPO; ++i)
-    { 
-        uint8_t v; 
-        if(!taa3040_read_reg(dev, TAA3040_REG_GPO_CONFIG_BASE + i, &v))
-            return false;
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    if(!taa3040_read(dev, TAA3040_BLOCK_GPIO_START, &page0[TAA3040_BLOCK_GPIO_START], TAA3040_BLOCK_GPIO_LENGTH))
+        return false;
 
-        g->gpo_configs[i].mode = (v & TAA3040_GPO_CONFIG_MASK) >> TAA3040_GPO_CONFIG_SHIFT;
-        g->gpo_configs[i].drive =(v & TAA3040_GPO_DRIVE_MODE_MASK) >> TAA3040_GPO_DRIVE_MODE_SHIFT;
-    }
-    for(int i = 0;  i < TAA3040_NUM_GPI; ++i)
-    { 
-        const uint8_t addr = TAA3040_REG_GPI_CONFIG_BASE+(i/2);
-        
-        uint8_t v;
-        if(!taa3040_read_reg(dev,addr,&v))
-            return false;
-        
-        const uint8_t shift = (i % 2)? TAA3040_GPI1_CONFIG_SHIFT: TAA3040_GPI2_CONFIG_SHIFT;
-        const uint8_t mask = (i % 2)? TAA3040_GPI1_CONFIG_MASK: TAA3040_GPI2_CONFIG_MASK;
-        
-        g->gpi_modes[i]=(v & mask) >> shift;
-    }
+    taa3040_decode_gpio_config(page0, g);
     return true;
 }
 bool taa3040_set_interrupt_config(const taa3040_t* const dev, const taa3040_interrupt_config_t* const i) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_INTERRUPT_CONFIG);
     if(!dev || !i) 
         return false;
 
-    taa3040_select_page(dev,0);
-
-    uint8_t cfg=((i->polarity << TAA3040_INTERRUPT_POLARITY_SHIFT) & TAA3040_INTERRUPT_POLARITY_MASK)
-              | ((i->event << TAA3040_INTERRUPT_EVENT_SHIFT) & TAA3040_INTERRUPT_EVENT_MASK)
-              | (i->latch_enable? TAA3040_INTERRUPT_LATCH_MASK : 0);
-    
-    if(!taa3040_write_reg(dev, TAA3040_REG_INTERRUPT_CONFIG, cfg))
+    if(!taa3040_select_page(dev, 0))
         return false;
 
-    uint8_t m = (i->mask_pll_interrupt? TAA3040_INTERRUPT_PLL_ERROR_MASK: 0)
-            |   (i->mask_asi_interrupt? TAA3040_INTERRUPT_ASI_ERROR_MASK : 0);
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+    taa3040_encode_interrupt_config(i, page0);
 
-    if(!taa3040_write_reg(dev,TAA3040_REG_INTERRUPT_MASK,m))
-        return false;
-    
-    uint8_t l = (i->latch_pll_interrupt? TAA3040_INTERRUPT_PLL_ERROR_MASK: 0)
-            |   (i->latch_asi_interrupt? TAA3040_INTERRUPT_ASI_ERROR_MASK: 0);
-    
-            return taa3040_write_reg(dev,TAA3040_REG_INTERRUPT_LATCH,l);
+    return taa3040_write_reg(dev, TAA3040_REG_INTERRUPT_CONFIG, page0[TAA3040_REG_INTERRUPT_CONFIG])
+        && taa3040_write_reg(dev, TAA3040_REG_INTERRUPT_MASK, page0[TAA3040_REG_INTERRUPT_MASK])
+        && taa3040_write_reg(dev, TAA3040_REG_INTERRUPT_LATCH, page0[TAA3040_REG_INTERRUPT_LATCH]);
 }
 
 bool taa3040_get_interrupt_config(const taa3040_t* const dev, taa3040_interrupt_config_t* const i) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_INTERRUPT_CONFIG);
     if(!dev||!i) 
         return false;
 
-    taa3040_select_page(dev,0);
-    
-    uint8_t v; 
-    if(!taa3040_read_reg(dev, TAA3040_REG_INTERRUPT_CONFIG, &v))
-        return false;
-
-    i->polarity = (v & TAA3040_INTERRUPT_POLARITY_MASK) >> TAA3040_INTERRUPT_POLARITY_SHIFT;
-    i->event = (v & TAA3040_INTERRUPT_EVENT_MASK) >> TAA3040_INTERRUPT_EVENT_SHIFT;
-    i->latch_enable = !!(v & TAA3040_INTERRUPT_LATCH_MASK);
-    
-    if(!taa3040_read_reg(dev, TAA3040_REG_INTERRUPT_MASK, &v))
+    if(!taa3040_select_page(dev, 0))
         return false;
-
-    i->mask_pll_interrupt = !!(v & TAA3040_INTERRUPT_PLL_ERROR_MASK);
-    i->mask_asi_interrupt = !!(v & TAA3040_INTERRUPT_ASI_ERROR_MASK);
     
-    if(!taa3040_read_reg(dev,TAA3040_REG_INTERRUPT_LATCH,&v))
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    const uint8_t length = TAA3040_BLOCK_GPIO_END - TAA3040_REG_INTERRUPT_CONFIG + 1;
+    if(!taa3040_read(dev, TAA3040_REG_INTERRUPT_CONFIG, &page0[TAA3040_REG_INTERRUPT_CONFIG], length))
         return false;
 
-    i->latch_pll_interrupt = !!(v & TAA3040_INTERRUPT_PLL_ERROR_MASK);
-    i->latch_asi_interrupt = !!(v & TAA3040_INTERRUPT_ASI_ERROR_MASK);
-
+    taa3040_decode_interrupt_config(page0, i);
     return true;
 }
 
 /* === Gain & Volume === */
 bool taa3040_set_dsp_config(const taa3040_t* const dev, const taa3040_dsp_config_t* const dsp) 
 {
-    if (!taa3040_select_page(dev, 0)) 
-        return false;
-    // DSP_CONFIG0: DECIMATION_FILTER (7-6), CHANNEL_SUMMING (5-4), HPF (1-0)
-    const uint8_t cfg0 =  ((dsp->decimation_filter << TAA3040_DECIMATION_FILTER_SHIFT) & TAA3040_DECIMATION_FILTER_MASK)
-                        | ((dsp->channel_summing    << TAA3040_CHANNEL_SUM_MODE_SHIFT) & TAA3040_CHANNEL_SUM_MODE_MASK)
-                        | ((dsp->high_pass_filter  << TAA3040_HIGH_PASS_FILTER_SHIFT) & TAA3040_HIGH_PASS_FILTER_MASK);
-    if (!taa3040_write_reg(dev, TAA3040_REG_DSP_CONFIG0, cfg0)) 
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_DSP_CONFIG);
+    if (!dev || !dsp)
         return false;
 
-    // DSP_CONFIG1: VOLUME_GANGED (7), BIQUADS (6-5), SOFT_SWEEP (4), AGC_SELECT (3)
-    const uint8_t cfg1 =  (dsp->volume_ganged ? (1 << 7) : 0)
-                        | ((dsp->biquads_per_channel << 5) & 0x60)
-                        | (dsp->advanced.soft_stepping ? 0 : (1 << 4))
-                        | (dsp->automatic_gain_control ? (1 << 3) : 0);
-    if (!taa3040_write_reg(dev, TAA3040_REG_DSP_CONFIG1, cfg1)) 
+    if (!taa3040_select_page(dev, 0)) 
         return false;
 
-    // AGC config
-    uint8_t agc_val = ((dsp->advanced.automatic_gain_control_level  << TAA3040_AGC_LEVEL_SHIFT) & TAA3040_AGC_LEVEL_MASK)
-                    | ((dsp->advanced.automatic_gain_control_max_gain << TAA3040_AGC_MAX_GAIN_SHIFT) & TAA3040_AGC_MAX_GAIN_MASK);
-    
-    if (!taa3040_write_reg(dev, TAA3040_REG_AGC_CONFIG, agc_val)) 
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+    taa3040_encode_dsp_config(dsp, page0);
+
+    if (!taa3040_write_reg(dev, TAA3040_REG_DSP_CONFIG0, page0[TAA3040_REG_DSP_CONFIG0])
+    ||  !taa3040_write_reg(dev, TAA3040_REG_DSP_CONFIG1, page0[TAA3040_REG_DSP_CONFIG1])
+    ||  !taa3040_write_reg(dev, TAA3040_REG_AGC_CONFIG, page0[TAA3040_REG_AGC_CONFIG]))
         return false;
+
     // Custom HPF
     if (dsp->high_pass_filter == TAA3040_HIGH_PASS_FILTER_CUSTOM) 
     {
+        uint8_t b[TAA3040_BLOCK_IIR_LENGTH];
+        taa3040_encode_iir(&dsp->advanced.custom_high_pass_filter, b);
+
         if (!taa3040_select_page(dev, TAA3040_PAGE_IIR_COEFF)) 
             return false;
-        if (!taa3040_write_i32(dev, TAA3040_REG_IIR_N0, dsp->advanced.custom_high_pass_filter.n0)) return false;
-        if (!taa3040_write_i32(dev, TAA3040_REG_IIR_N1, dsp->advanced.custom_high_pass_filter.n1)) return false;
-        if (!taa3040_write_i32(dev, TAA3040_REG_IIR_D1, dsp->advanced.custom_high_pass_filter.d1)) return false;
-        if (!taa3040_select_page(dev, 0)) 
+        const bool written = taa3040_write(dev, TAA3040_REG_IIR_COEFF_START, b, sizeof(b));
+        if (!taa3040_select_page(dev, 0) || !written) 
             return false;
     }
     return true;
 }
 bool taa3040_get_dsp_config(const taa3040_t* const dev, taa3040_dsp_config_t* const dsp) 
 {
-    if (!taa3040_select_page(dev, 0)) 
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_DSP_CONFIG);
+    if (!dev || !dsp)
         return false;
 
-    uint8_t cfg0;
-    if (!taa3040_read_reg(dev, TAA3040_REG_DSP_CONFIG0, &cfg0)) 
+    if (!taa3040_select_page(dev, 0)) 
         return false;
-    
-    dsp->decimation_filter = (taa3040_decimation_filter_t)((cfg0 & TAA3040_DECIMATION_FILTER_MASK) >> TAA3040_DECIMATION_FILTER_SHIFT);
-    dsp->channel_summing   = (taa3040_channel_summing_mode_t)((cfg0 & TAA3040_CHANNEL_SUM_MODE_MASK) >> TAA3040_CHANNEL_SUM_MODE_SHIFT);
-    dsp->high_pass_filter  = (taa3040_high_pass_filter_t)((cfg0 & TAA3040_HIGH_PASS_FILTER_MASK) >> TAA3040_HIGH_PASS_FILTER_SHIFT);
 
-    uint8_t cfg1;
-    if (!taa3040_read_reg(dev, TAA3040_REG_DSP_CONFIG1, &cfg1)) 
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    const uint8_t length = TAA3040_REG_AGC_CONFIG - TAA3040_BLOCK_DSP_START + 1;
+    if (!taa3040_read(dev, TAA3040_BLOCK_DSP_START, &page0[TAA3040_BLOCK_DSP_START], length))
         return false;
 
-    dsp->volume_ganged            = !!(cfg1 & TAA3040_VOLUME_GANGED_MASK);
-    dsp->biquads_per_channel      = (cfg1 & TAA3040_BIQUAD_COUNT_MASK) >> TAA3040_BIQUAD_COUNT_SHIFT;
-    dsp->advanced.soft_stepping   = !(cfg1 & TAA3040_SOFT_STEP_MASK);
-    dsp->automatic_gain_control   = !!(cfg1 & TAA3040_AGC_SELECT_MASK);
+    taa3040_decode_dsp_config(page0, dsp);
 
-    uint8_t agc_val;
-    if (!taa3040_read_reg(dev, TAA3040_REG_AGC_CONFIG, &agc_val)) 
-        return false;
-    
-    dsp->advanced.automatic_gain_control_level    = (agc_val & TAA3040_AGC_LEVEL_MASK) >> TAA3040_AGC_LEVEL_SHIFT;
-    dsp->advanced.automatic_gain_control_max_gain =  agc_val & TAA3040_AGC_MAX_GAIN_MASK;
     if (dsp->high_pass_filter == TAA3040_HIGH_PASS_FILTER_CUSTOM) 
-    {
-        if (!taa3040_select_page(dev, TAA3040_PAGE_IIR_COEFF)) 
-            return false;
-        
-        if (!taa3040_read_i32(dev, TAA3040_REG_IIR_N0, &dsp->advanced.custom_high_pass_filter.n0)) return false;
-        if (!taa3040_read_i32(dev, TAA3040_REG_IIR_N1, &dsp->advanced.custom_high_pass_filter.n1)) return false;
-        if (!taa3040_read_i32(dev, TAA3040_REG_IIR_D1, &dsp->advanced.custom_high_pass_filter.d1)) return false;
-        
-        if (!taa3040_select_page(dev, 0)) 
-            return false;
-    }
+        return taa3040_read_custom_hpf(dev, &dsp->advanced.custom_high_pass_filter);
+
     return true;
 }
 
 bool taa3040_set_system_config(const taa3040_t* const dev, const taa3040_system_config_t* const config)
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_SYSTEM_CONFIG);
+    if(!dev || !config)
+        return false;
+
     if(!taa3040_select_page(dev, 0))
-    {
-        return 1;
-    }
+        return false;
 
-    const uint8_t pwr_reg = (config->adc_enabled? TAA3040_ADC_ENABLE_MASK: 0)
-                        |   (config->pll_enabled? TAA3040_PLL_ENABLE_MASK: 0)
-                        |   (config->mic_bias_enabled? TAA3040_MIC_BIAS_ENABLE_MASK: 0)
-                        |   (config->dynamic_power_mode? TAA3040_DYNAMIC_POWER_MASK: 0)
-                        |   ((config->advanced.dynamic_mode_channels << TAA3040_DYNAMIC_POWER_CHANNELS_SHIFT) & TAA3040_DYNAMIC_POWER_CHANNELS_MASK);
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+    taa3040_encode_system_config(config, page0);
 
-    if(!taa3040_write_reg(dev, TAA3040_REG_POWER_CONFIG, pwr_reg))
-    {
+    // PDMCLK_CONFIG and PDMIN_CONFIG are adjacent, program the PDM clock and edges together,
+    // before POWER_CONFIG so the modulators never run on the old PDM clock
+    if(!taa3040_write(dev, TAA3040_REG_PDMCLK_CONFIG, &page0[TAA3040_REG_PDMCLK_CONFIG], 2))
         return false;
-    }
 
-    uint8_t sleep_cfg;
-    if(!taa3040_read_reg(dev, TAA3040_REG_SLEEP_CFG, &sleep_cfg))
-    {
+    if(!taa3040_write_reg(dev, TAA3040_REG_POWER_CONFIG, page0[TAA3040_REG_POWER_CONFIG]))
         return false;
-    }
-
-    const uint8_t sleep_cfg_reg  =  (config->avdd_is_3v3? TAA3040_AREG_SELECT_MASK: 0)
-                                |   ((config->advanced.vref_qc_time << TAA3040_VREF_QCHRG_SHIFT) & TAA3040_VREF_QCHRG_MASK);
 
-    if (!taa3040_write_reg(dev, TAA3040_REG_SLEEP_CFG, sleep_cfg_reg))
-    {
+    // Sleep state is owned by taa3040_sleep/taa3040_wake, keep whatever it currently is
+    uint8_t sleep_cfg;
+    if(!taa3040_read_reg(dev, TAA3040_REG_SLEEP_CFG, &sleep_cfg))
         return false;
-    }
 
-    const uint8_t shutdown_cfg =    ((config->shutdown_mode << TAA3040_SHDNZ_CFG_SHIFT) & TAA3040_SHDNZ_CFG_MASK)
-                                |   ((config->advanced.input_qc_time << TAA3040_INCAP_QCHG_SHIFT) & TAA3040_INCAP_QCHG_MASK)
-                                |   ((config->advanced.dreg_shutdown_time << TAA3040_DREG_KA_TIME_SHIFT) & TAA3040_DREG_KA_TIME_MASK);
-    if(!taa3040_write_reg(dev, TAA3040_REG_SHUTDOWN_CFG, shutdown_cfg))
-    {
+    const uint8_t sleep_cfg_reg = (page0[TAA3040_REG_SLEEP_CFG] & ~TAA3040_SLEEP_DISABLE_MASK) | (sleep_cfg & TAA3040_SLEEP_DISABLE_MASK);
+    if(!taa3040_write_reg(dev, TAA3040_REG_SLEEP_CFG, sleep_cfg_reg))
         return false;
-    }
 
-    return true;
+    return taa3040_write_reg(dev, TAA3040_REG_SHUTDOWN_CFG, page0[TAA3040_REG_SHUTDOWN_CFG]);
 }
 
 bool taa3040_get_filter(const taa3040_t* const dev, const uint8_t index, taa3040_biquad_filter_t* const filter)
 {
-    if (!dev || index > TAA3040_NUM_BIQUADS || !filter)
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_FILTER);
+    if (!dev || index >= TAA3040_NUM_BIQUADS || !filter)
         return 0;
 
-    const uint8_t page = index > 6? TAA3040_PAGE_BIQUAD_FILTER_2: TAA3040_PAGE_BIQUAD_FILTER_1;
-    const uint8_t base_address = TAA3040_REG_BIQUAD_COEFF_BASE + TAA3040_BIQUAD_COEFF_WORDS_PER_SECTION * sizeof(int32_t) * (index % 6);
+    const uint8_t page = index >= TAA3040_BIQUADS_PER_PAGE? TAA3040_PAGE_BIQUAD_FILTER_2: TAA3040_PAGE_BIQUAD_FILTER_1;
+    const uint8_t base_address = TAA3040_REG_BIQUAD_COEFF_BASE + TAA3040_BIQUAD_SECTION_BYTES * (index % TAA3040_BIQUADS_PER_PAGE);
 
     if(!taa3040_select_page(dev, page))
         return false;
 
-    if(!taa3040_read_i32(dev, base_address, &filter->n0)) return false;
-    if(!taa3040_read_i32(dev, base_address + sizeof(int32_t), &filter->n1)) return false;
-    if(!taa3040_read_i32(dev, base_address + 2 * sizeof(int32_t), &filter->n2)) return false;
-    if(!taa3040_read_i32(dev, base_address + 3 * sizeof(int32_t), &filter->d1)) return false;
-    if(!taa3040_read_i32(dev, base_address + 4 * sizeof(int32_t), &filter->d2)) return false;
+    uint8_t b[TAA3040_BIQUAD_SECTION_BYTES];
+    const bool read = taa3040_read(dev, base_address, b, sizeof(b));
+    if(!taa3040_select_page(dev, 0) || !read)
+        return false;
 
+    taa3040_decode_biquad(b, filter);
     return true;
 }
 
 bool taa3040_set_filter(const taa3040_t* const dev, const uint8_t index, taa3040_biquad_filter_t* const filter)
 {
-    if (!dev || index > TAA3040_NUM_BIQUADS || !filter)
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_FILTER);
+    if (!dev || index >= TAA3040_NUM_BIQUADS || !filter)
         return 0;
         
-    const uint8_t page = index > 6? TAA3040_PAGE_BIQUAD_FILTER_2: TAA3040_PAGE_BIQUAD_FILTER_1;
-    const uint8_t base_address = TAA3040_REG_BIQUAD_COEFF_BASE + TAA3040_BIQUAD_COEFF_WORDS_PER_SECTION * sizeof(int32_t) * (index % 6);
+    const uint8_t page = index >= TAA3040_BIQUADS_PER_PAGE? TAA3040_PAGE_BIQUAD_FILTER_2: TAA3040_PAGE_BIQUAD_FILTER_1;
+    const uint8_t base_address = TAA3040_REG_BIQUAD_COEFF_BASE + TAA3040_BIQUAD_SECTION_BYTES * (index % TAA3040_BIQUADS_PER_PAGE);
+
+    uint8_t b[TAA3040_BIQUAD_SECTION_BYTES];
+    taa3040_encode_biquad(filter, b);
 
     if(!taa3040_select_page(dev, page))
         return false;
 
-    if(!taa3040_write_i32(dev, base_address, filter->n0)) return false;
-    if(!taa3040_write_i32(dev, base_address + sizeof(int32_t), filter->n1)) return false;
-    if(!taa3040_write_i32(dev, base_address + 2 * sizeof(int32_t), filter->n2)) return false;
-    if(!taa3040_write_i32(dev, base_address + 3 * sizeof(int32_t), filter->d1)) return false;
-    if(!taa3040_write_i32(dev, base_address + 4 * sizeof(int32_t), filter->d2)) return false;
-
-    return true;
+    const bool written = taa3040_write(dev, base_address, b, sizeof(b));
+    return taa3040_select_page(dev, 0) && written;
 }
 
 /* === Gain & Volume === */
 bool taa3040_set_gain_db(const taa3040_t *const dev, uint8_t ch, uint8_t g) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_GAIN_DB);
     if(!dev || ch >= TAA3040_NUM_CHANNELS)
         return false;
 
@@ -671,6 +650,7 @@ bool taa3040_set_gain_db(const taa3040_t *const dev, uint8_t ch, uint8_t g)
 
 bool taa3040_get_gain_db(const taa3040_t *const dev, uint8_t ch, uint8_t *g) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_GAIN_DB);
     if(!dev || !g || ch >= TAA3040_NUM_CHANNELS) 
         return false;
     uint8_t v; 
@@ -682,6 +662,7 @@ bool taa3040_get_gain_db(const taa3040_t *const dev, uint8_t ch, uint8_t *g)
 
 bool taa3040_set_digital_volume(const taa3040_t *const dev, uint8_t ch, uint8_t vcode) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_DIGITAL_VOLUME);
     if(!dev || ch >= TAA3040_NUM_CHANNELS) 
         return false;
 
@@ -690,6 +671,7 @@ bool taa3040_set_digital_volume(const taa3040_t *const dev, uint8_t ch, uint8_t
 
 bool taa3040_get_digital_volume(const taa3040_t *const dev, uint8_t ch, uint8_t *vcode) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_DIGITAL_VOLUME);
     if(!dev || !vcode || ch >= TAA3040_NUM_CHANNELS) 
         return false;
 
@@ -701,8 +683,69 @@ bool taa3040_get_digital_volume(const taa3040_t *const dev, uint8_t ch, uint8_t
     return true;
 }
 
+bool taa3040_set_levels(const taa3040_t *const dev, const uint8_t mask, const float gain_db[TAA3040_NUM_CHANNELS],
+                        const float volume_db[TAA3040_NUM_CHANNELS])
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_LEVELS);
+    if(!dev || !gain_db || !volume_db)
+        return false;
+    if(!mask)
+        return true;
+
+    uint8_t first = 0, last = TAA3040_NUM_CHANNELS - 1;
+    while(!(mask & TAA3040_CHANNEL_BIT(first)))
+        ++first;
+    while(!(mask & TAA3040_CHANNEL_BIT(last)))
+        --last;
+
+    // The span from the first gain to the last volume also covers the registers of the
+    // channels in between, which go back unchanged
+    const uint8_t start = TAA3040_REG_CH_GAIN(first);
+    const uint8_t length = (uint8_t)(TAA3040_REG_CH_VOLUME(last) - start + 1);
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    if(!taa3040_select_page(dev, 0) || !taa3040_read(dev, start, &page0[start], length))
+        return false;
+
+    for(uint8_t ch = first; ch <= last; ++ch)
+    {
+        if(!(mask & TAA3040_CHANNEL_BIT(ch)))
+            continue;
+
+        const uint8_t g = taa3040_gain_code(gain_db[ch]);
+        page0[TAA3040_REG_CH_GAIN(ch)] = (page0[TAA3040_REG_CH_GAIN(ch)] & ~TAA3040_CHANNEL_GAIN_MASK)
+                                       | ((g << TAA3040_CHANNEL_GAIN_SHIFT) & TAA3040_CHANNEL_GAIN_MASK);
+        page0[TAA3040_REG_CH_VOLUME(ch)] = taa3040_volume_code(volume_db[ch]);
+    }
+
+    return taa3040_write(dev, start, &page0[start], length);
+}
+
+bool taa3040_get_levels(const taa3040_t *const dev, float gain_db[TAA3040_NUM_CHANNELS], float volume_db[TAA3040_NUM_CHANNELS])
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_LEVELS);
+    if(!dev || (!gain_db && !volume_db))
+        return false;
+
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    if(!taa3040_select_page(dev, 0)
+    || !taa3040_read(dev, TAA3040_BLOCK_CHANNEL_START, &page0[TAA3040_BLOCK_CHANNEL_START], TAA3040_BLOCK_CHANNEL_LENGTH))
+        return false;
+
+    for(uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        if(gain_db)
+            gain_db[ch] = (float)((page0[TAA3040_REG_CH_GAIN(ch)] & TAA3040_CHANNEL_GAIN_MASK) >> TAA3040_CHANNEL_GAIN_SHIFT);
+
+        const uint8_t v = page0[TAA3040_REG_CH_VOLUME(ch)];
+        if(volume_db)
+            volume_db[ch] = v == TAA3040_CHANNEL_VOLUME_MUTE? -INFINITY: 0.5f * ((int)v - TAA3040_CHANNEL_VOLUME_0DB);
+    }
+    return true;
+}
+
 bool taa3040_enable_channel(const taa3040_t* const dev, const uint8_t ch) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_ENABLE_CHANNEL);
     if(!dev || ch >= TAA3040_NUM_CHANNELS)
         return false;
     
@@ -710,12 +753,13 @@ bool taa3040_enable_channel(const taa3040_t* const dev, const uint8_t ch)
     if(!taa3040_read_reg(dev, TAA3040_REG_IN_CHANNEL_EN, &v))
         return false;
     
-    const uint8_t reg_val = (v | (1 << (TAA3040_NUM_CHANNELS - ch - 1)));
-    return taa3040_write_reg(dev, TAA3040_REG_ASI_OUT_CHANNEL_EN, reg_val);
+    const uint8_t reg_val = (v | TAA3040_CHANNEL_BIT(ch));
+    return taa3040_write_reg(dev, TAA3040_REG_IN_CHANNEL_EN, reg_val);
 }
 
 bool taa3040_disable_channel(const taa3040_t* const dev, const uint8_t channel)
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_DISABLE_CHANNEL);
     if(!dev || channel >= TAA3040_NUM_CHANNELS)
         return false;
     
@@ -723,38 +767,39 @@ bool taa3040_disable_channel(const taa3040_t* const dev, const uint8_t channel)
     if(!taa3040_read_reg(dev, TAA3040_REG_IN_CHANNEL_EN, &v))
         return false;
     
-    const uint8_t reg_val = (v & ~(1 << (TAA3040_NUM_CHANNELS - channel - 1)));
-    return taa3040_write_reg(dev, TAA3040_REG_ASI_OUT_CHANNEL_EN, reg_val);
+    const uint8_t reg_val = (v & ~TAA3040_CHANNEL_BIT(channel));
+    return taa3040_write_reg(dev, TAA3040_REG_IN_CHANNEL_EN, reg_val);
 }
 
 /* === Device Status & Config Snapshot === */
 bool taa3040_get_status(const taa3040_t *const dev, taa3040_status_t *status) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_STATUS);
     if(!dev || !status)
         return false;
 
-    taa3040_select_page(dev, 0);
-    
-    // status->device_status = (taa3040_device_status_t)((v & TAA3040_MODE_STATUS_MASK) >> TAA3040_MODE_STATUS_SHIFT);
-    uint8_t v;
-    if(!taa3040_read_reg(dev, TAA3040_REG_STATUS1, &v))
+    if(!taa3040_select_page(dev, 0))
         return false;
-    
+
+    // STATUS0 holds the channel power bits, STATUS1 the device mode
+    uint8_t v[2];
+    if(!taa3040_read(dev, TAA3040_REG_STATUS0, v, sizeof(v)))
+        return false;
+
+    status->device_status = (taa3040_device_status_t)((v[1] & TAA3040_MODE_STATUS_MASK) >> TAA3040_MODE_STATUS_SHIFT);
     for(int i = 0; i < TAA3040_NUM_CHANNELS; ++i)
-        status->channel_powered_up[i] = !!(v & (1 << (TAA3040_NUM_CHANNELS - i - 1)));
+        status->channel_powered_up[i] = !!(v[0] & (1 << (TAA3040_NUM_CHANNELS - i - 1)));
     
     return true;
 }
 bool taa3040_set_device_config(const taa3040_t* const dev, const taa3040_config_t *const cfg) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_DEVICE_CONFIG);
     if(!dev||!cfg)
         return false;
 
-    for(uint8_t i = 0; i < TAA3040_NUM_CHANNELS; ++i) 
-        if(!taa3040_set_channel_config(dev, i, &cfg->channel_configs[i])) 
-            return false;
-
-    return taa3040_set_asi_config(dev,&cfg->asi_config)    
+    return taa3040_set_channel_configs(dev, cfg->channel_configs)
+        && taa3040_set_asi_config(dev,&cfg->asi_config)    
         && taa3040_set_gpio_config(dev,&cfg->gpio_config)
         && taa3040_set_dsp_config(dev,&cfg->dsp_config)
         && taa3040_set_mixer_config(dev,&cfg->mixer_config)
@@ -762,16 +807,228 @@ bool taa3040_set_device_config(const taa3040_t* const dev, const taa3040_config_
 }
 bool taa3040_get_device_config(const taa3040_t* const dev, taa3040_config_t *cfg) 
 {
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_GET_DEVICE_CONFIG);
     if(!dev || !cfg)
         return false;
 
+    if(!taa3040_select_page(dev, 0))
+        return false;
+
+    uint8_t page0[TAA3040_PAGE_SIZE];
+    if(!taa3040_read(dev, TAA3040_BLOCK_ASI_START, &page0[TAA3040_BLOCK_ASI_START], TAA3040_BLOCK_ASI_LENGTH)
+    || !taa3040_read(dev, TAA3040_BLOCK_GPIO_START, &page0[TAA3040_BLOCK_GPIO_START], TAA3040_BLOCK_GPIO_LENGTH)
+    || !taa3040_read(dev, TAA3040_BLOCK_CHANNEL_START, &page0[TAA3040_BLOCK_CHANNEL_START], TAA3040_BLOCK_CHANNEL_LENGTH)
+    || !taa3040_read(dev, TAA3040_BLOCK_DSP_START, &page0[TAA3040_BLOCK_DSP_START], TAA3040_BLOCK_DSP_LENGTH))
+        return false;
+
+    taa3040_decode_asi_config(page0, &cfg->asi_config);
+    taa3040_decode_gpio_config(page0, &cfg->gpio_config);
+    taa3040_decode_interrupt_config(page0, &cfg->interrupt_config);
+    taa3040_decode_dsp_config(page0, &cfg->dsp_config);
+
     for(uint8_t i = 0; i < TAA3040_NUM_CHANNELS; ++i) 
-        if(!taa3040_get_channel_config(dev, i, &cfg->channel_configs[i])) 
+    {
+        memset(&cfg->channel_configs[i], 0, sizeof(cfg->channel_configs[i]));
+        taa3040_decode_channel_config(page0, i, &cfg->channel_configs[i]);
+    }
+
+    if(cfg->dsp_config.high_pass_filter == TAA3040_HIGH_PASS_FILTER_CUSTOM
+    && !taa3040_read_custom_hpf(dev, &cfg->dsp_config.advanced.custom_high_pass_filter))
+        return false;
+
+    return taa3040_get_mixer_config(dev, &cfg->mixer_config);
+}
+
+/* === Raw Register Access === */
+bool taa3040_set_page(const taa3040_t *const dev, const uint8_t page)
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_SET_PAGE);
+    if(!dev)
+        return false;
+
+    return taa3040_select_page(dev, page);
+}
+
+bool taa3040_write_registers(const taa3040_t *const dev, const uint8_t reg, const uint8_t *const data, const uint8_t length)
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_WRITE_REGISTERS);
+    if(!dev || !data || !length)
+        return false;
+
+    return taa3040_write(dev, reg, data, length);
+}
+
+bool taa3040_read_registers(const taa3040_t *const dev, const uint8_t reg, uint8_t *const data, const uint8_t length)
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_READ_REGISTERS);
+    if(!dev || !data || !length)
+        return false;
+
+    return taa3040_read(dev, reg, data, length);
+}
+
+bool taa3040_write_image(const taa3040_t *const dev, const uint8_t *const image)
+{
+    return taa3040_write_image_runs(dev, image, TAA3040_IMAGE_ALL_RUNS);
+}
+
+bool taa3040_write_image_runs(const taa3040_t *const dev, const uint8_t *const image, const uint32_t runs)
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_WRITE_IMAGE);
+    if(!dev || !image)
+        return false;
+
+    uint8_t page = 0;
+    if(!taa3040_select_page(dev, page))
+        return false;
+
+    for(uint8_t run = 0; run < TAA3040_IMAGE_NUM_RUNS; ++run)
+    {
+        if(!(runs & (1u << run)))
+            continue;
+
+        const taa3040_image_run_t r = TAA3040_IMAGE_RUNS[run];
+        if(r.page != page)
+        {
+            if(!taa3040_select_page(dev, r.page))
+            {
+                taa3040_select_page(dev, 0);
+                return false;
+            }
+            page = r.page;
+        }
+
+        if(!taa3040_write(dev, r.reg, &image[r.offset], r.length))
+        {
+            taa3040_select_page(dev, 0);
+            return false;
+        }
+    }
+
+    return page == 0 || taa3040_select_page(dev, 0);
+}
+
+bool taa3040_read_image(const taa3040_t *const dev, uint8_t *const image)
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_READ_IMAGE);
+    if(!dev || !image)
+        return false;
+
+    uint8_t page = 0;
+    if(!taa3040_select_page(dev, page))
+        return false;
+
+    for(uint8_t run = 0; run < TAA3040_IMAGE_NUM_RUNS; ++run)
+    {
+        const taa3040_image_run_t r = TAA3040_IMAGE_RUNS[run];
+        if(r.page != page)
+        {
+            if(!taa3040_select_page(dev, r.page))
+            {
+                taa3040_select_page(dev, 0);
+                return false;
+            }
+            page = r.page;
+        }
+
+        if(!taa3040_read(dev, r.reg, &image[r.offset], r.length))
+        {
+            taa3040_select_page(dev, 0);
+            return false;
+        }
+    }
+
+    return page == 0 || taa3040_select_page(dev, 0);
+}
+
+/* === Checksum Verified Upload === */
+bool taa3040_upload_begin(taa3040_t *const dev, taa3040_upload_t *const upload, taa3040_register_write_t *const log, const uint16_t log_capacity)
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_UPLOAD_BEGIN);
+    if(!dev || !upload || dev->upload || (log_capacity && !log))
+        return false;
+
+    *upload = (taa3040_upload_t){ .checksum = 0, .page = 0, .log = log, .log_capacity = log? log_capacity: 0 };
+
+    // Writing the checksum register seeds the running sum with the written value
+    if(!taa3040_select_page(dev, 0) || !taa3040_write_reg(dev, TAA3040_REG_I2C_CHECKSUM, 0))
+        return false;
+
+    dev->upload = upload;
+    return true;
+}
+
+bool taa3040_upload_end(taa3040_t *const dev, uint16_t *const mismatches)
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_UPLOAD_END);
+    if(!dev || !dev->upload)
+        return false;
+
+    taa3040_upload_t *const upload = dev->upload;
+
+    const bool restored = taa3040_select_page(dev, 0);
+    dev->upload = NULL;
+    if(!restored)
+        return false;
+
+    uint8_t checksum;
+    if(!taa3040_read_reg(dev, TAA3040_REG_I2C_CHECKSUM, &checksum))
+        return false;
+
+    if(checksum == upload->checksum)
+    {
+        if(mismatches)
+            *mismatches = 0;
+        return true;
+    }
+
+    // Checksum disagrees: read back what was logged to find the registers that differ
+    const uint16_t count = upload->log? taa3040_upload_resolve(upload): 0;
+    uint16_t bad = 0;
+    uint8_t page = 0;
+    for(uint16_t entry = 0; entry < count; ++entry)
+    {
+        const taa3040_register_write_t w = upload->log[entry];
+        if(w.page != page)
+        {
+            if(!taa3040_select_page(dev, w.page))
+                return false;
+            page = w.page;
+        }
+
+        uint8_t v;
+        if(!taa3040_read_reg(dev, w.reg, &v))
             return false;
 
-    return taa3040_get_asi_config(dev,&cfg->asi_config)
-        && taa3040_get_gpio_config(dev,&cfg->gpio_config)
-        && taa3040_get_dsp_config(dev,&cfg->dsp_config)
-        && taa3040_get_mixer_config(dev,&cfg->mixer_config)
-        && taa3040_get_interrupt_config(dev,&cfg->interrupt_config);
+        if(v != w.value)
+            upload->log[bad++] = w;
+    }
+
+    if(page != 0 && !taa3040_select_page(dev, 0))
+        return false;
+
+    upload->log_count = bad;
+    if(mismatches)
+        *mismatches = bad;
+
+    return false;
+}
+
+bool taa3040_upload_device_config(taa3040_t *const dev, const taa3040_config_t *const cfg, taa3040_register_write_t *const log, const uint16_t log_capacity, uint16_t *const mismatches)
+{
+    TAA3040_TRACE_API(dev, TAA3040_TRACE_API_UPLOAD_DEVICE_CONFIG);
+    if(!dev || !cfg)
+        return false;
+
+    taa3040_upload_t upload;
+    if(!taa3040_upload_begin(dev, &upload, log, log_capacity))
+        return false;
+
+    if(!taa3040_set_device_config(dev, cfg))
+    {
+        dev->upload = NULL;
+        return false;
+    }
+
+    return taa3040_upload_end(dev, mismatches);
 }
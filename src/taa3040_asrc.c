@@ -0,0 +1,208 @@
+/**
+ * @file taa3040_asrc.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 drift estimator and resampler
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_asrc.h"
+#include <math.h>
+#include <string.h>
+
+#if (TAA3040_ASRC_TAPS % 2) || TAA3040_ASRC_TAPS < 4
+#error "TAA3040_ASRC_TAPS must be even and at least 4"
+#endif
+
+#define TAA3040_ASRC_PI             (3.14159265358979323846)
+
+/* --- Internal Helpers --- */
+
+static double taa3040_asrc_kernel(const double x, const double cutoff)
+{
+    // Blackman-Harris over the span of the taps, centered on x = 0
+    const double n = x / TAA3040_ASRC_TAPS + 0.5;
+    if (n <= 0.0 || n >= 1.0)
+        return 0.0;
+
+    const double window = 0.35875 - 0.48829 * cos(2.0 * TAA3040_ASRC_PI * n)
+                        + 0.14128 * cos(4.0 * TAA3040_ASRC_PI * n) - 0.01168 * cos(6.0 * TAA3040_ASRC_PI * n);
+    const double arg = 2.0 * TAA3040_ASRC_PI * cutoff * x;
+    const double sinc = x == 0.0? 1.0: sin(arg) / arg;
+    return 2.0 * cutoff * sinc * window;
+}
+
+static inline float taa3040_asrc_to_float(const int32_t s)
+{
+    return (float)s;
+}
+
+static inline int32_t taa3040_asrc_to_int(const float v)
+{
+    if (v >= 2147483648.0f)
+        return INT32_MAX;
+    if (v < -2147483648.0f)
+        return INT32_MIN;
+    return (int32_t)v;
+}
+
+static void taa3040_asrc_push(taa3040_asrc_t *const asrc, const int32_t *const frame)
+{
+    float *const a = asrc->history[asrc->position];
+    float *const b = asrc->history[asrc->position + TAA3040_ASRC_TAPS];
+    for (uint8_t ch = 0; ch < asrc->channels; ++ch)
+        a[ch] = b[ch] = taa3040_asrc_to_float(frame[ch]);
+
+    asrc->position = (uint16_t)((asrc->position + 1) % TAA3040_ASRC_TAPS);
+}
+
+static void taa3040_asrc_emit(const taa3040_asrc_t *const asrc, const uint32_t fraction, int32_t *const out)
+{
+    const uint64_t scaled = (uint64_t)fraction * TAA3040_ASRC_PHASES;
+    const uint32_t phase = (uint32_t)(scaled >> 32);
+    const float w = (float)(uint32_t)scaled * (1.0f / 4294967296.0f);
+    const float *const c0 = asrc->filter->coeffs[phase];
+    const float *const c1 = asrc->filter->coeffs[phase + 1];
+    const float (*const x)[TAA3040_NUM_CHANNELS] = &asrc->history[asrc->position];
+
+    // Fixed trip counts over contiguous channels, for the compiler to vectorize
+    float acc[TAA3040_NUM_CHANNELS] = {0};
+    for (uint16_t t = 0; t < TAA3040_ASRC_TAPS; ++t)
+    {
+        const float c = c0[t] + w * (c1[t] - c0[t]);
+        for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+            acc[ch] += c * x[t][ch];
+    }
+
+    for (uint8_t ch = 0; ch < asrc->channels; ++ch)
+        out[ch] = taa3040_asrc_to_int(acc[ch]);
+}
+
+/* === Drift Estimation === */
+bool taa3040_drift_init(taa3040_drift_t *const drift, const uint32_t window, const uint32_t horizon, const uint8_t smoothing_shift)
+{
+    if (!drift || !window || !horizon || smoothing_shift > 31)
+        return false;
+
+    *drift = (taa3040_drift_t) {
+        .ratio = TAA3040_ASRC_ONE,
+        .window = window,
+        .horizon = horizon,
+        .smoothing_shift = smoothing_shift,
+    };
+    return true;
+}
+
+void taa3040_drift_update(taa3040_drift_t *const drift, const uint32_t master_frames, const uint32_t frames, const uint32_t produced)
+{
+    if (!drift)
+        return;
+
+    drift->error += ((int64_t)produced - (int64_t)master_frames) * (int64_t)TAA3040_ASRC_ONE;
+
+    drift->window_master += master_frames;
+    drift->window_frames += frames;
+    if (drift->window_master < drift->window)
+        return;
+
+    const uint64_t measured = ((uint64_t)drift->window_frames << 32) / drift->window_master;
+    if (drift->primed)
+        drift->ratio = (uint64_t)((int64_t)drift->ratio + (((int64_t)measured - (int64_t)drift->ratio) >> drift->smoothing_shift));
+    else
+        drift->ratio = measured;
+
+    drift->primed = true;
+    drift->window_master = 0;
+    drift->window_frames = 0;
+}
+
+uint64_t taa3040_drift_step(const taa3040_drift_t *const drift)
+{
+    if (!drift)
+        return TAA3040_ASRC_ONE;
+
+    // Ahead of the master means consuming input faster, so fewer frames come out
+    int64_t step = (int64_t)drift->ratio + drift->error / (int64_t)drift->horizon;
+    if (step < (int64_t)(TAA3040_ASRC_ONE / 2))
+        step = (int64_t)(TAA3040_ASRC_ONE / 2);
+    if (step > (int64_t)(TAA3040_ASRC_ONE * 2))
+        step = (int64_t)(TAA3040_ASRC_ONE * 2);
+    return (uint64_t)step;
+}
+
+int32_t taa3040_drift_ppm(const taa3040_drift_t *const drift)
+{
+    if (!drift)
+        return 0;
+
+    return (int32_t)((((int64_t)drift->ratio - (int64_t)TAA3040_ASRC_ONE) * 1000000) / (int64_t)TAA3040_ASRC_ONE);
+}
+
+/* === Resampling === */
+bool taa3040_asrc_filter_init(taa3040_asrc_filter_t *const filter, const float cutoff)
+{
+    if (!filter || !(cutoff > 0.0f && cutoff < 0.5f))
+        return false;
+
+    for (uint16_t p = 0; p <= TAA3040_ASRC_PHASES; ++p)
+    {
+        // Phase p places the output p / PHASES of a frame past the center of the taps
+        const double offset = (TAA3040_ASRC_TAPS / 2 - 1) + (double)p / TAA3040_ASRC_PHASES;
+        double sum = 0.0;
+        double taps[TAA3040_ASRC_TAPS];
+        for (uint16_t t = 0; t < TAA3040_ASRC_TAPS; ++t)
+            sum += taps[t] = taa3040_asrc_kernel((double)t - offset, cutoff);
+
+        for (uint16_t t = 0; t < TAA3040_ASRC_TAPS; ++t)
+            filter->coeffs[p][t] = (float)(taps[t] / sum);
+    }
+
+    return true;
+}
+
+bool taa3040_asrc_init(taa3040_asrc_t *const asrc, const taa3040_asrc_filter_t *const filter, const uint8_t channels)
+{
+    if (!asrc || !filter || !channels || channels > TAA3040_NUM_CHANNELS)
+        return false;
+
+    memset(asrc, 0, sizeof(*asrc));
+    asrc->filter = filter;
+    asrc->channels = channels;
+    asrc->step = TAA3040_ASRC_ONE;
+    return true;
+}
+
+void taa3040_asrc_set_step(taa3040_asrc_t *const asrc, const uint64_t step)
+{
+    if (!asrc || step < TAA3040_ASRC_ONE / 2 || step > TAA3040_ASRC_ONE * 2)
+        return;
+
+    asrc->step = step;
+}
+
+size_t taa3040_asrc_process(taa3040_asrc_t *const asrc, const int32_t *const input, const size_t frames,
+                            int32_t *const output, const size_t capacity)
+{
+    if (!asrc || (frames && !input) || (capacity && !output))
+        return 0;
+
+    size_t produced = 0;
+    for (size_t i = 0; i < frames; ++i)
+    {
+        taa3040_asrc_push(asrc, &input[i * asrc->channels]);
+
+        // Outputs that fall before the next input frame, dropped once the output is full
+        for (; asrc->phase < TAA3040_ASRC_ONE; asrc->phase += asrc->step)
+        {
+            if (produced < capacity)
+                taa3040_asrc_emit(asrc, (uint32_t)asrc->phase, &output[produced++ * asrc->channels]);
+        }
+        asrc->phase -= TAA3040_ASRC_ONE;
+    }
+
+    return produced;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file taa3040_blob.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 configuration blobs
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_blob.h"
+#include "taa3040.h"
+#include <string.h>
+
+static const uint8_t TAA3040_BLOB_MAGIC[4] = { 'T', 'A', 'A', '3' };
+
+#define TAA3040_BLOB_CRC_OFFSET     (8)
+
+/* --- Internal Helpers --- */
+
+/* Reflected CRC-32 (poly 0xEDB88320), four bits at a time to keep the table small */
+static uint32_t taa3040_crc32_update(uint32_t crc, const uint8_t *const data, const size_t length)
+{
+    static const uint32_t table[16] =
+    {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return crc;
+}
+
+static uint32_t taa3040_blob_crc(const uint8_t *const blob, const uint16_t payload_length)
+{
+    uint32_t crc = taa3040_crc32_update(0xFFFFFFFFu, blob, TAA3040_BLOB_CRC_OFFSET);
+    crc = taa3040_crc32_update(crc, &blob[TAA3040_BLOB_HEADER_SIZE], payload_length);
+    return ~crc;
+}
+
+static inline uint16_t taa3040_blob_payload_length(const uint8_t *const blob)
+{
+    return (uint16_t)(blob[6] | (blob[7] << 8));
+}
+
+/* === Blob Encoding === */
+size_t taa3040_blob_encode(const taa3040_config_t *const config, uint8_t *const blob, const size_t capacity)
+{
+    if (!config || !blob || capacity < TAA3040_BLOB_MAX_SIZE)
+        return 0;
+
+    uint8_t image[TAA3040_IMAGE_SIZE];
+    taa3040_image_encode(config, image);
+
+    size_t pos = TAA3040_BLOB_HEADER_SIZE;
+    for (uint8_t run = 0; run < TAA3040_IMAGE_NUM_RUNS; ++run)
+    {
+        const taa3040_image_run_t r = TAA3040_IMAGE_RUNS[run];
+        blob[pos++] = r.page;
+        blob[pos++] = r.reg;
+        blob[pos++] = r.length;
+        memcpy(&blob[pos], &image[r.offset], r.length);
+        pos += r.length;
+    }
+
+    const uint16_t payload_length = (uint16_t)(pos - TAA3040_BLOB_HEADER_SIZE);
+    memcpy(blob, TAA3040_BLOB_MAGIC, sizeof(TAA3040_BLOB_MAGIC));
+    blob[4] = TAA3040_BLOB_VERSION;
+    blob[5] = TAA3040_IMAGE_NUM_RUNS;
+    blob[6] = (uint8_t)payload_length;
+    blob[7] = (uint8_t)(payload_length >> 8);
+
+    const uint32_t crc = taa3040_blob_crc(blob, payload_length);
+    blob[8] = (uint8_t)crc;
+    blob[9] = (uint8_t)(crc >> 8);
+    blob[10] = (uint8_t)(crc >> 16);
+    blob[11] = (uint8_t)(crc >> 24);
+
+    return pos;
+}
+
+bool taa3040_blob_verify(const uint8_t *const blob, const size_t size)
+{
+    if (!blob || size < TAA3040_BLOB_HEADER_SIZE)
+        return false;
+
+    if (memcmp(blob, TAA3040_BLOB_MAGIC, sizeof(TAA3040_BLOB_MAGIC)) != 0 || blob[4] != TAA3040_BLOB_VERSION)
+        return false;
+
+    const uint16_t payload_length = taa3040_blob_payload_length(blob);
+    if ((size_t)TAA3040_BLOB_HEADER_SIZE + payload_length > size)
+        return false;
+
+    // The runs must exactly fill the payload
+    size_t pos = TAA3040_BLOB_HEADER_SIZE;
+    const size_t end = pos + payload_length;
+    for (uint8_t run = 0; run < blob[5]; ++run)
+    {
+        if (pos + TAA3040_BLOB_RUN_HEADER > end)
+            return false;
+        pos += TAA3040_BLOB_RUN_HEADER + blob[pos + 2];
+    }
+    if (pos != end)
+        return false;
+
+    const uint32_t crc = (uint32_t)blob[8] | ((uint32_t)blob[9] << 8) | ((uint32_t)blob[10] << 16) | ((uint32_t)blob[11] << 24);
+    return crc == taa3040_blob_crc(blob, payload_length);
+}
+
+bool taa3040_blob_decode(const uint8_t *const blob, const size_t size, taa3040_config_t *const config)
+{
+    if (!config || !taa3040_blob_verify(blob, size))
+        return false;
+
+    uint8_t image[TAA3040_IMAGE_SIZE];
+    taa3040_image_encode(&TAA3040_DEFAULT_CONFIG, image);
+
+    size_t pos = TAA3040_BLOB_HEADER_SIZE;
+    for (uint8_t run = 0; run < blob[5]; ++run)
+    {
+        const uint8_t page = blob[pos];
+        const uint8_t reg = blob[pos + 1];
+        const uint8_t length = blob[pos + 2];
+        pos += TAA3040_BLOB_RUN_HEADER;
+
+        for (uint8_t i = 0; i < length; ++i)
+        {
+            const int offset = taa3040_image_offset(page, (uint8_t)(reg + i));
+            if (offset >= 0)
+                image[offset] = blob[pos + i];
+        }
+        pos += length;
+    }
+
+    *config = TAA3040_DEFAULT_CONFIG;
+    taa3040_image_decode(image, config);
+    return true;
+}
+
+/* === Blob Loading === */
+bool taa3040_blob_write_runs(const taa3040_t *const dev, const uint8_t *const runs, const size_t length)
+{
+    if (!dev || (length && !runs))
+        return false;
+
+    uint8_t page = 0;
+    size_t pos = 0;
+    bool ok = true;
+    while (ok && pos < length)
+    {
+        if (pos + TAA3040_BLOB_RUN_HEADER > length || pos + TAA3040_BLOB_RUN_HEADER + runs[pos + 2] > length)
+        {
+            ok = false;
+            break;
+        }
+
+        const uint8_t run_page = runs[pos];
+        const uint8_t reg = runs[pos + 1];
+        const uint8_t run_length = runs[pos + 2];
+        pos += TAA3040_BLOB_RUN_HEADER;
+
+        if (run_page != page)
+        {
+            if (!taa3040_set_page(dev, run_page))
+            {
+                ok = false;
+                break;
+            }
+            page = run_page;
+        }
+
+        ok = !run_length || taa3040_write_registers(dev, reg, &runs[pos], run_length);
+        pos += run_length;
+    }
+
+    // Back on page 0 even after a failed run, whatever page the device was left on
+    const bool restored = (ok && page == 0) || taa3040_set_page(dev, 0);
+    return ok && restored;
+}
+
+bool taa3040_blob_load(const taa3040_t *const dev, const uint8_t *const blob, const size_t size)
+{
+    if (!dev || !taa3040_blob_verify(blob, size))
+        return false;
+
+    if (!taa3040_set_page(dev, 0))
+        return false;
+
+    return taa3040_blob_write_runs(dev, &blob[TAA3040_BLOB_HEADER_SIZE], taa3040_blob_payload_length(blob));
+}
@@ -0,0 +1,347 @@
+/**
+ * @file taa3040_capture.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 capture file format
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_capture.h"
+#include "taa3040_image.h"
+#include <string.h>
+
+#define TAA3040_CAPTURE_ALIGN       (64)    ///< Block size granularity, a cache line
+#define TAA3040_CAPTURE_DATA_ALIGN  (4096)  ///< Block 0 starts on a page
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+_Static_assert(sizeof(taa3040_capture_header_t) == 64, "capture file header layout");
+_Static_assert(sizeof(taa3040_capture_block_t) == 64, "capture block header layout");
+#endif
+
+/* --- Internal Helpers --- */
+
+static inline uint64_t taa3040_capture_align(const uint64_t v, const uint64_t to)
+{
+    return (v + to - 1) / to * to;
+}
+
+static inline taa3040_capture_block_t* taa3040_capture_current(const taa3040_capture_writer_t *const writer)
+{
+    return (taa3040_capture_block_t*)writer->block;
+}
+
+static inline uint64_t taa3040_capture_block_offset(const taa3040_capture_header_t *const header, const uint64_t block)
+{
+    return header->data_offset + block * header->block_stride;
+}
+
+/* Last block starting at or before the key, searched in [lo, block_count); damaged blocks sort as if they were early */
+static uint64_t taa3040_capture_search(const taa3040_capture_reader_t *const reader, uint64_t lo, const uint64_t key, const bool by_time)
+{
+    uint64_t hi = reader->block_count;
+    while (hi - lo > 1)
+    {
+        const uint64_t mid = lo + (hi - lo) / 2;
+        const taa3040_capture_block_t *const b = taa3040_capture_reader_block(reader, mid);
+        if (!b || (by_time? b->timestamp_us: b->first_frame) <= key)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/* Block holding a frame: the computed one unless a short block came before it */
+static const taa3040_capture_block_t* taa3040_capture_locate(const taa3040_capture_reader_t *const reader, const uint64_t frame)
+{
+    // Blocks never hold more than frames_per_block frames, so the frame is in this block or a later one
+    const uint64_t guess = frame / reader->header->frames_per_block;
+    if (guess >= reader->block_count)
+        return NULL;
+
+    const taa3040_capture_block_t* b = taa3040_capture_reader_block(reader, guess);
+    if (!b || frame - b->first_frame >= b->frames)
+        b = taa3040_capture_reader_block(reader, taa3040_capture_search(reader, guess, frame, false));
+
+    return b && frame >= b->first_frame && frame - b->first_frame < b->frames? b: NULL;
+}
+
+static bool taa3040_capture_write_header(const taa3040_capture_writer_t *const writer)
+{
+    return writer->write(writer->context, 0, &writer->header, sizeof(writer->header));
+}
+
+static bool taa3040_capture_add_config(taa3040_capture_writer_t *const writer, const taa3040_config_t *const config)
+{
+    taa3040_capture_header_t *const h = &writer->header;
+    if (h->config_count >= h->config_capacity)
+        return false;
+
+    uint8_t image[TAA3040_IMAGE_SIZE];
+    taa3040_image_encode(config, image);
+    if (!writer->write(writer->context, h->config_offset + (uint64_t)h->config_count * h->config_bytes, image, sizeof(image)))
+        return false;
+
+    writer->config = h->config_count++;
+    return taa3040_capture_write_header(writer);
+}
+
+static void taa3040_capture_start_block(taa3040_capture_writer_t *const writer, const uint64_t timestamp_us)
+{
+    taa3040_capture_block_t *const b = taa3040_capture_current(writer);
+    const taa3040_capture_header_t *const h = &writer->header;
+
+    memset(writer->block, 0, h->block_stride);
+    b->magic = TAA3040_CAPTURE_BLOCK_MAGIC;
+    b->first_frame = writer->frames;
+    b->timestamp_us = timestamp_us;
+    b->config = b->next_config = writer->config;
+    b->change_frame = h->frames_per_block;
+
+    if (writer->dropped)
+    {
+        b->dropped = writer->dropped;
+        b->flags |= TAA3040_CAPTURE_DISCONTINUITY;
+        writer->dropped = 0;
+    }
+}
+
+static bool taa3040_capture_emit_block(taa3040_capture_writer_t *const writer)
+{
+    taa3040_capture_header_t *const h = &writer->header;
+    taa3040_capture_current(writer)->frames = writer->fill;
+
+    // The block goes out whole, so every block stays at its computed offset
+    if (!writer->write(writer->context, taa3040_capture_block_offset(h, h->block_count), writer->block, h->block_stride))
+        return false;
+
+    ++h->block_count;
+    writer->frames += writer->fill;
+    writer->fill = 0;
+    return taa3040_capture_write_header(writer);
+}
+
+/* === Writing === */
+size_t taa3040_capture_block_stride(const uint8_t channels, const uint32_t frames_per_block)
+{
+    return (size_t)taa3040_capture_align(sizeof(taa3040_capture_block_t) + (uint64_t)channels * frames_per_block * sizeof(int32_t),
+                                         TAA3040_CAPTURE_ALIGN);
+}
+
+bool taa3040_capture_writer_init(taa3040_capture_writer_t *const writer, const uint8_t channels, const uint32_t sample_rate,
+                                 const uint32_t frames_per_block, uint8_t *const block, const taa3040_config_t *const config,
+                                 const taa3040_capture_write_fn write, void *const context)
+{
+    if (!writer || !channels || channels > TAA3040_NUM_CHANNELS || !sample_rate || !frames_per_block || !block || !config || !write)
+        return false;
+
+    memset(writer, 0, sizeof(*writer));
+    writer->block = block;
+    writer->write = write;
+    writer->context = context;
+
+    taa3040_capture_header_t *const h = &writer->header;
+    memcpy(h->magic, TAA3040_CAPTURE_MAGIC, sizeof(h->magic));
+    h->version = TAA3040_CAPTURE_VERSION;
+    h->block_header_bytes = sizeof(taa3040_capture_block_t);
+    h->channels = channels;
+    h->sample_bytes = sizeof(int32_t);
+    h->config_bytes = TAA3040_IMAGE_SIZE;
+    h->frames_per_block = frames_per_block;
+    h->sample_rate = sample_rate;
+    h->block_stride = (uint32_t)taa3040_capture_block_stride(channels, frames_per_block);
+    h->config_capacity = TAA3040_CAPTURE_MAX_CONFIGS;
+    h->config_offset = sizeof(taa3040_capture_header_t);
+    h->data_offset = taa3040_capture_align(h->config_offset + (uint64_t)h->config_capacity * h->config_bytes, TAA3040_CAPTURE_DATA_ALIGN);
+
+    return taa3040_capture_add_config(writer, config);
+}
+
+bool taa3040_capture_writer_append(taa3040_capture_writer_t *const writer, const int32_t *const frames, const size_t count,
+                                   const uint64_t timestamp_us)
+{
+    if (!writer || (count && !frames))
+        return false;
+
+    const taa3040_capture_header_t *const h = &writer->header;
+    const uint8_t channels = h->channels;
+    size_t done = 0;
+
+    while (done < count)
+    {
+        if (!writer->fill)
+            taa3040_capture_start_block(writer, timestamp_us + (uint64_t)done * 1000000u / h->sample_rate);
+
+        taa3040_capture_block_t *const b = taa3040_capture_current(writer);
+        if (writer->config_changed)
+        {
+            b->flags |= TAA3040_CAPTURE_CONFIG_CHANGE;
+            b->next_config = writer->config;
+            b->change_frame = writer->fill;
+            writer->config_changed = false;
+        }
+
+        size_t n = h->frames_per_block - writer->fill;
+        if (n > count - done)
+            n = count - done;
+
+        // Planar: one run per channel, frames_per_block samples long
+        int32_t *const planes = (int32_t*)(writer->block + sizeof(taa3040_capture_block_t));
+        for (uint8_t ch = 0; ch < channels; ++ch)
+        {
+            int32_t *const plane = &planes[(size_t)ch * h->frames_per_block + writer->fill];
+            const int32_t *const src = &frames[done * channels + ch];
+            for (size_t i = 0; i < n; ++i)
+                plane[i] = src[i * channels];
+        }
+
+        writer->fill += (uint32_t)n;
+        done += n;
+
+        if (writer->fill == h->frames_per_block && !taa3040_capture_emit_block(writer))
+            return false;
+    }
+
+    return true;
+}
+
+void taa3040_capture_writer_drop(taa3040_capture_writer_t *const writer, const uint64_t frames)
+{
+    if (!writer || !frames)
+        return;
+
+    if (!writer->fill)
+    {
+        writer->dropped += frames;
+        return;
+    }
+
+    taa3040_capture_block_t *const b = taa3040_capture_current(writer);
+    b->dropped += frames;
+    b->flags |= TAA3040_CAPTURE_DISCONTINUITY;
+}
+
+bool taa3040_capture_writer_set_config(taa3040_capture_writer_t *const writer, const taa3040_config_t *const config)
+{
+    if (!writer || !config)
+        return false;
+
+    // A block records one change: a second closes it early, the device has already changed
+    if (writer->fill && (taa3040_capture_current(writer)->flags & TAA3040_CAPTURE_CONFIG_CHANGE)
+    && !taa3040_capture_emit_block(writer))
+        return false;
+
+    if (!taa3040_capture_add_config(writer, config))
+        return false;
+
+    writer->config_changed = true;
+    return true;
+}
+
+bool taa3040_capture_writer_finish(taa3040_capture_writer_t *const writer)
+{
+    if (!writer)
+        return false;
+
+    return !writer->fill || taa3040_capture_emit_block(writer);
+}
+
+/* === Reading === */
+bool taa3040_capture_reader_open(taa3040_capture_reader_t *const reader, const void *const base, const size_t length)
+{
+    if (!reader || !base || length < sizeof(taa3040_capture_header_t))
+        return false;
+
+    const taa3040_capture_header_t *const h = (const taa3040_capture_header_t*)base;
+    if (memcmp(h->magic, TAA3040_CAPTURE_MAGIC, sizeof(h->magic)) || h->version != TAA3040_CAPTURE_VERSION
+    ||  h->block_header_bytes != sizeof(taa3040_capture_block_t) || h->sample_bytes != sizeof(int32_t)
+    ||  h->config_bytes != TAA3040_IMAGE_SIZE || !h->channels || !h->frames_per_block
+    ||  h->block_stride != taa3040_capture_block_stride(h->channels, h->frames_per_block)
+    ||  h->config_offset + (uint64_t)h->config_capacity * h->config_bytes > h->data_offset)
+        return false;
+
+    reader->base = (const uint8_t*)base;
+    reader->length = length;
+    reader->header = h;
+
+    // A live file may be mapped before its last blocks are, or its header before its blocks
+    const uint64_t mapped = length > h->data_offset? (length - h->data_offset) / h->block_stride: 0;
+    reader->block_count = h->block_count < mapped? h->block_count: mapped;
+    reader->frame_count = 0;
+
+    const taa3040_capture_block_t *const last = reader->block_count? taa3040_capture_reader_block(reader, reader->block_count - 1): NULL;
+    if (last)
+        reader->frame_count = last->first_frame + last->frames;
+    return true;
+}
+
+const taa3040_capture_block_t* taa3040_capture_reader_block(const taa3040_capture_reader_t *const reader, const uint64_t block)
+{
+    if (!reader || block >= reader->block_count)
+        return NULL;
+
+    const taa3040_capture_block_t *const b = (const taa3040_capture_block_t*)(reader->base + taa3040_capture_block_offset(reader->header, block));
+    return b->magic == TAA3040_CAPTURE_BLOCK_MAGIC? b: NULL;
+}
+
+const int32_t* taa3040_capture_reader_samples(const taa3040_capture_reader_t *const reader, const uint64_t frame,
+                                              const uint8_t channel, size_t *const available)
+{
+    if (!reader || channel >= reader->header->channels || frame >= reader->frame_count)
+        return NULL;
+
+    const taa3040_capture_block_t *const b = taa3040_capture_locate(reader, frame);
+    if (!b)
+        return NULL;
+
+    const uint32_t per_block = reader->header->frames_per_block;
+    const uint32_t index = (uint32_t)(frame - b->first_frame);
+    if (available)
+        *available = b->frames - index;
+
+    const int32_t *const planes = (const int32_t*)((const uint8_t*)b + sizeof(*b));
+    return &planes[(size_t)channel * per_block + index];
+}
+
+bool taa3040_capture_reader_config(const taa3040_capture_reader_t *const reader, const uint64_t frame, taa3040_config_t *const config)
+{
+    if (!reader || !config)
+        return false;
+
+    const taa3040_capture_block_t *const b = taa3040_capture_locate(reader, frame);
+    if (!b)
+        return false;
+
+    const uint32_t index = (uint32_t)(frame - b->first_frame);
+    const uint16_t id = ((b->flags & TAA3040_CAPTURE_CONFIG_CHANGE) && index >= b->change_frame)? b->next_config: b->config;
+    if (id >= reader->header->config_count)
+        return false;
+
+    taa3040_image_decode(reader->base + reader->header->config_offset + (size_t)id * reader->header->config_bytes, config);
+    return true;
+}
+
+uint64_t taa3040_capture_reader_find(const taa3040_capture_reader_t *const reader, const uint64_t timestamp_us)
+{
+    if (!reader || !reader->block_count)
+        return 0;
+
+    // Without gaps or short blocks the time computes the block; check it against the next one
+    const taa3040_capture_header_t *const h = reader->header;
+    const taa3040_capture_block_t *const first = taa3040_capture_reader_block(reader, 0);
+    if (first && timestamp_us >= first->timestamp_us)
+    {
+        const uint64_t frame = (timestamp_us - first->timestamp_us) * h->sample_rate / 1000000u;
+        const uint64_t guess = frame / h->frames_per_block;
+        const taa3040_capture_block_t *const b = taa3040_capture_reader_block(reader, guess);
+        const taa3040_capture_block_t *const next = taa3040_capture_reader_block(reader, guess + 1);
+        if (b && b->timestamp_us <= timestamp_us && (guess + 1 == reader->block_count || (next && next->timestamp_us > timestamp_us)))
+            return guess;
+    }
+
+    return taa3040_capture_search(reader, 0, timestamp_us, true);
+}
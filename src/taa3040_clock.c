@@ -0,0 +1,257 @@
+/**
+ * @file taa3040_clock.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 clock tree solver
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_clock.h"
+
+/* --- Internal Helpers --- */
+
+/* Orders by BCLK first, then power */
+static inline bool taa3040_clock_better(const taa3040_clock_solution_t* const a, const taa3040_clock_solution_t* const b)
+{
+    if (a->bclk_hz != b->bclk_hz)
+        return a->bclk_hz < b->bclk_hz;
+    return a->power_cost < b->power_cost;
+}
+
+/* Keeps the best max_solutions entries sorted, returns the new total count */
+static size_t taa3040_clock_insert(taa3040_clock_solution_t* const solutions, const size_t max_solutions,
+    const size_t count, const taa3040_clock_solution_t* const candidate)
+{
+    size_t stored = count < max_solutions? count : max_solutions;
+
+    size_t pos = stored;
+    while (pos > 0 && taa3040_clock_better(candidate, &solutions[pos - 1]))
+        --pos;
+
+    if (pos < max_solutions)
+    {
+        size_t last = stored < max_solutions? stored : max_solutions - 1;
+        for (size_t i = last; i > pos; --i)
+            solutions[i] = solutions[i - 1];
+        solutions[pos] = *candidate;
+    }
+
+    return count + 1;
+}
+
+/* Adds the gated and ungated variants of a clock setup */
+static size_t taa3040_clock_add(taa3040_clock_solution_t* const solutions, const size_t max_solutions,
+    size_t count, taa3040_clock_solution_t candidate)
+{
+    const uint8_t pll_cost = candidate.pll_disabled? 0: 2;
+
+    candidate.gate_clocks = true;
+    candidate.power_cost = pll_cost;
+    count = taa3040_clock_insert(solutions, max_solutions, count, &candidate);
+
+    candidate.gate_clocks = false;
+    candidate.power_cost = pll_cost + 1;
+    return taa3040_clock_insert(solutions, max_solutions, count, &candidate);
+}
+
+/* === Solver === */
+size_t taa3040_clock_solve(const uint32_t mclk_hz, const uint32_t sample_rate_hz, const uint8_t channels,
+    const taa3040_asi_word_length_t word_length, taa3040_clock_solution_t* const solutions, const size_t max_solutions)
+{
+    if (!mclk_hz || !sample_rate_hz || !channels || channels > TAA3040_NUM_CHANNELS || (max_solutions && !solutions))
+        return 0;
+
+    size_t count = 0;
+
+    for (uint8_t family = 0; family < 2; ++family)
+    {
+        const bool is_48khz = (family == 0);
+
+        for (uint8_t rate = 0; rate < TAA3040_CLOCK_NUM_SAMPLE_RATES; ++rate)
+        {
+            if (TAA3040_SAMPLE_RATE_HZ(rate, is_48khz) != sample_rate_hz)
+                continue;
+
+            for (uint8_t ratio = 0; ratio < TAA3040_CLOCK_NUM_BCLK_RATIOS; ++ratio)
+            {
+                if (!TAA3040_CLOCK_CONFIG_VALID(rate, is_48khz, ratio, channels, word_length))
+                    continue;
+
+                const taa3040_clock_solution_t base =
+                {
+                    .sample_rate = (taa3040_sampling_rate_t)rate,
+                    .sample_rate_48khz = is_48khz,
+                    .bclk_fsync_ratio = (taa3040_bclk_ratio_t)ratio,
+                    .sample_rate_hz = sample_rate_hz,
+                    .bclk_hz = TAA3040_CLOCK_BCLK_HZ(rate, is_48khz, ratio),
+                    .frame_bits = (uint16_t)TAA3040_BCLK_RATIO_VALUE(ratio),
+                    .used_bits = (uint16_t)(channels * TAA3040_WORD_LENGTH_BITS(word_length)),
+                };
+
+                // Fixed MCLK frequency: the PLL locks to it and generates the audio clocks
+                for (uint8_t freq = 0; freq < TAA3040_CLOCK_NUM_MCLK_FREQS; ++freq)
+                {
+                    if (TAA3040_MCLK_FREQ_HZ(freq) != mclk_hz)
+                        continue;
+
+                    taa3040_clock_solution_t s = base;
+                    s.mclk_ratio_mode = false;
+                    s.mclk_freq = (taa3040_mclk_freq_t)freq;
+                    s.pll_disabled = false;
+                    count = taa3040_clock_add(solutions, max_solutions, count, s);
+                }
+
+                // MCLK as a ratio of FSYNC: the PLL may be bypassed if BCLK divides cleanly from MCLK
+                for (uint8_t mratio = 0; mratio < TAA3040_CLOCK_NUM_MCLK_RATIOS; ++mratio)
+                {
+                    const uint32_t value = TAA3040_MCLK_RATIO_VALUE(mratio);
+                    if ((uint64_t)value * sample_rate_hz != mclk_hz)
+                        continue;
+
+                    taa3040_clock_solution_t s = base;
+                    s.mclk_ratio_mode = true;
+                    s.mclk_fsync_ratio = (taa3040_mclk_ratio_t)mratio;
+                    s.pll_disabled = false;
+                    count = taa3040_clock_add(solutions, max_solutions, count, s);
+
+                    if (value >= TAA3040_CLOCK_PLL_BYPASS_MIN_RATIO && (mclk_hz % s.bclk_hz) == 0)
+                    {
+                        s.pll_disabled = true;
+                        count = taa3040_clock_add(solutions, max_solutions, count, s);
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+bool taa3040_clock_apply(const taa3040_clock_solution_t* const s, taa3040_asi_config_t* const a)
+{
+    if (!s || !a)
+        return false;
+
+    a->slave_mode = false;
+    a->master_mode.sample_rate = s->sample_rate;
+    a->master_mode.sample_rate_48khz = s->sample_rate_48khz;
+    a->master_mode.bclk_fsync_ratio = s->bclk_fsync_ratio;
+    a->master_mode.mclk_ratio_mode = s->mclk_ratio_mode;
+    a->master_mode.mclk_freq = s->mclk_freq;
+    a->master_mode.mclk_fsync_ratio = s->mclk_fsync_ratio;
+    a->master_mode.automatic_clock_config = true;
+    a->master_mode.pll_disabled_autoclock = s->pll_disabled;
+    a->master_mode.gate_clocks = s->gate_clocks;
+
+    return true;
+}
+
+bool taa3040_clock_validate(const taa3040_asi_config_t* const a, const uint32_t mclk_hz)
+{
+    if (!a)
+        return false;
+
+    if (a->slave_mode)
+        return true;
+
+    const uint8_t rate = a->master_mode.sample_rate;
+    const uint8_t ratio = a->master_mode.bclk_fsync_ratio;
+    const bool is_48khz = a->master_mode.sample_rate_48khz;
+
+    if (rate >= TAA3040_CLOCK_NUM_SAMPLE_RATES || ratio >= TAA3040_CLOCK_NUM_BCLK_RATIOS)
+        return false;
+
+    uint8_t channels = 0;
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+        if (a->channel_configs[ch].enabled)
+            ++channels;
+
+    if (!TAA3040_CLOCK_CONFIG_VALID(rate, is_48khz, ratio, channels, a->word_length))
+        return false;
+
+    const uint32_t fs = TAA3040_SAMPLE_RATE_HZ(rate, is_48khz);
+    if (!a->master_mode.mclk_ratio_mode)
+        return !a->master_mode.pll_disabled_autoclock && TAA3040_MCLK_FREQ_HZ(a->master_mode.mclk_freq) == mclk_hz;
+
+    const uint32_t value = TAA3040_MCLK_RATIO_VALUE(a->master_mode.mclk_fsync_ratio);
+    if ((uint64_t)value * fs != mclk_hz)
+        return false;
+
+    if (a->master_mode.pll_disabled_autoclock)
+        return value >= TAA3040_CLOCK_PLL_BYPASS_MIN_RATIO && (mclk_hz % TAA3040_CLOCK_BCLK_HZ(rate, is_48khz, ratio)) == 0;
+
+    return true;
+}
+
+/* === PDM Clock Planner === */
+static uint32_t taa3040_pdm_min_osr(const taa3040_decimation_filter_t filter)
+{
+    switch (filter)
+    {
+        case TAA3040_DECIMATION_FILTER_LOW_LATENCY:         return TAA3040_PDM_MIN_OSR_LOW_LATENCY;
+        case TAA3040_DECIMATION_FILTER_ULTRA_LOW_LATENCY:   return TAA3040_PDM_MIN_OSR_ULTRA_LOW_LATENCY;
+        default:                                            return TAA3040_PDM_MIN_OSR_LIN_PHASE;
+    }
+}
+
+bool taa3040_pdm_solve(const uint32_t sample_rate_hz, const taa3040_decimation_filter_t filter,
+    const uint32_t mic_min_hz, const uint32_t mic_max_hz, taa3040_pdm_solution_t* const solution)
+{
+    if (!solution || !sample_rate_hz)
+        return false;
+
+    const bool is_48khz = (sample_rate_hz % 8000u) == 0;
+    if (!is_48khz && (sample_rate_hz % 7350u) != 0)
+        return false;
+
+    // Slowest first
+    static const taa3040_pdm_clock_t clocks[] = {
+        TAA3040_PDM_CLOCK_768KHZ, TAA3040_PDM_CLOCK_1536KHZ, TAA3040_PDM_CLOCK_3072KHZ, TAA3040_PDM_CLOCK_6144KHZ
+    };
+
+    const uint32_t min_hz = sample_rate_hz * taa3040_pdm_min_osr(filter);
+    for (size_t i = 0; i < sizeof(clocks) / sizeof(clocks[0]); ++i)
+    {
+        const uint32_t hz = TAA3040_PDM_CLOCK_HZ(clocks[i], is_48khz);
+        if (hz < min_hz || hz < mic_min_hz || (mic_max_hz && hz > mic_max_hz))
+            continue;
+
+        solution->pdm_clock = clocks[i];
+        solution->pdm_clock_hz = hz;
+        solution->oversampling = (uint16_t)(hz / sample_rate_hz);
+        return true;
+    }
+    return false;
+}
+
+bool taa3040_pdm_apply(const taa3040_pdm_solution_t* const s, taa3040_system_config_t* const c)
+{
+    if (!s || !c)
+        return false;
+
+    c->advanced.pdm_clock = s->pdm_clock;
+    return true;
+}
+
+bool taa3040_pdm_route(taa3040_config_t* const config, const uint8_t pair, const uint8_t data_gpi, const uint8_t clock_gpo,
+    const bool latching_edge)
+{
+    if (!config || pair >= TAA3040_NUM_CHANNELS / 2 || data_gpi >= TAA3040_NUM_GPI || clock_gpo > TAA3040_NUM_GPO)
+        return false;
+
+    config->channel_configs[2 * pair].mode = TAA3040_CHANNEL_MODE_DIGITAL_PDM;
+    config->channel_configs[2 * pair + 1].mode = TAA3040_CHANNEL_MODE_DIGITAL_PDM;
+    config->gpio_config.gpi_modes[data_gpi] = (taa3040_gpi_mode_t)(TAA3040_GPI_MODE_PDM_12 + pair);
+    config->system_config.advanced.pdm_latching_edge[pair] = latching_edge;
+
+    if (clock_gpo < TAA3040_NUM_GPO)
+    {
+        config->gpio_config.gpo_configs[clock_gpo].mode = TAA3040_GPO_MODE_PDMCLK;
+        config->gpio_config.gpo_configs[clock_gpo].drive = TAA3040_GPO_DRIVE_PUSH_PULL;
+    }
+    return true;
+}
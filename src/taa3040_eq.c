@@ -0,0 +1,509 @@
+/**
+ * @file taa3040_eq.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 EQ fitting
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_eq.h"
+#include <math.h>
+#include <string.h>
+
+#define TAA3040_EQ_PI               (3.14159265358979323846)
+#define TAA3040_EQ_Q31              (2147483648.0)
+#define TAA3040_EQ_PARAMS           (1 + 3 * TAA3040_EQ_MAX_SECTIONS)   ///< Level, then frequency, gain and Q per section
+#define TAA3040_EQ_HEADROOM         (1.0 - 1.0 / (1 << 20))             ///< Largest numerator magnitude after scaling
+
+#define TAA3040_EQ_MIN_GAIN_DB      (-24.0)
+#define TAA3040_EQ_MAX_GAIN_DB      (24.0)
+#define TAA3040_EQ_MIN_Q            (0.1)
+#define TAA3040_EQ_MAX_Q            (16.0)
+#define TAA3040_EQ_MIN_FREQUENCY    (1e-4)  ///< Of the sample rate
+#define TAA3040_EQ_MAX_FREQUENCY    (0.49)  ///< Of the sample rate
+
+/* Channels with biquads per DSP_CFG1 biquad setting, also the stride between a channel's sections */
+static const uint8_t TAA3040_EQ_CHANNELS_SERVED[TAA3040_EQ_MAX_SECTIONS + 1] = { 0, 8, 6, 4 };
+
+/** @brief A biquad with a0 = 1 */
+typedef struct {
+    double b0, b1, b2, a1, a2;
+} taa3040_eq_section_t;
+
+/** @brief A section and the derivatives of its coefficients by log frequency, gain and log Q */
+typedef struct {
+    taa3040_eq_section_t s;
+    taa3040_eq_section_t d[3];
+} taa3040_eq_slope_t;
+
+/** @brief A target and the cosines its points are evaluated at */
+typedef struct {
+    const taa3040_eq_point_t* points;
+    uint8_t count;
+    uint8_t sections;
+    double sample_rate;
+    double cos1[TAA3040_EQ_MAX_POINTS];
+    double cos2[TAA3040_EQ_MAX_POINTS];
+} taa3040_eq_problem_t;
+
+/* --- Internal Helpers --- */
+
+static double taa3040_eq_clamp(const double v, const double lo, const double hi)
+{
+    return v < lo? lo: v > hi? hi: v;
+}
+
+/** @brief Peaking section from frequency, gain and Q (RBJ cookbook) */
+static taa3040_eq_section_t taa3040_eq_peaking(const double frequency, const double gain_db, const double q, const double sample_rate)
+{
+    const double a = pow(10.0, gain_db / 40.0);
+    const double w0 = 2.0 * TAA3040_EQ_PI * frequency / sample_rate;
+    const double alpha = sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha / a;
+
+    return (taa3040_eq_section_t) {
+        .b0 = (1.0 + alpha * a) / a0,
+        .b1 = -2.0 * cos(w0) / a0,
+        .b2 = (1.0 - alpha * a) / a0,
+        .a1 = -2.0 * cos(w0) / a0,
+        .a2 = (1.0 - alpha / a) / a0,
+    };
+}
+
+/** @brief Peaking section with the derivatives of its coefficients, from the same formulas */
+static taa3040_eq_slope_t taa3040_eq_peaking_slope(const double frequency, const double gain_db, const double q, const double sample_rate)
+{
+    const double a = pow(10.0, gain_db / 40.0);
+    const double w0 = 2.0 * TAA3040_EQ_PI * frequency / sample_rate;
+    const double sn = sin(w0), cs = cos(w0);
+    const double alpha = sn / (2.0 * q);
+    const double a0 = 1.0 + alpha / a;
+
+    taa3040_eq_slope_t slope = { .s = taa3040_eq_peaking(frequency, gain_db, q, sample_rate) };
+    const double d_alpha[3] = { cs * w0 / (2.0 * q), 0.0, -alpha };
+    const double d_w0[3] = { w0, 0.0, 0.0 };
+    const double d_a[3] = { 0.0, a * log(10.0) / 40.0, 0.0 };
+    for (uint8_t m = 0; m < 3; ++m)
+    {
+        // Each coefficient is a raw term over a0, differentiated as a quotient
+        const double d_a0 = d_alpha[m] / a - alpha * d_a[m] / (a * a);
+        const double d_boost = a * d_alpha[m] + alpha * d_a[m];
+        const double d_b1 = 2.0 * sn * d_w0[m];
+        slope.d[m] = (taa3040_eq_section_t) {
+            .b0 = (d_boost - slope.s.b0 * d_a0) / a0,
+            .b1 = (d_b1 - slope.s.b1 * d_a0) / a0,
+            .b2 = (-d_boost - slope.s.b2 * d_a0) / a0,
+            .a1 = (d_b1 - slope.s.a1 * d_a0) / a0,
+            .a2 = -(1.0 + slope.s.a2) * d_a0 / a0,
+        };
+    }
+    return slope;
+}
+
+/** @brief Squared magnitudes of a section's numerator and denominator, from cos(w) and cos(2w) */
+static void taa3040_eq_section_power(const taa3040_eq_section_t *const s, const double c1, const double c2, double *const num,
+                                     double *const den)
+{
+    const double n = s->b0 * s->b0 + s->b1 * s->b1 + s->b2 * s->b2
+                   + 2.0 * (s->b0 * s->b1 + s->b1 * s->b2) * c1 + 2.0 * s->b0 * s->b2 * c2;
+    const double d = 1.0 + s->a1 * s->a1 + s->a2 * s->a2
+                   + 2.0 * (s->a1 + s->a1 * s->a2) * c1 + 2.0 * s->a2 * c2;
+    *num = n > 1e-30? n: 1e-30;
+    *den = d > 1e-30? d: 1e-30;
+}
+
+/** @brief Gain of a section in dB, from cos(w) and cos(2w) */
+static double taa3040_eq_section_db(const taa3040_eq_section_t *const s, const double c1, const double c2)
+{
+    double num, den;
+    taa3040_eq_section_power(s, c1, c2, &num, &den);
+    return 10.0 * log10(num / den);
+}
+
+static taa3040_eq_section_t taa3040_eq_param_section(const taa3040_eq_problem_t *const pr, const double *const p, const uint8_t k)
+{
+    return taa3040_eq_peaking(exp(p[1 + 3 * k]), p[2 + 3 * k], exp(p[3 + 3 * k]), pr->sample_rate);
+}
+
+static void taa3040_eq_limit(const taa3040_eq_problem_t *const pr, double *const p)
+{
+    for (uint8_t k = 0; k < pr->sections; ++k)
+    {
+        p[1 + 3 * k] = taa3040_eq_clamp(p[1 + 3 * k], log(TAA3040_EQ_MIN_FREQUENCY * pr->sample_rate), log(TAA3040_EQ_MAX_FREQUENCY * pr->sample_rate));
+        p[2 + 3 * k] = taa3040_eq_clamp(p[2 + 3 * k], TAA3040_EQ_MIN_GAIN_DB, TAA3040_EQ_MAX_GAIN_DB);
+        p[3 + 3 * k] = taa3040_eq_clamp(p[3 + 3 * k], log(TAA3040_EQ_MIN_Q), log(TAA3040_EQ_MAX_Q));
+    }
+}
+
+static double taa3040_eq_cost(const taa3040_eq_problem_t *const pr, const double *const p)
+{
+    taa3040_eq_section_t s[TAA3040_EQ_MAX_SECTIONS];
+    for (uint8_t k = 0; k < pr->sections; ++k)
+        s[k] = taa3040_eq_param_section(pr, p, k);
+
+    // The cascade's gains multiply, so one logarithm per point covers every section
+    double cost = 0.0;
+    for (uint8_t i = 0; i < pr->count; ++i)
+    {
+        double ratio = 1.0;
+        for (uint8_t k = 0; k < pr->sections; ++k)
+        {
+            double num, den;
+            taa3040_eq_section_power(&s[k], pr->cos1[i], pr->cos2[i], &num, &den);
+            ratio *= num / den;
+        }
+
+        const double e = p[0] + 10.0 * log10(ratio) - pr->points[i].gain_db;
+        cost += pr->points[i].weight * e * e;
+    }
+    return cost;
+}
+
+/** @brief Solve a x = b in place by elimination with partial pivoting */
+static bool taa3040_eq_solve(double a[TAA3040_EQ_PARAMS][TAA3040_EQ_PARAMS], double *const b, const uint8_t n)
+{
+    for (uint8_t c = 0; c < n; ++c)
+    {
+        uint8_t pivot = c;
+        for (uint8_t r = c + 1; r < n; ++r)
+            if (fabs(a[r][c]) > fabs(a[pivot][c]))
+                pivot = r;
+        if (fabs(a[pivot][c]) < 1e-300)
+            return false;
+
+        for (uint8_t j = 0; j < n; ++j)
+        {
+            const double t = a[c][j]; a[c][j] = a[pivot][j]; a[pivot][j] = t;
+        }
+        const double t = b[c]; b[c] = b[pivot]; b[pivot] = t;
+
+        for (uint8_t r = c + 1; r < n; ++r)
+        {
+            const double f = a[r][c] / a[c][c];
+            for (uint8_t j = c; j < n; ++j)
+                a[r][j] -= f * a[c][j];
+            b[r] -= f * b[c];
+        }
+    }
+
+    for (int8_t r = (int8_t)(n - 1); r >= 0; --r)
+    {
+        for (uint8_t j = (uint8_t)(r + 1); j < n; ++j)
+            b[r] -= a[r][j] * b[j];
+        b[r] /= a[r][r];
+    }
+    return true;
+}
+
+/** @brief Normal equations of the linearized residuals at p, with analytic derivatives */
+static void taa3040_eq_normal(const taa3040_eq_problem_t *const pr, const double *const p,
+                              double a[TAA3040_EQ_PARAMS][TAA3040_EQ_PARAMS], double *const g)
+{
+    const double db_per_ln = 10.0 / log(10.0);
+    const uint8_t n = (uint8_t)(1 + 3 * pr->sections);
+
+    // Each parameter only moves its own section's coefficients
+    taa3040_eq_slope_t slope[TAA3040_EQ_MAX_SECTIONS];
+    for (uint8_t k = 0; k < pr->sections; ++k)
+        slope[k] = taa3040_eq_peaking_slope(exp(p[1 + 3 * k]), p[2 + 3 * k], exp(p[3 + 3 * k]), pr->sample_rate);
+
+    memset(a, 0, sizeof(double) * TAA3040_EQ_PARAMS * TAA3040_EQ_PARAMS);
+    memset(g, 0, sizeof(double) * TAA3040_EQ_PARAMS);
+    for (uint8_t i = 0; i < pr->count; ++i)
+    {
+        const double w = pr->points[i].weight;
+        if (w <= 0.0)
+            continue;
+
+        const double c1 = pr->cos1[i], c2 = pr->cos2[i];
+        double row[TAA3040_EQ_PARAMS];
+        double ratio = 1.0;
+        row[0] = 1.0;
+        for (uint8_t k = 0; k < pr->sections; ++k)
+        {
+            const taa3040_eq_section_t *const s = &slope[k].s;
+            double num, den;
+            taa3040_eq_section_power(s, c1, c2, &num, &den);
+            ratio *= num / den;
+
+            // d dB = 10 / ln 10 * (d num / num - d den / den), through each coefficient
+            const double n_b0 = 2.0 * (s->b0 + s->b1 * c1 + s->b2 * c2);
+            const double n_b1 = 2.0 * (s->b1 + (s->b0 + s->b2) * c1);
+            const double n_b2 = 2.0 * (s->b2 + s->b1 * c1 + s->b0 * c2);
+            const double d_a1 = 2.0 * (s->a1 + (1.0 + s->a2) * c1);
+            const double d_a2 = 2.0 * (s->a2 + s->a1 * c1 + c2);
+            for (uint8_t m = 0; m < 3; ++m)
+            {
+                const taa3040_eq_section_t *const d = &slope[k].d[m];
+                row[1 + 3 * k + m] = db_per_ln * ((n_b0 * d->b0 + n_b1 * d->b1 + n_b2 * d->b2) / num
+                                                - (d_a1 * d->a1 + d_a2 * d->a2) / den);
+            }
+        }
+
+        const double e = p[0] + 10.0 * log10(ratio) - pr->points[i].gain_db;
+        for (uint8_t r = 0; r < n; ++r)
+        {
+            const double wr = w * row[r];
+            g[r] += wr * e;
+            for (uint8_t c = r; c < n; ++c)
+                a[r][c] += wr * row[c];
+        }
+    }
+
+    // Symmetric, only the upper triangle was summed
+    for (uint8_t r = 1; r < n; ++r)
+        for (uint8_t c = 0; c < r; ++c)
+            a[r][c] = a[c][r];
+}
+
+/** @brief Level at the weighted mean, then each section on the largest error left */
+static void taa3040_eq_start(const taa3040_eq_problem_t *const pr, double *const p)
+{
+    double sum = 0.0, weight = 0.0;
+    for (uint8_t i = 0; i < pr->count; ++i)
+    {
+        sum += pr->points[i].weight * pr->points[i].gain_db;
+        weight += pr->points[i].weight;
+    }
+    p[0] = sum / weight;
+
+    double residual[TAA3040_EQ_MAX_POINTS];
+    for (uint8_t i = 0; i < pr->count; ++i)
+        residual[i] = pr->points[i].gain_db - p[0];
+
+    for (uint8_t k = 0; k < pr->sections; ++k)
+    {
+        uint8_t worst = 0;
+        for (uint8_t i = 1; i < pr->count; ++i)
+            if (pr->points[i].weight > 0.0f && fabs(residual[i]) > fabs(residual[worst]))
+                worst = i;
+
+        p[1 + 3 * k] = log(pr->points[worst].frequency_hz);
+        p[2 + 3 * k] = residual[worst];
+        p[3 + 3 * k] = log(1.0);
+        taa3040_eq_limit(pr, p);
+
+        const taa3040_eq_section_t s = taa3040_eq_param_section(pr, p, k);
+        for (uint8_t i = 0; i < pr->count; ++i)
+            residual[i] -= taa3040_eq_section_db(&s, pr->cos1[i], pr->cos2[i]);
+    }
+}
+
+static int32_t taa3040_eq_q31(const double v)
+{
+    const double scaled = floor(v * TAA3040_EQ_Q31 + 0.5);
+    if (scaled >= TAA3040_EQ_Q31)
+        return INT32_MAX;
+    if (scaled < -TAA3040_EQ_Q31)
+        return INT32_MIN;
+    return (int32_t)scaled;
+}
+
+/** @brief Quantize a section, scaling its numerator into range; returns the gain taken out in dB */
+static double taa3040_eq_quantize(const taa3040_eq_section_t *const s, taa3040_biquad_filter_t *const f)
+{
+    double peak = fabs(s->b0);
+    if (fabs(s->b2) > peak)
+        peak = fabs(s->b2);
+    if (fabs(s->b1) / 2.0 > peak)
+        peak = fabs(s->b1) / 2.0;
+
+    const double scale = peak > TAA3040_EQ_HEADROOM? TAA3040_EQ_HEADROOM / peak: 1.0;
+
+    // H(z) = (n0 + 2 n1 z^-1 + n2 z^-2) / (2^31 - 2 d1 z^-1 - d2 z^-2)
+    f->n0 = taa3040_eq_q31(s->b0 * scale);
+    f->n1 = taa3040_eq_q31(s->b1 * scale / 2.0);
+    f->n2 = taa3040_eq_q31(s->b2 * scale);
+    f->d1 = taa3040_eq_q31(-s->a1 / 2.0);
+    f->d2 = taa3040_eq_q31(-s->a2);
+    return -20.0 * log10(scale);
+}
+
+static taa3040_eq_section_t taa3040_eq_dequantize(const taa3040_biquad_filter_t *const f)
+{
+    return (taa3040_eq_section_t) {
+        .b0 = f->n0 / TAA3040_EQ_Q31,
+        .b1 = 2.0 * f->n1 / TAA3040_EQ_Q31,
+        .b2 = f->n2 / TAA3040_EQ_Q31,
+        .a1 = -2.0 * f->d1 / TAA3040_EQ_Q31,
+        .a2 = -f->d2 / TAA3040_EQ_Q31,
+    };
+}
+
+static void taa3040_eq_passthrough(taa3040_biquad_filter_t *const f)
+{
+    *f = (taa3040_biquad_filter_t){ .n0 = INT32_MAX };
+}
+
+/* === EQ Fitting === */
+bool taa3040_eq_biquad_index(const uint8_t channel, const uint8_t section, const uint8_t biquads_per_channel, uint8_t *const index)
+{
+    if (!index || !biquads_per_channel || biquads_per_channel > TAA3040_EQ_MAX_SECTIONS || section >= biquads_per_channel
+    ||  channel >= TAA3040_EQ_CHANNELS_SERVED[biquads_per_channel])
+        return false;
+
+    // Section k of every served channel is one run of biquads, the runs follow each other
+    *index = (uint8_t)(channel + section * TAA3040_EQ_CHANNELS_SERVED[biquads_per_channel]);
+    return true;
+}
+
+bool taa3040_eq_fit(const taa3040_eq_point_t *const points, const uint8_t count, const uint32_t sample_rate, const uint8_t sections,
+                    taa3040_biquad_filter_t *const filters, taa3040_eq_fit_t *const fit)
+{
+    if (!points || !count || count > TAA3040_EQ_MAX_POINTS || !sample_rate || !sections || sections > TAA3040_EQ_MAX_SECTIONS || !filters)
+        return false;
+
+    taa3040_eq_problem_t pr = { .points = points, .count = count, .sections = sections, .sample_rate = sample_rate };
+    double weight = 0.0;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        if (!(points[i].frequency_hz > 0.0f) || points[i].frequency_hz >= sample_rate / 2.0f || points[i].weight < 0.0f)
+            return false;
+
+        const double w = 2.0 * TAA3040_EQ_PI * points[i].frequency_hz / sample_rate;
+        pr.cos1[i] = cos(w);
+        pr.cos2[i] = cos(2.0 * w);
+        weight += points[i].weight;
+    }
+    if (!(weight > 0.0))
+        return false;
+
+    double p[TAA3040_EQ_PARAMS] = {0};
+    taa3040_eq_start(&pr, p);
+    double cost = taa3040_eq_cost(&pr, p);
+
+    const uint8_t n = (uint8_t)(1 + 3 * sections);
+    double lambda = 1e-3;
+    uint8_t it = 0;
+    while (it < TAA3040_EQ_MAX_ITERATIONS && cost > 1e-12)
+    {
+        ++it;
+        double a[TAA3040_EQ_PARAMS][TAA3040_EQ_PARAMS], g[TAA3040_EQ_PARAMS];
+        taa3040_eq_normal(&pr, p, a, g);
+
+        // Raise the damping until a step lowers the cost
+        bool improved = false;
+        double next[TAA3040_EQ_PARAMS], next_cost = cost;
+        while (lambda < 1e10)
+        {
+            double m[TAA3040_EQ_PARAMS][TAA3040_EQ_PARAMS], d[TAA3040_EQ_PARAMS];
+            for (uint8_t r = 0; r < n; ++r)
+            {
+                for (uint8_t c = 0; c < n; ++c)
+                    m[r][c] = a[r][c];
+                m[r][r] += lambda * a[r][r] + 1e-12;
+                d[r] = -g[r];
+            }
+
+            if (taa3040_eq_solve(m, d, n))
+            {
+                memcpy(next, p, sizeof(next));
+                for (uint8_t r = 0; r < n; ++r)
+                    next[r] += d[r];
+                taa3040_eq_limit(&pr, next);
+                next_cost = taa3040_eq_cost(&pr, next);
+                if (next_cost < cost)
+                {
+                    improved = true;
+                    break;
+                }
+            }
+            lambda *= 4.0;
+        }
+
+        if (!improved)
+            break;
+
+        const double gain = cost - next_cost;
+        memcpy(p, next, sizeof(next));
+        cost = next_cost;
+        lambda = lambda / 3.0 > 1e-9? lambda / 3.0: 1e-9;
+        if (gain < 1e-9 * cost)
+            break;
+    }
+
+    // Quantize; what the numerators could not carry goes to the makeup gain
+    double makeup = p[0];
+    taa3040_eq_section_t q[TAA3040_EQ_MAX_SECTIONS];
+    for (uint8_t k = 0; k < sections; ++k)
+    {
+        const taa3040_eq_section_t s = taa3040_eq_param_section(&pr, p, k);
+        makeup += taa3040_eq_quantize(&s, &filters[k]);
+        q[k] = taa3040_eq_dequantize(&filters[k]);
+    }
+
+    if (fit)
+    {
+        double sum = 0.0, worst = 0.0;
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            if (points[i].weight <= 0.0f)
+                continue;
+
+            double model = makeup;
+            for (uint8_t k = 0; k < sections; ++k)
+                model += taa3040_eq_section_db(&q[k], pr.cos1[i], pr.cos2[i]);
+
+            const double e = fabs(model - points[i].gain_db);
+            sum += points[i].weight * e * e;
+            worst = e > worst? e: worst;
+        }
+
+        fit->makeup_db = (float)makeup;
+        fit->rms_error_db = (float)sqrt(sum / weight);
+        fit->max_error_db = (float)worst;
+        fit->iterations = it;
+    }
+    return true;
+}
+
+bool taa3040_eq_plan(taa3040_dsp_config_t *const dsp_config, const taa3040_eq_target_t targets[TAA3040_NUM_CHANNELS],
+                     const uint32_t sample_rate, taa3040_eq_fit_t fits[TAA3040_NUM_CHANNELS])
+{
+    if (!dsp_config || !targets)
+        return false;
+
+    for (uint8_t i = 0; i < TAA3040_NUM_BIQUADS; ++i)
+        taa3040_eq_passthrough(&dsp_config->biquad_filters[i]);
+
+    const uint8_t sections = dsp_config->biquads_per_channel;
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        if (fits)
+            fits[ch] = (taa3040_eq_fit_t){0};
+        if (!targets[ch].points)
+            continue;
+
+        taa3040_biquad_filter_t filters[TAA3040_EQ_MAX_SECTIONS];
+        uint8_t index;
+        if (!taa3040_eq_biquad_index(ch, 0, sections, &index)
+        ||  !taa3040_eq_fit(targets[ch].points, targets[ch].point_count, sample_rate, sections, filters, fits? &fits[ch]: NULL))
+            return false;
+
+        for (uint8_t k = 0; k < sections; ++k)
+            if (taa3040_eq_biquad_index(ch, k, sections, &index))
+                dsp_config->biquad_filters[index] = filters[k];
+    }
+    return true;
+}
+
+float taa3040_eq_response_db(const taa3040_biquad_filter_t *const filters, const uint8_t count, const uint32_t sample_rate,
+                             const float frequency_hz)
+{
+    if (!filters || !sample_rate)
+        return 0.0f;
+
+    const double w = 2.0 * TAA3040_EQ_PI * frequency_hz / sample_rate;
+    const double c1 = cos(w), c2 = cos(2.0 * w);
+    double db = 0.0;
+    for (uint8_t k = 0; k < count; ++k)
+    {
+        const taa3040_eq_section_t s = taa3040_eq_dequantize(&filters[k]);
+        db += taa3040_eq_section_db(&s, c1, c2);
+    }
+    return (float)db;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file taa3040_frame.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 host frame layout
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_frame.h"
+#include "taa3040.h"
+#include "taa3040_clock.h"
+#include <string.h>
+
+/* --- Internal Helpers --- */
+
+static uint8_t taa3040_frame_group_size(const taa3040_channel_summing_mode_t summing)
+{
+    return summing == TAA3040_CHANNEL_SUMMING_MODE_DUAL? 2: summing == TAA3040_CHANNEL_SUMMING_MODE_QUAD? 4: 1;
+}
+
+/** @brief Channels averaged together with a channel, in IN_CHANNEL_EN order */
+static uint8_t taa3040_frame_group(const uint8_t channel, const taa3040_channel_summing_mode_t summing)
+{
+    const uint8_t size = taa3040_frame_group_size(summing);
+    const uint8_t first = (uint8_t)(channel - channel % size);
+    uint8_t group = 0;
+    for (uint8_t ch = first; ch < first + size; ++ch)
+        group |= TAA3040_CHANNEL_BIT(ch);
+    return group;
+}
+
+/** @brief Enabled channels of one line, in slot order */
+static uint8_t taa3040_frame_line(const taa3040_asi_config_t *const asi, const bool gpio_output, uint8_t *const channels)
+{
+    uint8_t count = 0;
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        if (!asi->channel_configs[ch].enabled || asi->channel_configs[ch].gpio_output != gpio_output)
+            continue;
+
+        // Insertion sort, stable so equal slots keep channel order
+        uint8_t i = count++;
+        for (; i > 0 && asi->channel_configs[channels[i - 1]].slot > asi->channel_configs[ch].slot; --i)
+            channels[i] = channels[i - 1];
+        channels[i] = ch;
+    }
+    return count;
+}
+
+static void taa3040_frame_build(const taa3040_asi_config_t *const asi, const taa3040_channel_summing_mode_t summing,
+                                taa3040_frame_t *const frame)
+{
+    memset(frame, 0, sizeof(*frame));
+    frame->word_length = asi->word_length;
+    frame->summing = summing;
+    if ((unsigned)asi->master_mode.sample_rate < TAA3040_CLOCK_NUM_SAMPLE_RATES)
+        frame->sample_rate_hz = TAA3040_SAMPLE_RATE_HZ(asi->master_mode.sample_rate, asi->master_mode.sample_rate_48khz);
+
+    for (uint8_t line = 0; line < 2; ++line)
+    {
+        uint8_t channels[TAA3040_NUM_CHANNELS];
+        const uint8_t count = taa3040_frame_line(asi, line, channels);
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            const uint8_t ch = channels[i];
+            frame->word[frame->words++] = (taa3040_frame_word_t){
+                .channel = ch,
+                .slot = asi->channel_configs[ch].slot,
+                .sources = taa3040_frame_group(ch, summing),
+                .gpio_output = line,
+            };
+            frame->output_mask |= TAA3040_CHANNEL_BIT(ch);
+        }
+
+        const uint16_t bits = (uint16_t)(count * TAA3040_WORD_LENGTH_BITS(asi->word_length));
+        if (bits > frame->used_bits)
+            frame->used_bits = bits;
+    }
+}
+
+/* === Frame Layout === */
+bool taa3040_frame_describe(const taa3040_config_t *const config, taa3040_frame_t *const frame)
+{
+    if (!config || !frame)
+        return false;
+
+    taa3040_frame_build(&config->asi_config, config->dsp_config.channel_summing, frame);
+    return true;
+}
+
+bool taa3040_frame_compact(taa3040_asi_config_t *const asi_config, const taa3040_channel_summing_mode_t summing)
+{
+    if (!asi_config || summing >= TAA3040_CHANNEL_SUMMING_MODE_RESERVED)
+        return false;
+
+    if (summing == TAA3040_CHANNEL_SUMMING_MODE_NONE)
+        return true;
+
+    // Keep the first enabled channel of each group
+    const uint8_t size = taa3040_frame_group_size(summing);
+    for (uint8_t first = 0; first < TAA3040_NUM_CHANNELS; first += size)
+    {
+        bool kept = false;
+        for (uint8_t ch = first; ch < first + size; ++ch)
+        {
+            if (kept)
+                asi_config->channel_configs[ch].enabled = false;
+            kept |= asi_config->channel_configs[ch].enabled;
+        }
+    }
+
+    if (asi_config->mode != TAA3040_ASI_MODE_TDM)
+        return true;
+
+    for (uint8_t line = 0; line < 2; ++line)
+    {
+        uint8_t channels[TAA3040_NUM_CHANNELS];
+        const uint8_t count = taa3040_frame_line(asi_config, line, channels);
+        if (!count)
+            continue;
+
+        const uint8_t base = asi_config->channel_configs[channels[0]].slot;
+        for (uint8_t i = 0; i < count; ++i)
+            asi_config->channel_configs[channels[i]].slot = (uint8_t)(base + i);
+    }
+    return true;
+}
+
+/* === Publishing === */
+void taa3040_frame_publisher_init(taa3040_frame_publisher_t *const publisher)
+{
+    if (!publisher)
+        return;
+
+    memset(publisher, 0, sizeof(*publisher));
+}
+
+bool taa3040_frame_subscribe(taa3040_frame_publisher_t *const publisher, const taa3040_frame_change_fn on_change, void *const context)
+{
+    if (!publisher || !on_change || publisher->consumer_count >= TAA3040_FRAME_MAX_CONSUMERS)
+        return false;
+
+    publisher->consumers[publisher->consumer_count] = on_change;
+    publisher->contexts[publisher->consumer_count] = context;
+    ++publisher->consumer_count;
+    return true;
+}
+
+bool taa3040_frame_publish(taa3040_frame_publisher_t *const publisher, const taa3040_frame_t *const frame)
+{
+    if (!publisher || !frame || !memcmp(&publisher->current, frame, sizeof(*frame)))
+        return false;
+
+    const taa3040_frame_t previous = publisher->current;
+    publisher->current = *frame;
+    ++publisher->changes;
+    for (uint8_t i = 0; i < publisher->consumer_count; ++i)
+        publisher->consumers[i](publisher->contexts[i], &previous, &publisher->current);
+    return true;
+}
+
+bool taa3040_frame_apply(const taa3040_t *const dev, const taa3040_config_t *const config, taa3040_frame_publisher_t *const publisher,
+                         taa3040_frame_t *const frame)
+{
+    if (!dev || !config)
+        return false;
+
+    taa3040_asi_config_t asi = config->asi_config;
+    if (!taa3040_frame_compact(&asi, config->dsp_config.channel_summing) || !taa3040_set_asi_config(dev, &asi))
+        return false;
+
+    taa3040_frame_t built;
+    taa3040_frame_build(&asi, config->dsp_config.channel_summing, &built);
+    if (publisher)
+        taa3040_frame_publish(publisher, &built);
+    if (frame)
+        *frame = built;
+    return true;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file taa3040_gpio.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 GPIO fast path
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_gpio.h"
+#include "taa3040.h"
+#include "taa3040_registers.h"
+#include <string.h>
+
+#define TAA3040_GPO_VALUES_MASK     (TAA3040_GPO1_VALUE_MASK | TAA3040_GPO2_VALUE_MASK | TAA3040_GPO3_VALUE_MASK | TAA3040_GPO4_VALUE_MASK)
+#define TAA3040_GPI_MONITORS_MASK   (TAA3040_GPI1_MONITOR_MASK | TAA3040_GPI2_MONITOR_MASK | TAA3040_GPI3_MONITOR_MASK | TAA3040_GPI4_MONITOR_MASK)
+#define TAA3040_GPI_SAMPLE_LENGTH   (TAA3040_REG_GPI_MONITOR - TAA3040_REG_GPIO1_MONITOR + 1)
+
+/* --- Internal Helpers --- */
+
+static inline uint8_t taa3040_gpo_bit(const uint8_t index)
+{
+    return (uint8_t)(TAA3040_GPO1_VALUE_MASK >> index);
+}
+
+/* === Outputs === */
+bool taa3040_gpo_init(taa3040_gpo_t *const gpo, const taa3040_t *const dev, const uint8_t levels)
+{
+    if (!gpo || !dev)
+        return false;
+
+    const uint8_t value = levels & TAA3040_GPO_VALUES_MASK;
+    if (!taa3040_write_registers(dev, TAA3040_REG_GPO_VALUE, &value, 1))
+        return false;
+
+    gpo->value = value;
+    return true;
+}
+
+bool taa3040_gpo_write(taa3040_gpo_t *const gpo, const taa3040_t *const dev, const uint8_t mask, const uint8_t levels)
+{
+    if (!gpo || !dev)
+        return false;
+
+    const uint8_t m = mask & TAA3040_GPO_VALUES_MASK;
+    const uint8_t value = (uint8_t)((gpo->value & ~m) | (levels & m));
+    if (value == gpo->value)
+        return true;
+
+    if (!taa3040_write_registers(dev, TAA3040_REG_GPO_VALUE, &value, 1))
+        return false;
+
+    gpo->value = value;
+    return true;
+}
+
+bool taa3040_gpo_set(taa3040_gpo_t *const gpo, const taa3040_t *const dev, const uint8_t index, const bool level)
+{
+    if (index >= TAA3040_NUM_GPO)
+        return false;
+
+    const uint8_t bit = taa3040_gpo_bit(index);
+    return taa3040_gpo_write(gpo, dev, bit, level? bit: 0);
+}
+
+bool taa3040_gpo_toggle(taa3040_gpo_t *const gpo, const taa3040_t *const dev, const uint8_t index)
+{
+    if (!gpo || index >= TAA3040_NUM_GPO)
+        return false;
+
+    const uint8_t bit = taa3040_gpo_bit(index);
+    return taa3040_gpo_write(gpo, dev, bit, (uint8_t)~gpo->value);
+}
+
+/* === Inputs === */
+bool taa3040_gpi_sample(const taa3040_t *const dev, uint8_t *const levels)
+{
+    if (!dev || !levels)
+        return false;
+
+    // The GPI configuration sits between the two monitors, reading it along keeps this one transfer
+    uint8_t regs[TAA3040_GPI_SAMPLE_LENGTH];
+    if (!taa3040_read_registers(dev, TAA3040_REG_GPIO1_MONITOR, regs, sizeof(regs)))
+        return false;
+
+    const uint8_t gpio1 = regs[0] & TAA3040_GPIO1_MON_MASK;
+    *levels = (uint8_t)((regs[TAA3040_GPI_SAMPLE_LENGTH - 1] & TAA3040_GPI_MONITORS_MASK)
+            | (gpio1? TAA3040_GPI_INPUT_BIT(TAA3040_GPI_INPUT_GPIO1): 0));
+    return true;
+}
+
+void taa3040_gpi_monitor_init(taa3040_gpi_monitor_t *const mon, const uint8_t debounce, const uint8_t rising_mask,
+                              const uint8_t falling_mask, const taa3040_gpi_edge_fn on_edge, void *const context)
+{
+    if (!mon)
+        return;
+
+    memset(mon, 0, sizeof(*mon));
+    mon->debounce = debounce;
+    mon->rising_mask = rising_mask & TAA3040_GPI_INPUTS_MASK;
+    mon->falling_mask = falling_mask & TAA3040_GPI_INPUTS_MASK;
+    mon->on_edge = on_edge;
+    mon->context = context;
+}
+
+uint8_t taa3040_gpi_monitor_update(taa3040_gpi_monitor_t *const mon, const uint8_t levels)
+{
+    if (!mon)
+        return 0;
+
+    const uint8_t sample = levels & TAA3040_GPI_INPUTS_MASK;
+    if (!mon->primed)
+    {
+        mon->levels = sample;
+        mon->primed = true;
+        return 0;
+    }
+
+    uint8_t changed = 0;
+    for (uint8_t i = 0; i < TAA3040_GPI_NUM_INPUTS; ++i)
+    {
+        const uint8_t bit = TAA3040_GPI_INPUT_BIT(i);
+        if (!((sample ^ mon->levels) & bit))
+        {
+            mon->counts[i] = 0;
+            continue;
+        }
+
+        if (++mon->counts[i] < mon->debounce)
+            continue;
+
+        mon->counts[i] = 0;
+        mon->levels ^= bit;
+        changed |= bit;
+    }
+
+    // Edges are reported once the levels are consistent, so a callback may poll again
+    if (mon->on_edge)
+    {
+        for (uint8_t i = 0; i < TAA3040_GPI_NUM_INPUTS; ++i)
+        {
+            const uint8_t bit = TAA3040_GPI_INPUT_BIT(i);
+            const bool level = mon->levels & bit;
+            if ((changed & bit) && ((level? mon->rising_mask: mon->falling_mask) & bit))
+                mon->on_edge(mon->context, i, level);
+        }
+    }
+
+    return changed;
+}
+
+bool taa3040_gpi_monitor_poll(taa3040_gpi_monitor_t *const mon, const taa3040_t *const dev, uint8_t *const changed)
+{
+    if (!mon || !dev)
+        return false;
+
+    uint8_t levels;
+    if (!taa3040_gpi_sample(dev, &levels))
+        return false;
+
+    const uint8_t c = taa3040_gpi_monitor_update(mon, levels);
+    if (changed)
+        *changed = c;
+    return true;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file taa3040_health.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 health monitor
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_health.h"
+#include "taa3040_image.h"
+#include "taa3040_sequencer.h"
+#include "taa3040.h"
+
+#define TAA3040_HEALTH_MAX_RUN      (TAA3040_BIQUADS_PER_PAGE * TAA3040_BIQUAD_SECTION_BYTES) ///< Longest run, a biquad page
+#define TAA3040_HEALTH_LATCH_OFFSET (TAA3040_IMAGE_OFFSET_INTERRUPT + TAA3040_REG_INTERRUPT_LATCH - TAA3040_REG_INTERRUPT_CONFIG)
+
+/* --- Internal Helpers --- */
+
+static bool taa3040_health_restore(taa3040_health_t *const health, const taa3040_t *const dev, taa3040_health_report_t *const r)
+{
+    // Wake first, nothing else may be written until the device is up
+    if (!taa3040_write_registers(dev, TAA3040_REG_SLEEP_CFG, &health->image[TAA3040_IMAGE_OFFSET_SLEEP], 1))
+        return false;
+    health->delay_us(TAA3040_SEQUENCER_WAKE_US);
+
+    if (!taa3040_write_image(dev, health->image))
+        return false;
+
+    r->flags |= TAA3040_HEALTH_RESET;
+    r->bytes_repaired = TAA3040_IMAGE_SIZE;
+    ++health->resets;
+    return true;
+}
+
+/* Coefficients may only change with the channels powered down, as in the sequencer */
+static bool taa3040_health_write_coefficients(const taa3040_t *const dev, const taa3040_image_run_t *const run, const uint8_t reg,
+                                              const uint8_t *const data, const uint8_t length)
+{
+    uint8_t enabled = 0;
+    if (!taa3040_set_page(dev, 0) || !taa3040_read_registers(dev, TAA3040_REG_IN_CHANNEL_EN, &enabled, 1))
+        return false;
+
+    const uint8_t off = 0;
+    const bool ok = (!enabled || taa3040_write_registers(dev, TAA3040_REG_IN_CHANNEL_EN, &off, 1))
+                 && taa3040_set_page(dev, run->page)
+                 && taa3040_write_registers(dev, reg, data, length);
+    if (!enabled)
+        return ok;
+
+    // Power the channels back up whatever happened, then return to the run's page
+    return taa3040_set_page(dev, 0)
+        && taa3040_write_registers(dev, TAA3040_REG_IN_CHANNEL_EN, &enabled, 1)
+        && taa3040_set_page(dev, run->page)
+        && ok;
+}
+
+static bool taa3040_health_check_run(const taa3040_t *const dev, const uint8_t *const image, const taa3040_image_run_t *const run,
+                                     taa3040_health_report_t *const r)
+{
+    uint8_t regs[TAA3040_HEALTH_MAX_RUN];
+    if (!taa3040_read_registers(dev, run->reg, regs, run->length))
+        return false;
+
+    ++r->runs_checked;
+    r->bytes_checked += run->length;
+
+    const uint8_t *const expected = &image[run->offset];
+    int first = -1, last = -1;
+    for (uint8_t i = 0; i < run->length; ++i)
+    {
+        // The latch reflects events, not configuration
+        if (run->offset + i == TAA3040_HEALTH_LATCH_OFFSET || regs[i] == expected[i])
+            continue;
+        if (first < 0)
+            first = i;
+        last = i;
+    }
+
+    if (first < 0)
+        return true;
+
+    const uint8_t length = (uint8_t)(last - first + 1);
+    const uint8_t reg = (uint8_t)(run->reg + first);
+    if (run->page != 0? !taa3040_health_write_coefficients(dev, run, reg, &expected[first], length)
+                      : !taa3040_write_registers(dev, reg, &expected[first], length))
+        return false;
+
+    r->flags |= TAA3040_HEALTH_DIVERGED;
+    ++r->runs_repaired;
+    r->bytes_repaired += length;
+    return true;
+}
+
+/* === Health Monitor === */
+bool taa3040_health_init(taa3040_health_t *const health, const uint8_t *const image, void (*const delay_us)(const uint32_t us))
+{
+    if (!health || !image || !delay_us)
+        return false;
+
+    *health = (taa3040_health_t) { .image = image, .delay_us = delay_us };
+    return true;
+}
+
+bool taa3040_health_check(taa3040_health_t *const health, const taa3040_t *const dev, const uint16_t budget,
+                          taa3040_health_report_t *const report)
+{
+    if (!health || !health->image || !dev)
+        return false;
+
+    taa3040_health_report_t r = {0};
+    ++health->checks;
+
+    if (!taa3040_read_registers(dev, TAA3040_REG_ASI_STATUS, &r.asi_status, 1)
+    ||  !taa3040_read_registers(dev, TAA3040_REG_INTERRUPT_LATCH, &r.latch, 1))
+        return false;
+
+    if (r.latch & TAA3040_INTERRUPT_ASI_ERROR_MASK)
+        r.flags |= TAA3040_HEALTH_ASI_ERROR;
+    if (r.latch & TAA3040_INTERRUPT_PLL_ERROR_MASK)
+        r.flags |= TAA3040_HEALTH_PLL_ERROR;
+
+    // Checked every time: a reset is the one fault the run checks could not repair piecemeal
+    if (!(health->skip_runs & 1))
+    {
+        uint8_t sleep_cfg;
+        if (!taa3040_read_registers(dev, TAA3040_REG_SLEEP_CFG, &sleep_cfg, 1))
+            return false;
+
+        ++r.runs_checked;
+        ++r.bytes_checked;
+        if (sleep_cfg != health->image[TAA3040_IMAGE_OFFSET_SLEEP])
+        {
+            r.flags |= TAA3040_HEALTH_DIVERGED;
+            if (!taa3040_health_restore(health, dev, &r))
+                return false;
+
+            ++health->repairs;
+            if (report)
+                *report = r;
+            return true;
+        }
+    }
+
+    uint8_t page = 0;
+    bool ok = true;
+    for (uint8_t n = 0; n < TAA3040_IMAGE_NUM_RUNS && r.bytes_checked < budget; ++n)
+    {
+        const uint8_t i = health->next_run;
+        health->next_run = (uint8_t)((i + 1) % TAA3040_IMAGE_NUM_RUNS);
+
+        const taa3040_image_run_t *const run = &TAA3040_IMAGE_RUNS[i];
+        if (run->offset == TAA3040_IMAGE_OFFSET_SLEEP || (health->skip_runs & (1UL << i)))
+            continue;
+
+        if (run->page != page)
+        {
+            if (!(ok = taa3040_set_page(dev, run->page)))
+                break;
+            page = run->page;
+        }
+
+        if (!(ok = taa3040_health_check_run(dev, health->image, run, &r)))
+            break;
+    }
+
+    if (page != 0 && !taa3040_set_page(dev, 0))
+        ok = false;
+    if (!ok)
+        return false;
+
+    if (r.runs_repaired)
+        ++health->repairs;
+    if (report)
+        *report = r;
+    return true;
+}
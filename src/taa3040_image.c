@@ -0,0 +1,406 @@
+/**
+ * @file taa3040_image.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 register encoding and decoding
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_image.h"
+#include "taa3040_registers.h"
+#include <string.h>
+
+/* === Register Image Layout === */
+const taa3040_image_run_t TAA3040_IMAGE_RUNS[TAA3040_IMAGE_NUM_RUNS] =
+{
+    { .page = 0, .reg = TAA3040_REG_SLEEP_CFG,            .length = 1,   .offset = TAA3040_IMAGE_OFFSET_SLEEP },
+    { .page = 0, .reg = TAA3040_REG_SHUTDOWN_CFG,         .length = 1,   .offset = TAA3040_IMAGE_OFFSET_SHUTDOWN },
+    { .page = 0, .reg = TAA3040_REG_ASI_CONFIG0,          .length = 3,   .offset = TAA3040_IMAGE_OFFSET_ASI },
+    { .page = 0, .reg = TAA3040_REG_ASI_CHANNEL_BASE,     .length = 10,  .offset = TAA3040_IMAGE_OFFSET_ASI_SLOTS }, // Slots and master config
+    { .page = 0, .reg = TAA3040_REG_CLOCK_SOURCE,         .length = 1,   .offset = TAA3040_IMAGE_OFFSET_CLOCK_SRC },
+    { .page = 0, .reg = TAA3040_REG_PDMCLK_CONFIG,        .length = 2,   .offset = TAA3040_IMAGE_OFFSET_PDM },
+    { .page = 0, .reg = TAA3040_REG_GPO_CONFIG_BASE,      .length = 4,   .offset = TAA3040_IMAGE_OFFSET_GPO },
+    { .page = 0, .reg = TAA3040_REG_GPI_CONFIG_BASE,      .length = 2,   .offset = TAA3040_IMAGE_OFFSET_GPI },
+    { .page = 0, .reg = TAA3040_REG_INTERRUPT_CONFIG,     .length = 3,   .offset = TAA3040_IMAGE_OFFSET_INTERRUPT },
+    { .page = 0, .reg = TAA3040_BLOCK_CHANNEL_START,      .length = 40,  .offset = TAA3040_IMAGE_OFFSET_CHANNEL },
+    { .page = 0, .reg = TAA3040_REG_DSP_CONFIG0,          .length = 2,   .offset = TAA3040_IMAGE_OFFSET_DSP },
+    { .page = 0, .reg = TAA3040_REG_AGC_CONFIG,           .length = 1,   .offset = TAA3040_IMAGE_OFFSET_AGC },
+    { .page = TAA3040_PAGE_BIQUAD_FILTER_1, .reg = TAA3040_REG_BIQUAD_COEFF_BASE, .length = 120, .offset = TAA3040_IMAGE_OFFSET_BIQUAD_1 },
+    { .page = TAA3040_PAGE_BIQUAD_FILTER_2, .reg = TAA3040_REG_BIQUAD_COEFF_BASE, .length = 120, .offset = TAA3040_IMAGE_OFFSET_BIQUAD_2 },
+    { .page = TAA3040_PAGE_MIXER_CONTROL,   .reg = TAA3040_REG_MIXER_MATRIX_BASE, .length = 64,  .offset = TAA3040_IMAGE_OFFSET_MIXER },
+    { .page = TAA3040_PAGE_IIR_COEFF,       .reg = TAA3040_REG_IIR_COEFF_START,   .length = 12,  .offset = TAA3040_IMAGE_OFFSET_IIR },
+    { .page = 0, .reg = TAA3040_REG_IN_CHANNEL_EN,        .length = 3,   .offset = TAA3040_IMAGE_OFFSET_ENABLES }, // Enables and power last
+};
+
+/* === Block Codecs (Page 0) === */
+void taa3040_encode_system_config(const taa3040_system_config_t *const config, uint8_t *const page0)
+{
+    page0[TAA3040_REG_SLEEP_CFG] = TAA3040_SLEEP_DISABLE_MASK
+                                |  (config->avdd_is_3v3? TAA3040_AREG_SELECT_MASK: 0)
+                                |  ((config->advanced.vref_qc_time << TAA3040_VREF_QCHRG_SHIFT) & TAA3040_VREF_QCHRG_MASK);
+
+    page0[TAA3040_REG_SHUTDOWN_CFG] = ((config->shutdown_mode << TAA3040_SHDNZ_CFG_SHIFT) & TAA3040_SHDNZ_CFG_MASK)
+                                    | ((config->advanced.input_qc_time << TAA3040_INCAP_QCHG_SHIFT) & TAA3040_INCAP_QCHG_MASK)
+                                    | ((config->advanced.dreg_shutdown_time << TAA3040_DREG_KA_TIME_SHIFT) & TAA3040_DREG_KA_TIME_MASK);
+
+    page0[TAA3040_REG_PDMCLK_CONFIG] = (config->advanced.pdm_clock << TAA3040_PDMCLK_DIVIDER_SHIFT) & TAA3040_PDMCLK_DIVIDER_MASK;
+
+    page0[TAA3040_REG_PDMIN_CONFIG] = (config->advanced.pdm_latching_edge[0]? TAA3040_PDMDIN1_EDGE_MASK: 0)
+                                    | (config->advanced.pdm_latching_edge[1]? TAA3040_PDMDIN2_EDGE_MASK: 0)
+                                    | (config->advanced.pdm_latching_edge[2]? TAA3040_PDMDIN3_EDGE_MASK: 0)
+                                    | (config->advanced.pdm_latching_edge[3]? TAA3040_PDMDIN4_EDGE_MASK: 0);
+
+    page0[TAA3040_REG_POWER_CONFIG] = (config->adc_enabled? TAA3040_ADC_ENABLE_MASK: 0)
+                                    | (config->pll_enabled? TAA3040_PLL_ENABLE_MASK: 0)
+                                    | (config->mic_bias_enabled? TAA3040_MIC_BIAS_ENABLE_MASK: 0)
+                                    | (config->dynamic_power_mode? TAA3040_DYNAMIC_POWER_MASK: 0)
+                                    | ((config->advanced.dynamic_mode_channels << TAA3040_DYNAMIC_POWER_CHANNELS_SHIFT) & TAA3040_DYNAMIC_POWER_CHANNELS_MASK);
+}
+
+void taa3040_decode_system_config(const uint8_t *const page0, taa3040_system_config_t *const config)
+{
+    const uint8_t sleep_cfg = page0[TAA3040_REG_SLEEP_CFG];
+    config->avdd_is_3v3 = !!(sleep_cfg & TAA3040_AREG_SELECT_MASK);
+    config->advanced.vref_qc_time = (sleep_cfg & TAA3040_VREF_QCHRG_MASK) >> TAA3040_VREF_QCHRG_SHIFT;
+
+    const uint8_t shutdown_cfg = page0[TAA3040_REG_SHUTDOWN_CFG];
+    config->shutdown_mode = (shutdown_cfg & TAA3040_SHDNZ_CFG_MASK) >> TAA3040_SHDNZ_CFG_SHIFT;
+    config->advanced.input_qc_time = (shutdown_cfg & TAA3040_INCAP_QCHG_MASK) >> TAA3040_INCAP_QCHG_SHIFT;
+    config->advanced.dreg_shutdown_time = (shutdown_cfg & TAA3040_DREG_KA_TIME_MASK) >> TAA3040_DREG_KA_TIME_SHIFT;
+
+    config->advanced.pdm_clock = (page0[TAA3040_REG_PDMCLK_CONFIG] & TAA3040_PDMCLK_DIVIDER_MASK) >> TAA3040_PDMCLK_DIVIDER_SHIFT;
+
+    const uint8_t pdmin = page0[TAA3040_REG_PDMIN_CONFIG];
+    config->advanced.pdm_latching_edge[0] = !!(pdmin & TAA3040_PDMDIN1_EDGE_MASK);
+    config->advanced.pdm_latching_edge[1] = !!(pdmin & TAA3040_PDMDIN2_EDGE_MASK);
+    config->advanced.pdm_latching_edge[2] = !!(pdmin & TAA3040_PDMDIN3_EDGE_MASK);
+    config->advanced.pdm_latching_edge[3] = !!(pdmin & TAA3040_PDMDIN4_EDGE_MASK);
+
+    const uint8_t pwr = page0[TAA3040_REG_POWER_CONFIG];
+    config->adc_enabled = !!(pwr & TAA3040_ADC_ENABLE_MASK);
+    config->pll_enabled = !!(pwr & TAA3040_PLL_ENABLE_MASK);
+    config->mic_bias_enabled = !!(pwr & TAA3040_MIC_BIAS_ENABLE_MASK);
+    config->dynamic_power_mode = !!(pwr & TAA3040_DYNAMIC_POWER_MASK);
+    config->advanced.dynamic_mode_channels = (pwr & TAA3040_DYNAMIC_POWER_CHANNELS_MASK) >> TAA3040_DYNAMIC_POWER_CHANNELS_SHIFT;
+}
+
+void taa3040_encode_asi_config(const taa3040_asi_config_t *const a, uint8_t *const page0)
+{
+    page0[TAA3040_REG_ASI_CONFIG0] = ((a->mode << TAA3040_ASI_FORMAT_SHIFT) & TAA3040_ASI_FORMAT_MASK)
+                                |   ((a->word_length << TAA3040_ASI_WORD_LENGTH_SHIFT) & TAA3040_ASI_WORD_LENGTH_MASK)
+                                |   (a->fsync_polarity_inverted? TAA3040_FSYNC_POLARITY_MASK : 0)
+                                |   (a->bclk_polarity_inverted? TAA3040_BLCK_POLARITY_MASK : 0)
+                                |   (a->transmit_edge_inverted? TAA3040_TRANSMIT_EDGE_MASK : 0)
+                                |   (a->fill_zeros? TAA3040_TRANSMIT_FILL_MASK : 0);
+
+    page0[TAA3040_REG_ASI_CONFIG1] = (a->advanced.transmit_lsb_hiz ? TAA3040_TRANSMIT_LSB_MASK : 0)
+                                |   ((a->advanced.keeper_mode << TAA3040_TRANSMIT_KEEPER_SHIFT) & TAA3040_TRANSMIT_KEEPER_MASK)
+                                |   ((a->advanced.transmission_offset_cycles << TAA3040_TRANSMIT_OFFSET_SHIFT) & TAA3040_TRANSMIT_OFFSET_MASK);
+
+    page0[TAA3040_REG_ASI_CONFIG2] = (a->advanced.daisy_chain_connection? TAA3040_ASI_DAISY_MASK : 0)
+                                |   (a->advanced.error_detection? 0: TAA3040_ASI_ERROR_MASK)
+                                |   (a->advanced.error_recovery? 0: TAA3040_ASI_ERROR_RECOVERY_MASK);
+
+    page0[TAA3040_REG_MASTER_CONFIG0] = (a->slave_mode? 0: TAA3040_MASTER_SLAVE_CONFIG_MASK)
+                                |   (a->master_mode.sample_rate_48khz? 0: TAA3040_SAMPLE_RATE_MASK)
+                                |   (a->master_mode.automatic_clock_config? 0: TAA3040_AUTO_CLOCK_CONFIG_MASK)
+                                |   (a->master_mode.pll_disabled_autoclock? TAA3040_AUTO_MODE_PLL_MASK : 0)
+                                |   (a->master_mode.gate_clocks? TAA3040_BCLK_FSYNC_GATE_MASK : 0)
+                                |   ((a->master_mode.mclk_freq << TAA3040_MCLK_FREQ_SELECT_SHIFT) & TAA3040_MCLK_FREQ_SELECT_MASK);
+
+    page0[TAA3040_REG_MASTER_CONFIG1] = ((a->master_mode.bclk_fsync_ratio << TAA3040_FSYNC_BCLK_RATIO_SHIFT) & TAA3040_FSYNC_BCLK_RATIO_MASK)
+                                |   ((a->master_mode.sample_rate << TAA3040_FSYNC_RATE_SHIFT) & TAA3040_FSYNC_RATE_MASK);
+
+    page0[TAA3040_REG_CLOCK_SOURCE] = (a->slave_mclk_source? TAA3040_SLAVE_CLOCK_SOURCE_MASK : 0)
+                                |   (a->master_mode.mclk_ratio_mode? TAA3040_MCLK_FREQ_SEL_MASK : 0)
+                                |   ((a->master_mode.mclk_fsync_ratio << TAA3040_MCLK_RATIO_SEL_SHIFT) & TAA3040_MCLK_RATIO_SEL_MASK);
+
+    uint8_t channel_en = 0;
+    for(uint8_t channel = 0; channel < TAA3040_NUM_CHANNELS; ++channel)
+    {
+        const taa3040_asi_channel_config_t cc = a->channel_configs[channel];
+        page0[TAA3040_REG_ASI_CHANNEL_BASE + channel] = ((cc.slot << TAA3040_ASI_CHANNEL_SLOT_SHIFT) & TAA3040_ASI_CHANNEL_SLOT_MASK)
+                                                    |  (cc.gpio_output? TAA3040_ASI_CHANNEL_OUTPUT_MASK : 0);
+        if (cc.enabled)
+            channel_en |= TAA3040_CHANNEL_BIT(channel);
+    }
+
+    page0[TAA3040_REG_ASI_OUT_CHANNEL_EN] = channel_en;
+}
+
+void taa3040_decode_asi_config(const uint8_t *const page0, taa3040_asi_config_t *const a)
+{
+    const uint8_t config0 = page0[TAA3040_REG_ASI_CONFIG0];
+    a->mode = (config0 & TAA3040_ASI_FORMAT_MASK) >> TAA3040_ASI_FORMAT_SHIFT;
+    a->word_length = (config0 & TAA3040_ASI_WORD_LENGTH_MASK) >> TAA3040_ASI_WORD_LENGTH_SHIFT;
+    a->fsync_polarity_inverted = !!(config0 & TAA3040_FSYNC_POLARITY_MASK);
+    a->bclk_polarity_inverted = !!(config0 & TAA3040_BLCK_POLARITY_MASK);
+    a->transmit_edge_inverted = !!(config0 & TAA3040_TRANSMIT_EDGE_MASK);
+    a->fill_zeros = !!(config0 & TAA3040_TRANSMIT_FILL_MASK);
+
+    const uint8_t config1 = page0[TAA3040_REG_ASI_CONFIG1];
+    a->advanced.transmit_lsb_hiz = !!(config1 & TAA3040_TRANSMIT_LSB_MASK);
+    a->advanced.keeper_mode = (config1 & TAA3040_TRANSMIT_KEEPER_MASK) >> TAA3040_TRANSMIT_KEEPER_SHIFT;
+    a->advanced.transmission_offset_cycles = (config1 & TAA3040_TRANSMIT_OFFSET_MASK) >> TAA3040_TRANSMIT_OFFSET_SHIFT;
+
+    const uint8_t config2 = page0[TAA3040_REG_ASI_CONFIG2];
+    a->advanced.daisy_chain_connection = !!(config2 & TAA3040_ASI_DAISY_MASK);
+    a->advanced.error_detection = !(config2 & TAA3040_ASI_ERROR_MASK);
+    a->advanced.error_recovery = !(config2 & TAA3040_ASI_ERROR_RECOVERY_MASK);
+
+    const uint8_t master0 = page0[TAA3040_REG_MASTER_CONFIG0];
+    a->slave_mode = !(master0 & TAA3040_MASTER_SLAVE_CONFIG_MASK);
+    a->master_mode.sample_rate_48khz = !(master0 & TAA3040_SAMPLE_RATE_MASK);
+    a->master_mode.mclk_freq = (master0 & TAA3040_MCLK_FREQ_SELECT_MASK) >> TAA3040_MCLK_FREQ_SELECT_SHIFT;
+    a->master_mode.automatic_clock_config = !(master0 & TAA3040_AUTO_CLOCK_CONFIG_MASK);
+    a->master_mode.pll_disabled_autoclock = !!(master0 & TAA3040_AUTO_MODE_PLL_MASK);
+    a->master_mode.gate_clocks = !!(master0 & TAA3040_BCLK_FSYNC_GATE_MASK);
+
+    const uint8_t master1 = page0[TAA3040_REG_MASTER_CONFIG1];
+    a->master_mode.sample_rate = (master1 & TAA3040_FSYNC_RATE_MASK) >> TAA3040_FSYNC_RATE_SHIFT;
+    a->master_mode.bclk_fsync_ratio = (master1 & TAA3040_FSYNC_BCLK_RATIO_MASK) >> TAA3040_FSYNC_BCLK_RATIO_SHIFT;
+
+    const uint8_t clock_src = page0[TAA3040_REG_CLOCK_SOURCE];
+    a->slave_mclk_source = !!(clock_src & TAA3040_SLAVE_CLOCK_SOURCE_MASK);
+    a->master_mode.mclk_ratio_mode = !!(clock_src & TAA3040_MCLK_FREQ_SEL_MASK);
+    a->master_mode.mclk_fsync_ratio = (clock_src & TAA3040_MCLK_RATIO_SEL_MASK) >> TAA3040_MCLK_RATIO_SEL_SHIFT;
+
+    const uint8_t channel_en = page0[TAA3040_REG_ASI_OUT_CHANNEL_EN];
+    for(uint8_t channel = 0; channel < TAA3040_NUM_CHANNELS; ++channel)
+    {
+        const uint8_t v = page0[TAA3040_REG_ASI_CHANNEL_BASE + channel];
+        a->channel_configs[channel].gpio_output = !!(v & TAA3040_ASI_CHANNEL_OUTPUT_MASK);
+        a->channel_configs[channel].slot = (v & TAA3040_ASI_CHANNEL_SLOT_MASK) >> TAA3040_ASI_CHANNEL_SLOT_SHIFT;
+        a->channel_configs[channel].enabled = !!(channel_en & TAA3040_CHANNEL_BIT(channel));
+    }
+}
+
+void taa3040_encode_channel_config(const uint8_t ch, const taa3040_channel_config_t *const c, uint8_t *const page0)
+{
+    page0[TAA3040_REG_CH_CONFIG(ch)] = (c->automatic_gain_control? TAA3040_CHANNEL_AGC_EN_MASK : 0)
+                                    | ((c->input_impedance << TAA3040_CHANNEL_IMPEDANCE_SHIFT) & TAA3040_CHANNEL_IMPEDANCE_MASK)
+                                    | (c->dc_coupled? TAA3040_CHANNEL_COUPLING_MASK : 0)
+                                    | ((c->mode << TAA3040_CHANNEL_SOURCE_SHIFT) & TAA3040_CHANNEL_SOURCE_MASK)
+                                    | (c->is_microphone? 0: TAA3040_CHANNEL_INPUT_TYPE_MASK);
+    page0[TAA3040_REG_CH_GAIN(ch)] = (c->gain_db << TAA3040_CHANNEL_GAIN_SHIFT) & TAA3040_CHANNEL_GAIN_MASK;
+    page0[TAA3040_REG_CH_VOLUME(ch)] = (c->digital_volume_setting << TAA3040_CHANNEL_VOLUME_SHIFT) & TAA3040_CHANNEL_VOLUME_MASK;
+    page0[TAA3040_REG_CH_GAIN_CAL(ch)] = (c->advanced.gain_calibration << TAA3040_CHANNEL_GAIN_CAL_SHIFT) & TAA3040_CHANNEL_GAIN_CAL_MASK;
+    page0[TAA3040_REG_CH_PHASE_CAL(ch)] = (c->advanced.phase_calibration << TAA3040_CHANNEL_PHASE_CAL_SHIFT) & TAA3040_CHANNEL_PHASE_CAL_MASK;
+
+    const uint8_t bit = TAA3040_CHANNEL_BIT(ch);
+    page0[TAA3040_REG_IN_CHANNEL_EN] = (page0[TAA3040_REG_IN_CHANNEL_EN] & ~bit) | (c->enabled? bit: 0);
+}
+
+void taa3040_decode_channel_config(const uint8_t *const page0, const uint8_t ch, taa3040_channel_config_t *const c)
+{
+    const uint8_t cfg0 = page0[TAA3040_REG_CH_CONFIG(ch)];
+    c->enabled = !!(page0[TAA3040_REG_IN_CHANNEL_EN] & TAA3040_CHANNEL_BIT(ch));
+    c->automatic_gain_control = !!(cfg0 & TAA3040_CHANNEL_AGC_EN_MASK);
+    c->input_impedance = (cfg0 & TAA3040_CHANNEL_IMPEDANCE_MASK) >> TAA3040_CHANNEL_IMPEDANCE_SHIFT;
+    c->dc_coupled = !!(cfg0 & TAA3040_CHANNEL_COUPLING_MASK);
+    c->mode = (cfg0 & TAA3040_CHANNEL_SOURCE_MASK) >> TAA3040_CHANNEL_SOURCE_SHIFT;
+    c->is_microphone = !(cfg0 & TAA3040_CHANNEL_INPUT_TYPE_MASK);
+
+    c->gain_db = (page0[TAA3040_REG_CH_GAIN(ch)] & TAA3040_CHANNEL_GAIN_MASK) >> TAA3040_CHANNEL_GAIN_SHIFT;
+    c->digital_volume_setting = (page0[TAA3040_REG_CH_VOLUME(ch)] & TAA3040_CHANNEL_VOLUME_MASK) >> TAA3040_CHANNEL_VOLUME_SHIFT;
+    c->advanced.gain_calibration = (page0[TAA3040_REG_CH_GAIN_CAL(ch)] & TAA3040_CHANNEL_GAIN_CAL_MASK) >> TAA3040_CHANNEL_GAIN_CAL_SHIFT;
+    c->advanced.phase_calibration = (page0[TAA3040_REG_CH_PHASE_CAL(ch)] & TAA3040_CHANNEL_PHASE_CAL_MASK) >> TAA3040_CHANNEL_PHASE_CAL_SHIFT;
+}
+
+void taa3040_encode_gpio_config(const taa3040_gpio_config_t *const g, uint8_t *const page0)
+{
+    for(int i = 0; i < TAA3040_NUM_GPO; ++i)
+    {
+        page0[TAA3040_REG_GPO_CONFIG_BASE + i] = ((g->gpo_configs[i].mode << TAA3040_GPO_CONFIG_SHIFT) & TAA3040_GPO_CONFIG_MASK)
+                                            | ((g->gpo_configs[i].drive << TAA3040_GPO_DRIVE_MODE_SHIFT) & TAA3040_GPO_DRIVE_MODE_MASK);
+    }
+
+    page0[TAA3040_REG_GPI_CONFIG_BASE] = ((g->gpi_modes[0] << TAA3040_GPI1_CONFIG_SHIFT) & TAA3040_GPI1_CONFIG_MASK)
+                                    | ((g->gpi_modes[1] << TAA3040_GPI2_CONFIG_SHIFT) & TAA3040_GPI2_CONFIG_MASK);
+    page0[TAA3040_REG_GPI_CONFIG_BASE + 1] = ((g->gpi_modes[2] << TAA3040_GPI3_CONFIG_SHIFT) & TAA3040_GPI3_CONFIG_MASK)
+                                        | ((g->gpi_modes[3] << TAA3040_GPI4_CONFIG_SHIFT) & TAA3040_GPI4_CONFIG_MASK);
+}
+
+void taa3040_decode_gpio_config(const uint8_t *const page0, taa3040_gpio_config_t *const g)
+{
+    for(int i = 0; i < TAA3040_NUM_GPO; ++i)
+    {
+        const uint8_t v = page0[TAA3040_REG_GPO_CONFIG_BASE + i];
+        g->gpo_configs[i].mode = (v & TAA3040_GPO_CONFIG_MASK) >> TAA3040_GPO_CONFIG_SHIFT;
+        g->gpo_configs[i].drive = (v & TAA3040_GPO_DRIVE_MODE_MASK) >> TAA3040_GPO_DRIVE_MODE_SHIFT;
+    }
+
+    const uint8_t gpi12 = page0[TAA3040_REG_GPI_CONFIG_BASE];
+    const uint8_t gpi34 = page0[TAA3040_REG_GPI_CONFIG_BASE + 1];
+    g->gpi_modes[0] = (gpi12 & TAA3040_GPI1_CONFIG_MASK) >> TAA3040_GPI1_CONFIG_SHIFT;
+    g->gpi_modes[1] = (gpi12 & TAA3040_GPI2_CONFIG_MASK) >> TAA3040_GPI2_CONFIG_SHIFT;
+    g->gpi_modes[2] = (gpi34 & TAA3040_GPI3_CONFIG_MASK) >> TAA3040_GPI3_CONFIG_SHIFT;
+    g->gpi_modes[3] = (gpi34 & TAA3040_GPI4_CONFIG_MASK) >> TAA3040_GPI4_CONFIG_SHIFT;
+}
+
+void taa3040_encode_interrupt_config(const taa3040_interrupt_config_t *const i, uint8_t *const page0)
+{
+    page0[TAA3040_REG_INTERRUPT_CONFIG] = ((i->polarity << TAA3040_INTERRUPT_POLARITY_SHIFT) & TAA3040_INTERRUPT_POLARITY_MASK)
+                                        | ((i->event << TAA3040_INTERRUPT_EVENT_SHIFT) & TAA3040_INTERRUPT_EVENT_MASK)
+                                        | (i->latch_enable? TAA3040_INTERRUPT_LATCH_MASK : 0);
+
+    page0[TAA3040_REG_INTERRUPT_MASK] = (i->mask_pll_interrupt? TAA3040_INTERRUPT_PLL_ERROR_MASK: 0)
+                                    |   (i->mask_asi_interrupt? TAA3040_INTERRUPT_ASI_ERROR_MASK : 0);
+
+    page0[TAA3040_REG_INTERRUPT_LATCH] = (i->latch_pll_interrupt? TAA3040_INTERRUPT_PLL_ERROR_MASK: 0)
+                                    |   (i->latch_asi_interrupt? TAA3040_INTERRUPT_ASI_ERROR_MASK: 0);
+}
+
+void taa3040_decode_interrupt_config(const uint8_t *const page0, taa3040_interrupt_config_t *const i)
+{
+    const uint8_t cfg = page0[TAA3040_REG_INTERRUPT_CONFIG];
+    i->polarity = (cfg & TAA3040_INTERRUPT_POLARITY_MASK) >> TAA3040_INTERRUPT_POLARITY_SHIFT;
+    i->event = (cfg & TAA3040_INTERRUPT_EVENT_MASK) >> TAA3040_INTERRUPT_EVENT_SHIFT;
+    i->latch_enable = !!(cfg & TAA3040_INTERRUPT_LATCH_MASK);
+
+    const uint8_t mask = page0[TAA3040_REG_INTERRUPT_MASK];
+    i->mask_pll_interrupt = !!(mask & TAA3040_INTERRUPT_PLL_ERROR_MASK);
+    i->mask_asi_interrupt = !!(mask & TAA3040_INTERRUPT_ASI_ERROR_MASK);
+
+    const uint8_t latch = page0[TAA3040_REG_INTERRUPT_LATCH];
+    i->latch_pll_interrupt = !!(latch & TAA3040_INTERRUPT_PLL_ERROR_MASK);
+    i->latch_asi_interrupt = !!(latch & TAA3040_INTERRUPT_ASI_ERROR_MASK);
+}
+
+void taa3040_encode_dsp_config(const taa3040_dsp_config_t *const dsp, uint8_t *const page0)
+{
+    page0[TAA3040_REG_DSP_CONFIG0] = ((dsp->decimation_filter << TAA3040_DECIMATION_FILTER_SHIFT) & TAA3040_DECIMATION_FILTER_MASK)
+                                | ((dsp->channel_summing << TAA3040_CHANNEL_SUM_MODE_SHIFT) & TAA3040_CHANNEL_SUM_MODE_MASK)
+                                | ((dsp->high_pass_filter << TAA3040_HIGH_PASS_FILTER_SHIFT) & TAA3040_HIGH_PASS_FILTER_MASK);
+
+    page0[TAA3040_REG_DSP_CONFIG1] = (dsp->volume_ganged? TAA3040_VOLUME_GANGED_MASK : 0)
+                                | ((dsp->biquads_per_channel << TAA3040_BIQUAD_COUNT_SHIFT) & TAA3040_BIQUAD_COUNT_MASK)
+                                | (dsp->advanced.soft_stepping? 0 : TAA3040_SOFT_STEP_MASK)
+                                | (dsp->automatic_gain_control? TAA3040_AGC_SELECT_MASK : 0);
+
+    page0[TAA3040_REG_AGC_CONFIG] = ((dsp->advanced.automatic_gain_control_level << TAA3040_AGC_LEVEL_SHIFT) & TAA3040_AGC_LEVEL_MASK)
+                                | ((dsp->advanced.automatic_gain_control_max_gain << TAA3040_AGC_MAX_GAIN_SHIFT) & TAA3040_AGC_MAX_GAIN_MASK);
+}
+
+void taa3040_decode_dsp_config(const uint8_t *const page0, taa3040_dsp_config_t *const dsp)
+{
+    const uint8_t cfg0 = page0[TAA3040_REG_DSP_CONFIG0];
+    dsp->decimation_filter = (taa3040_decimation_filter_t)((cfg0 & TAA3040_DECIMATION_FILTER_MASK) >> TAA3040_DECIMATION_FILTER_SHIFT);
+    dsp->channel_summing   = (taa3040_channel_summing_mode_t)((cfg0 & TAA3040_CHANNEL_SUM_MODE_MASK) >> TAA3040_CHANNEL_SUM_MODE_SHIFT);
+    dsp->high_pass_filter  = (taa3040_high_pass_filter_t)((cfg0 & TAA3040_HIGH_PASS_FILTER_MASK) >> TAA3040_HIGH_PASS_FILTER_SHIFT);
+
+    const uint8_t cfg1 = page0[TAA3040_REG_DSP_CONFIG1];
+    dsp->volume_ganged            = !!(cfg1 & TAA3040_VOLUME_GANGED_MASK);
+    dsp->biquads_per_channel      = (cfg1 & TAA3040_BIQUAD_COUNT_MASK) >> TAA3040_BIQUAD_COUNT_SHIFT;
+    dsp->advanced.soft_stepping   = !(cfg1 & TAA3040_SOFT_STEP_MASK);
+    dsp->automatic_gain_control   = !!(cfg1 & TAA3040_AGC_SELECT_MASK);
+
+    const uint8_t agc_val = page0[TAA3040_REG_AGC_CONFIG];
+    dsp->advanced.automatic_gain_control_level    = (agc_val & TAA3040_AGC_LEVEL_MASK) >> TAA3040_AGC_LEVEL_SHIFT;
+    dsp->advanced.automatic_gain_control_max_gain = (agc_val & TAA3040_AGC_MAX_GAIN_MASK) >> TAA3040_AGC_MAX_GAIN_SHIFT;
+}
+
+/* === Coefficient Codecs === */
+void taa3040_encode_biquad(const taa3040_biquad_filter_t *const filter, uint8_t *const regs)
+{
+    taa3040_encode_i32(filter->n0, &regs[0]);
+    taa3040_encode_i32(filter->n1, &regs[4]);
+    taa3040_encode_i32(filter->n2, &regs[8]);
+    taa3040_encode_i32(filter->d1, &regs[12]);
+    taa3040_encode_i32(filter->d2, &regs[16]);
+}
+
+void taa3040_decode_biquad(const uint8_t *const regs, taa3040_biquad_filter_t *const filter)
+{
+    filter->n0 = taa3040_decode_i32(&regs[0]);
+    filter->n1 = taa3040_decode_i32(&regs[4]);
+    filter->n2 = taa3040_decode_i32(&regs[8]);
+    filter->d1 = taa3040_decode_i32(&regs[12]);
+    filter->d2 = taa3040_decode_i32(&regs[16]);
+}
+
+void taa3040_encode_iir(const taa3040_iir_filter_t *const filter, uint8_t *const regs)
+{
+    taa3040_encode_i32(filter->n0, &regs[TAA3040_REG_IIR_N0 - TAA3040_REG_IIR_COEFF_START]);
+    taa3040_encode_i32(filter->n1, &regs[TAA3040_REG_IIR_N1 - TAA3040_REG_IIR_COEFF_START]);
+    taa3040_encode_i32(filter->d1, &regs[TAA3040_REG_IIR_D1 - TAA3040_REG_IIR_COEFF_START]);
+}
+
+void taa3040_decode_iir(const uint8_t *const regs, taa3040_iir_filter_t *const filter)
+{
+    filter->n0 = taa3040_decode_i32(&regs[TAA3040_REG_IIR_N0 - TAA3040_REG_IIR_COEFF_START]);
+    filter->n1 = taa3040_decode_i32(&regs[TAA3040_REG_IIR_N1 - TAA3040_REG_IIR_COEFF_START]);
+    filter->d1 = taa3040_decode_i32(&regs[TAA3040_REG_IIR_D1 - TAA3040_REG_IIR_COEFF_START]);
+}
+
+/* === Register Image === */
+void taa3040_image_encode(const taa3040_config_t *const config, uint8_t *const image)
+{
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+
+    taa3040_encode_system_config(&config->system_config, page0);
+    taa3040_encode_asi_config(&config->asi_config, page0);
+    for(uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+        taa3040_encode_channel_config(ch, &config->channel_configs[ch], page0);
+    taa3040_encode_gpio_config(&config->gpio_config, page0);
+    taa3040_encode_interrupt_config(&config->interrupt_config, page0);
+    taa3040_encode_dsp_config(&config->dsp_config, page0);
+
+    for(uint8_t run = 0; run < TAA3040_IMAGE_NUM_RUNS; ++run)
+    {
+        const taa3040_image_run_t r = TAA3040_IMAGE_RUNS[run];
+        if(r.page == 0)
+            memcpy(&image[r.offset], &page0[r.reg], r.length);
+    }
+
+    for(uint8_t i = 0; i < TAA3040_NUM_BIQUADS; ++i)
+        taa3040_encode_biquad(&config->dsp_config.biquad_filters[i], &image[TAA3040_IMAGE_OFFSET_BIQUAD(i)]);
+
+    for(uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+        memcpy(&image[TAA3040_IMAGE_OFFSET_MIXER + ch * TAA3040_MIXER_CHANNEL_STRIDE], config->mixer_config.channels[ch].coefficients, TAA3040_NUM_MIXERS);
+
+    taa3040_encode_iir(&config->dsp_config.advanced.custom_high_pass_filter, &image[TAA3040_IMAGE_OFFSET_IIR]);
+}
+
+void taa3040_image_decode(const uint8_t *const image, taa3040_config_t *const config)
+{
+    uint8_t page0[TAA3040_PAGE_SIZE] = {0};
+
+    for(uint8_t run = 0; run < TAA3040_IMAGE_NUM_RUNS; ++run)
+    {
+        const taa3040_image_run_t r = TAA3040_IMAGE_RUNS[run];
+        if(r.page == 0)
+            memcpy(&page0[r.reg], &image[r.offset], r.length);
+    }
+
+    taa3040_decode_system_config(page0, &config->system_config);
+    taa3040_decode_asi_config(page0, &config->asi_config);
+    for(uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+        taa3040_decode_channel_config(page0, ch, &config->channel_configs[ch]);
+    taa3040_decode_gpio_config(page0, &config->gpio_config);
+    taa3040_decode_interrupt_config(page0, &config->interrupt_config);
+    taa3040_decode_dsp_config(page0, &config->dsp_config);
+
+    for(uint8_t i = 0; i < TAA3040_NUM_BIQUADS; ++i)
+        taa3040_decode_biquad(&image[TAA3040_IMAGE_OFFSET_BIQUAD(i)], &config->dsp_config.biquad_filters[i]);
+
+    for(uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+        memcpy(config->mixer_config.channels[ch].coefficients, &image[TAA3040_IMAGE_OFFSET_MIXER + ch * TAA3040_MIXER_CHANNEL_STRIDE], TAA3040_NUM_MIXERS);
+
+    taa3040_decode_iir(&image[TAA3040_IMAGE_OFFSET_IIR], &config->dsp_config.advanced.custom_high_pass_filter);
+}
+
+int taa3040_image_offset(const uint8_t page, const uint8_t reg)
+{
+    for(uint8_t run = 0; run < TAA3040_IMAGE_NUM_RUNS; ++run)
+    {
+        const taa3040_image_run_t r = TAA3040_IMAGE_RUNS[run];
+        if(r.page == page && reg >= r.reg && reg < r.reg + r.length)
+            return r.offset + (reg - r.reg);
+    }
+    return -1;
+}
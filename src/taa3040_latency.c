@@ -0,0 +1,274 @@
+/**
+ * @file taa3040_latency.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 latency budget
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_latency.h"
+#include "taa3040_clock.h"
+#include "taa3040_eq.h"
+#include <math.h>
+
+#define TAA3040_LATENCY_PI      (3.14159265358979323846)
+#define TAA3040_LATENCY_Q31     (2147483648.0)
+
+/** @brief A second order section, a[0] = 1 */
+typedef struct {
+    double b[3];
+    double a[3];
+} taa3040_latency_section_t;
+
+/* --- Internal Helpers --- */
+
+/** @brief Group delay in samples and squared magnitude of a polynomial in z^-1 */
+static double taa3040_latency_poly(const double *const c, const double w, double *const power)
+{
+    double re = 0.0, im = 0.0, dre = 0.0, dim = 0.0;
+    for (uint8_t k = 0; k < 3; ++k)
+    {
+        re += c[k] * cos(k * w);
+        im -= c[k] * sin(k * w);
+        dre += k * c[k] * cos(k * w);
+        dim -= k * c[k] * sin(k * w);
+    }
+
+    *power = re * re + im * im;
+    return *power > 1e-30? (dre * re + dim * im) / *power: 0.0;
+}
+
+/** @brief Group delay of a section in samples, and its gain in dB */
+static double taa3040_latency_section(const taa3040_latency_section_t *const s, const double w, double *const gain_db)
+{
+    double num, den;
+    const double delay = taa3040_latency_poly(s->b, w, &num) - taa3040_latency_poly(s->a, w, &den);
+    if (gain_db)
+        *gain_db = 10.0 * log10((num > 1e-30? num: 1e-30) / (den > 1e-30? den: 1e-30));
+    return delay;
+}
+
+/** @brief The high pass filter as a section; the presets are bilinear first order high pass filters */
+static taa3040_latency_section_t taa3040_latency_high_pass(const taa3040_dsp_config_t *const dsp)
+{
+    if (dsp->high_pass_filter == TAA3040_HIGH_PASS_FILTER_CUSTOM)
+    {
+        const taa3040_iir_filter_t *const f = &dsp->advanced.custom_high_pass_filter;
+        return (taa3040_latency_section_t) {
+            .b = { f->n0 / TAA3040_LATENCY_Q31, f->n1 / TAA3040_LATENCY_Q31, 0.0 },
+            .a = { 1.0, -f->d1 / TAA3040_LATENCY_Q31, 0.0 },
+        };
+    }
+
+    const double cutoff = dsp->high_pass_filter == TAA3040_HIGH_PASS_FILTER_FS_4000? 1.0 / 4000.0:
+                          dsp->high_pass_filter == TAA3040_HIGH_PASS_FILTER_FS_500? 1.0 / 500.0: 1.0 / 125.0;
+    const double k = tan(TAA3040_LATENCY_PI * cutoff);
+    return (taa3040_latency_section_t) {
+        .b = { 1.0 / (1.0 + k), -1.0 / (1.0 + k), 0.0 },
+        .a = { 1.0, -(1.0 - k) / (1.0 + k), 0.0 },
+    };
+}
+
+static taa3040_latency_section_t taa3040_latency_biquad(const taa3040_biquad_filter_t *const f)
+{
+    // H(z) = (n0 + 2 n1 z^-1 + n2 z^-2) / (2^31 - 2 d1 z^-1 - d2 z^-2)
+    return (taa3040_latency_section_t) {
+        .b = { f->n0 / TAA3040_LATENCY_Q31, 2.0 * f->n1 / TAA3040_LATENCY_Q31, f->n2 / TAA3040_LATENCY_Q31 },
+        .a = { 1.0, -2.0 * f->d1 / TAA3040_LATENCY_Q31, -f->d2 / TAA3040_LATENCY_Q31 },
+    };
+}
+
+static float taa3040_latency_decimation(const taa3040_decimation_filter_t filter)
+{
+    return filter == TAA3040_DECIMATION_FILTER_LOW_LATENCY? TAA3040_LATENCY_DELAY_LOW_LATENCY:
+           filter == TAA3040_DECIMATION_FILTER_ULTRA_LOW_LATENCY? TAA3040_LATENCY_DELAY_ULTRA_LOW_LATENCY:
+           TAA3040_LATENCY_DELAY_LIN_PHASE;
+}
+
+static float taa3040_latency_passband(const taa3040_decimation_filter_t filter)
+{
+    return filter == TAA3040_DECIMATION_FILTER_LOW_LATENCY? TAA3040_LATENCY_PASSBAND_LOW_LATENCY:
+           filter == TAA3040_DECIMATION_FILTER_ULTRA_LOW_LATENCY? TAA3040_LATENCY_PASSBAND_ULTRA_LOW_LATENCY:
+           TAA3040_LATENCY_PASSBAND_LIN_PHASE;
+}
+
+static float taa3040_latency_ripple(const taa3040_decimation_filter_t filter)
+{
+    return filter == TAA3040_DECIMATION_FILTER_LOW_LATENCY? TAA3040_LATENCY_RIPPLE_LOW_LATENCY:
+           filter == TAA3040_DECIMATION_FILTER_ULTRA_LOW_LATENCY? TAA3040_LATENCY_RIPPLE_ULTRA_LOW_LATENCY:
+           TAA3040_LATENCY_RIPPLE_LIN_PHASE;
+}
+
+static unsigned taa3040_latency_min_osr(const taa3040_decimation_filter_t filter)
+{
+    return filter == TAA3040_DECIMATION_FILTER_LOW_LATENCY? TAA3040_PDM_MIN_OSR_LOW_LATENCY:
+           filter == TAA3040_DECIMATION_FILTER_ULTRA_LOW_LATENCY? TAA3040_PDM_MIN_OSR_ULTRA_LOW_LATENCY:
+           TAA3040_PDM_MIN_OSR_LIN_PHASE;
+}
+
+/** @brief If the frame holds the enabled ASI channels within the BCLK limit, and the PDM clock serves the filter */
+static bool taa3040_latency_feasible(const taa3040_config_t *const config)
+{
+    const taa3040_asi_config_t *const asi = &config->asi_config;
+    uint8_t channels = 0;
+    bool pdm = false;
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        channels += asi->channel_configs[ch].enabled;
+        pdm |= config->channel_configs[ch].enabled && config->channel_configs[ch].mode == TAA3040_CHANNEL_MODE_DIGITAL_PDM;
+    }
+
+    const taa3040_sampling_rate_t rate = asi->master_mode.sample_rate;
+    const bool is_48khz = asi->master_mode.sample_rate_48khz;
+    if (!TAA3040_CLOCK_CONFIG_VALID(rate, is_48khz, asi->master_mode.bclk_fsync_ratio, channels, asi->word_length))
+        return false;
+
+    return !pdm || TAA3040_PDM_CLOCK_HZ(config->system_config.advanced.pdm_clock, is_48khz)
+                   >= TAA3040_SAMPLE_RATE_HZ(rate, is_48khz) * taa3040_latency_min_osr(config->dsp_config.decimation_filter);
+}
+
+/* === Latency === */
+bool taa3040_latency_channel(const taa3040_config_t *const config, const uint8_t channel, const float frequency_hz,
+                             taa3040_latency_t *const latency)
+{
+    if (!config || !latency || channel >= TAA3040_NUM_CHANNELS || frequency_hz < 0.0f)
+        return false;
+
+    const taa3040_asi_config_t *const asi = &config->asi_config;
+    const taa3040_dsp_config_t *const dsp = &config->dsp_config;
+    if ((unsigned)asi->master_mode.sample_rate >= TAA3040_CLOCK_NUM_SAMPLE_RATES
+    ||  (unsigned)asi->master_mode.bclk_fsync_ratio >= TAA3040_CLOCK_NUM_BCLK_RATIOS
+    ||  asi->mode == TAA3040_ASI_MODE_RESERVED)
+        return false;
+
+    const uint32_t fs = TAA3040_SAMPLE_RATE_HZ(asi->master_mode.sample_rate, asi->master_mode.sample_rate_48khz);
+    const uint32_t frame = TAA3040_BCLK_RATIO_VALUE(asi->master_mode.bclk_fsync_ratio);
+    const uint32_t word = TAA3040_WORD_LENGTH_BITS(asi->word_length);
+    const double us = 1e6 / fs;
+    if (frequency_hz >= fs / 2.0f)
+        return false;
+
+    const double w = 2.0 * TAA3040_LATENCY_PI * frequency_hz / fs;
+    const taa3040_latency_section_t hpf = taa3040_latency_high_pass(dsp);
+
+    double biquads = 0.0;
+    for (uint8_t k = 0; k < dsp->biquads_per_channel; ++k)
+    {
+        uint8_t index;
+        if (!taa3040_eq_biquad_index(channel, k, dsp->biquads_per_channel, &index))
+            break;
+
+        const taa3040_latency_section_t s = taa3040_latency_biquad(&dsp->biquad_filters[index]);
+        biquads += taa3040_latency_section(&s, w, NULL);
+    }
+
+    // BCLK cycles from the start of the frame to the end of the slot
+    const uint8_t slot = asi->channel_configs[channel].slot;
+    uint32_t end = asi->advanced.transmission_offset_cycles + word;
+    if (asi->mode == TAA3040_ASI_MODE_TDM)
+        end += slot * word;
+    else
+        end += (slot >= 32? frame / 2: 0) + (slot % 32) * word + (asi->mode == TAA3040_ASI_MODE_I2S);
+
+    latency->sample_rate_hz = fs;
+    latency->decimation_us = (float)(taa3040_latency_decimation(dsp->decimation_filter) * us);
+    latency->high_pass_us = (float)(taa3040_latency_section(&hpf, w, NULL) * us);
+    latency->biquad_us = (float)(biquads * us);
+    latency->asi_us = (float)((TAA3040_LATENCY_ASI_FRAMES * frame + end) * us / frame);
+    latency->total_us = latency->decimation_us + latency->high_pass_us + latency->biquad_us + latency->asi_us;
+    return true;
+}
+
+bool taa3040_latency_worst(const taa3040_config_t *const config, const float frequency_hz, taa3040_latency_t *const latency,
+                           uint8_t *const channel)
+{
+    if (!config || !latency)
+        return false;
+
+    bool found = false;
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        taa3040_latency_t l;
+        if (!config->asi_config.channel_configs[ch].enabled)
+            continue;
+        if (!taa3040_latency_channel(config, ch, frequency_hz, &l))
+            return false;
+
+        if (!found || l.total_us > latency->total_us)
+        {
+            *latency = l;
+            if (channel)
+                *channel = ch;
+        }
+        found = true;
+    }
+    return found;
+}
+
+bool taa3040_latency_recommend(const taa3040_config_t *const config, const taa3040_latency_spec_t *const spec,
+                               taa3040_config_t *const recommended, taa3040_latency_t *const latency)
+{
+    if (!config || !spec || !recommended || spec->low_hz < 0.0f || spec->high_hz < spec->low_hz)
+        return false;
+
+    static const taa3040_decimation_filter_t filters[] = {
+        TAA3040_DECIMATION_FILTER_LIN_PHASE, TAA3040_DECIMATION_FILTER_LOW_LATENCY, TAA3040_DECIMATION_FILTER_ULTRA_LOW_LATENCY
+    };
+    static const taa3040_high_pass_filter_t high_passes[] = {
+        TAA3040_HIGH_PASS_FILTER_CUSTOM, TAA3040_HIGH_PASS_FILTER_FS_4000, TAA3040_HIGH_PASS_FILTER_FS_500, TAA3040_HIGH_PASS_FILTER_FS_125
+    };
+
+    const bool is_48khz = config->asi_config.master_mode.sample_rate_48khz;
+    taa3040_config_t candidate = *config;
+    taa3040_latency_t best = {0};
+    bool found = false;
+
+    // Lowest rate first, so a tie keeps the cheaper rate
+    for (uint8_t rate = 0; rate < TAA3040_CLOCK_NUM_SAMPLE_RATES; ++rate)
+    {
+        const uint32_t fs = TAA3040_SAMPLE_RATE_HZ(rate, is_48khz);
+        if (spec->max_sample_rate_hz? fs > spec->max_sample_rate_hz: rate != (uint8_t)config->asi_config.master_mode.sample_rate)
+            continue;
+
+        candidate.asi_config.master_mode.sample_rate = (taa3040_sampling_rate_t)rate;
+        for (size_t f = 0; f < sizeof(filters) / sizeof(filters[0]); ++f)
+        {
+            if (spec->linear_phase && filters[f] != TAA3040_DECIMATION_FILTER_LIN_PHASE)
+                continue;
+            if (spec->high_hz > taa3040_latency_passband(filters[f]) * fs || taa3040_latency_ripple(filters[f]) > spec->max_ripple_db)
+                continue;
+
+            candidate.dsp_config.decimation_filter = filters[f];
+            if (!taa3040_latency_feasible(&candidate))
+                continue;
+
+            for (size_t h = 0; h < sizeof(high_passes) / sizeof(high_passes[0]); ++h)
+            {
+                candidate.dsp_config.high_pass_filter = high_passes[h];
+
+                double droop_db;
+                const taa3040_latency_section_t hpf = taa3040_latency_high_pass(&candidate.dsp_config);
+                taa3040_latency_section(&hpf, 2.0 * TAA3040_LATENCY_PI * spec->low_hz / fs, &droop_db);
+
+                taa3040_latency_t l;
+                if (-droop_db > spec->max_droop_db || !taa3040_latency_worst(&candidate, spec->frequency_hz, &l, NULL))
+                    continue;
+
+                if (!found || l.total_us < best.total_us - 1e-3f)
+                {
+                    best = l;
+                    *recommended = candidate;
+                    found = true;
+                }
+            }
+        }
+    }
+
+    if (found && latency)
+        *latency = best;
+    return found;
+}
@@ -0,0 +1,361 @@
+/**
+ * @file taa3040_linux.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 Linux i2c-dev HAL and recorder sink
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#define _GNU_SOURCE   // O_CLOEXEC and O_DIRECT under -std=c99 / c11
+
+#include "taa3040_linux.h"
+#include "taa3040_registers.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#define TAA3040_LINUX_MAX_MSGS  (TAA3040_LINUX_MAX_HELD + 2)
+
+#ifdef TAA3040_LINUX_IOCTL
+int TAA3040_LINUX_IOCTL(int fd, unsigned long request, ...);    // Stands in for the kernel, see taa3040_linux.h
+#else
+#define TAA3040_LINUX_IOCTL ioctl
+#endif
+
+#if TAA3040_LINUX_MAX_MSGS > I2C_RDWR_IOCTL_MAX_MSGS
+#error "TAA3040_LINUX_MAX_HELD exceeds the messages of one I2C_RDWR call"
+#endif
+
+/* --- Internal Helpers --- */
+
+static inline bool taa3040_linux_combined(const taa3040_linux_i2c_t *const bus)
+{
+    return bus->functionality & I2C_FUNC_I2C;
+}
+
+static bool taa3040_linux_rdwr(taa3040_linux_i2c_t *const bus, struct i2c_msg *const msgs, const uint8_t count)
+{
+    if (!count)
+        return true;
+
+    struct i2c_rdwr_ioctl_data rdwr = { .msgs = msgs, .nmsgs = count };
+    ++bus->ioctls;
+    return TAA3040_LINUX_IOCTL(bus->fd, I2C_RDWR, &rdwr) == count;
+}
+
+/**
+ * @brief One I2C_RDWR call: the device's held page select followed by the given messages.
+ *
+ * Selects held for other devices go out first in a call of their own, so a device that
+ * does not acknowledge never aborts another's transfer. No caller is left to report their
+ * failure to, it is counted in held_failures. Without messages every held select is sent.
+ */
+static bool taa3040_linux_transfer(taa3040_linux_i2c_t *const bus, const uint8_t address, const struct i2c_msg *const msgs,
+                                   const uint8_t count)
+{
+    struct i2c_msg others[TAA3040_LINUX_MAX_HELD];
+    struct i2c_msg all[TAA3040_LINUX_MAX_MSGS];
+    uint8_t n_others = 0, n = 0;
+    for (uint8_t i = 0; i < bus->held_count; ++i)
+    {
+        const struct i2c_msg held = { .addr = bus->held_address[i], .flags = 0, .len = 2, .buf = bus->held[i] };
+        if (!count || held.addr == address)
+            all[n++] = held;
+        else
+            others[n_others++] = held;
+    }
+    for (uint8_t i = 0; i < count; ++i)
+        all[n++] = msgs[i];
+
+    bus->held_count = 0;
+    if (!taa3040_linux_rdwr(bus, others, n_others))
+        ++bus->held_failures;
+    return taa3040_linux_rdwr(bus, all, n);
+}
+
+static bool taa3040_linux_smbus(taa3040_linux_i2c_t *const bus, const uint8_t address, const uint8_t read_write,
+                                const uint8_t command, const uint32_t size, union i2c_smbus_data *const data)
+{
+    if (bus->slave != address)
+    {
+        ++bus->ioctls;
+        if (TAA3040_LINUX_IOCTL(bus->fd, I2C_SLAVE, (unsigned long)address) < 0)
+        {
+            bus->slave = -1;
+            return false;
+        }
+        bus->slave = address;
+    }
+
+    struct i2c_smbus_ioctl_data args = { .read_write = read_write, .command = command, .size = size, .data = data };
+    ++bus->ioctls;
+    return TAA3040_LINUX_IOCTL(bus->fd, I2C_SMBUS, &args) == 0;
+}
+
+/** @brief Register access in SMBus transfers, for adapters without plain I2C */
+static bool taa3040_linux_smbus_access(taa3040_linux_i2c_t *const bus, const uint8_t address, const uint8_t read_write,
+                                       const uint8_t reg, uint8_t *const data, const uint8_t length)
+{
+    const unsigned long block = read_write == I2C_SMBUS_READ? I2C_FUNC_SMBUS_READ_I2C_BLOCK: I2C_FUNC_SMBUS_WRITE_I2C_BLOCK;
+    const uint8_t chunk = (bus->functionality & block)? I2C_SMBUS_BLOCK_MAX: 1;
+
+    for (uint16_t done = 0; done < length; )
+    {
+        const uint8_t n = (uint8_t)(length - done < chunk? length - done: chunk);
+        union i2c_smbus_data d;
+
+        if (n == 1)
+        {
+            d.byte = data[done];
+            if (!taa3040_linux_smbus(bus, address, read_write, (uint8_t)(reg + done), I2C_SMBUS_BYTE_DATA, &d))
+                return false;
+            data[done] = d.byte;
+        }
+        else
+        {
+            d.block[0] = n;
+            memcpy(&d.block[1], &data[done], n);
+            if (!taa3040_linux_smbus(bus, address, read_write, (uint8_t)(reg + done), I2C_SMBUS_I2C_BLOCK_DATA, &d))
+                return false;
+            memcpy(&data[done], &d.block[1], n);
+        }
+        done += n;
+    }
+    return true;
+}
+
+#ifdef TAA3040_HAL_CONTEXT
+
+static bool taa3040_linux_hal_read(void *const context, const uint8_t address, const uint8_t reg, void *const data, const uint8_t length)
+{
+    return taa3040_linux_i2c_read((taa3040_linux_i2c_t*)context, address, reg, data, length);
+}
+
+static bool taa3040_linux_hal_write(void *const context, const uint8_t address, const uint8_t reg, const void *const data, const uint8_t length)
+{
+    return taa3040_linux_i2c_write((taa3040_linux_i2c_t*)context, address, reg, data, length);
+}
+
+#else
+
+static taa3040_linux_i2c_t* taa3040_linux_bus = NULL;
+
+static bool taa3040_linux_hal_read(const uint8_t address, const uint8_t reg, void *const data, const uint8_t length)
+{
+    return taa3040_linux_i2c_read(taa3040_linux_bus, address, reg, data, length);
+}
+
+static bool taa3040_linux_hal_write(const uint8_t address, const uint8_t reg, const void *const data, const uint8_t length)
+{
+    return taa3040_linux_i2c_write(taa3040_linux_bus, address, reg, data, length);
+}
+
+#endif
+
+/* === Bus === */
+bool taa3040_linux_i2c_open(taa3040_linux_i2c_t *const bus, const char *const path)
+{
+    if (!bus || !path)
+        return false;
+
+    memset(bus, 0, sizeof(*bus));
+    bus->slave = -1;
+    bus->fd = open(path, O_RDWR | O_CLOEXEC);
+    if (bus->fd < 0)
+        return false;
+
+    ++bus->ioctls;
+    if (TAA3040_LINUX_IOCTL(bus->fd, I2C_FUNCS, &bus->functionality) < 0
+    || !(bus->functionality & (I2C_FUNC_I2C | I2C_FUNC_SMBUS_BYTE_DATA)))
+    {
+        close(bus->fd);
+        bus->fd = -1;
+        return false;
+    }
+    return true;
+}
+
+void taa3040_linux_i2c_close(taa3040_linux_i2c_t *const bus)
+{
+    if (!bus || bus->fd < 0)
+        return;
+
+    taa3040_linux_i2c_flush(bus);
+    close(bus->fd);
+    bus->fd = -1;
+#ifndef TAA3040_HAL_CONTEXT
+    if (taa3040_linux_bus == bus)
+        taa3040_linux_bus = NULL;
+#endif
+}
+
+bool taa3040_linux_i2c_flush(taa3040_linux_i2c_t *const bus)
+{
+    if (!bus || bus->fd < 0)
+        return false;
+
+    return taa3040_linux_transfer(bus, 0, NULL, 0);
+}
+
+bool taa3040_linux_i2c_hal(taa3040_linux_i2c_t *const bus, taa3040_hal_t *const hal)
+{
+    if (!bus || !hal)
+        return false;
+#ifndef TAA3040_HAL_CONTEXT
+    // Devices already bound to another bus would silently move to this one
+    if (taa3040_linux_bus && taa3040_linux_bus != bus)
+        return false;
+#endif
+
+    memset(hal, 0, sizeof(*hal));
+    hal->i2c_read = taa3040_linux_hal_read;
+    hal->i2c_write = taa3040_linux_hal_write;
+#ifdef TAA3040_HAL_CONTEXT
+    hal->i2c_context = bus;
+#else
+    taa3040_linux_bus = bus;
+#endif
+    return true;
+}
+
+/* === Transfers === */
+bool taa3040_linux_i2c_read(taa3040_linux_i2c_t *const bus, const uint8_t address, const uint8_t reg, void *const data, const uint8_t length)
+{
+    if (!bus || bus->fd < 0 || (length && !data))
+        return false;
+
+    if (!taa3040_linux_combined(bus))
+        return taa3040_linux_smbus_access(bus, address, I2C_SMBUS_READ, reg, (uint8_t*)data, length);
+
+    // Register address, then a repeated start into the read
+    uint8_t addr = reg;
+    const struct i2c_msg msgs[2] = {
+        { .addr = address, .flags = 0, .len = 1, .buf = &addr },
+        { .addr = address, .flags = I2C_M_RD, .len = length, .buf = (uint8_t*)data },
+    };
+    return taa3040_linux_transfer(bus, address, msgs, 2);
+}
+
+bool taa3040_linux_i2c_write(taa3040_linux_i2c_t *const bus, const uint8_t address, const uint8_t reg, const void *const data,
+                             const uint8_t length)
+{
+    if (!bus || bus->fd < 0 || !length || !data)
+        return false;
+
+    if (!taa3040_linux_combined(bus))
+    {
+        uint8_t b[UINT8_MAX];
+        memcpy(b, data, length);
+        return taa3040_linux_smbus_access(bus, address, I2C_SMBUS_WRITE, reg, b, length);
+    }
+
+    if (reg == TAA3040_REG_PAGE_SELECT && length == 1)
+    {
+        // Only the device's last select matters, an earlier held one is replaced
+        uint8_t slot = 0;
+        while (slot < bus->held_count && bus->held_address[slot] != address)
+            ++slot;
+
+        if (slot == TAA3040_LINUX_MAX_HELD)
+        {
+            if (!taa3040_linux_transfer(bus, 0, NULL, 0))
+                return false;
+            slot = 0;
+        }
+
+        if (slot == bus->held_count)
+            ++bus->held_count;
+        bus->held_address[slot] = address;
+        bus->held[slot][0] = reg;
+        bus->held[slot][1] = *(const uint8_t*)data;
+        return true;
+    }
+
+    uint8_t b[1 + UINT8_MAX];
+    b[0] = reg;
+    memcpy(&b[1], data, length);
+    const struct i2c_msg msg = { .addr = address, .flags = 0, .len = (uint16_t)(1 + length), .buf = b };
+    return taa3040_linux_transfer(bus, address, &msg, 1);
+}
+
+/* === Recorder Sink === */
+
+/* File handles are the descriptor plus one, so descriptor 0 is not NULL */
+static inline int taa3040_linux_file_fd(void *const file)
+{
+    return (int)((intptr_t)file - 1);
+}
+
+static void* taa3040_linux_file_open(void *const context, const uint32_t index)
+{
+    const taa3040_linux_files_t *const files = (const taa3040_linux_files_t*)context;
+    char path[TAA3040_LINUX_MAX_PATH];
+    const int length = snprintf(path, sizeof(path), files->pattern, (unsigned)index);
+    if (length < 0 || (size_t)length >= sizeof(path))
+        return NULL;
+
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    int fd = files->direct? open(path, flags | O_DIRECT, 0644): -1;
+    if (fd < 0)
+        fd = open(path, flags, 0644);     // Not asked for, or refused by the file system
+    return fd < 0? NULL: (void*)((intptr_t)fd + 1);
+}
+
+static bool taa3040_linux_file_write(void *const context, void *const file, const uint64_t offset, const void *const data,
+                                     const size_t length)
+{
+    taa3040_linux_files_t *const files = (taa3040_linux_files_t*)context;
+    const int fd = taa3040_linux_file_fd(file);
+    const uint8_t* p = (const uint8_t*)data;
+    size_t done = 0;
+
+    while (done < length)
+    {
+        ++files->writes;
+        const ssize_t n = pwrite(fd, p + done, length - done, (off_t)(offset + done));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        done += (size_t)n;
+    }
+    files->bytes += length;
+    return true;
+}
+
+static bool taa3040_linux_file_close(void *const context, void *const file, const uint64_t length)
+{
+    const taa3040_linux_files_t *const files = (const taa3040_linux_files_t*)context;
+    const int fd = taa3040_linux_file_fd(file);
+
+    // Drop the padding of the last block, then the descriptor even if that failed
+    const bool ok = ftruncate(fd, (off_t)length) == 0 && (!files->sync || fdatasync(fd) == 0);
+    return close(fd) == 0 && ok;
+}
+
+bool taa3040_linux_recorder_sink(taa3040_linux_files_t *const files, taa3040_recorder_sink_t *const sink)
+{
+    if (!files || !files->pattern || !sink)
+        return false;
+
+    files->writes = 0;
+    files->bytes = 0;
+    *sink = (taa3040_recorder_sink_t) {
+        .open = taa3040_linux_file_open,
+        .write = taa3040_linux_file_write,
+        .close = taa3040_linux_file_close,
+        .async = false,
+        .context = files,
+    };
+    return true;
+}
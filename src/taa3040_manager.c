@@ -0,0 +1,143 @@
+/**
+ * @file taa3040_manager.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 multi-device manager
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_manager.h"
+#include "taa3040.h"
+#include <string.h>
+
+/* --- Internal Helpers --- */
+
+static void taa3040_manager_bus_work(void *const arg)
+{
+    taa3040_manager_bus_t *const bus = (taa3040_manager_bus_t*)arg;
+    taa3040_manager_run_bus(bus->manager, bus->bus, bus->manager->job, bus->manager->job_arg);
+}
+
+static bool taa3040_manager_config_job(taa3040_t *const dev, void *const arg)
+{
+    return taa3040_set_device_config(dev, (const taa3040_config_t*)arg);
+}
+
+/* === Device Manager === */
+bool taa3040_manager_init(taa3040_manager_t *const manager)
+{
+    if (!manager)
+        return false;
+
+    memset(manager, 0, sizeof(*manager));
+    for (uint8_t bus = 0; bus < TAA3040_MANAGER_MAX_BUSES; ++bus)
+    {
+        manager->buses[bus].manager = manager;
+        manager->buses[bus].bus = bus;
+    }
+    return true;
+}
+
+bool taa3040_manager_add(taa3040_manager_t *const manager, taa3040_t *const dev, const uint8_t bus)
+{
+    if (!manager || !dev || bus >= TAA3040_MANAGER_MAX_BUSES || manager->device_count == TAA3040_MANAGER_MAX_DEVICES)
+        return false;
+
+    manager->devices[manager->device_count] = dev;
+    manager->device_bus[manager->device_count] = bus;
+    manager->device_ok[manager->device_count] = true;
+    manager->device_count++;
+    return true;
+}
+
+uint8_t taa3040_manager_run_bus(taa3040_manager_t *const manager, const uint8_t bus, const taa3040_manager_job_fn job, void *const arg)
+{
+    if (!manager || !job || bus >= TAA3040_MANAGER_MAX_BUSES)
+        return 0;
+
+    // Only this bus's entries are touched, so several buses may run at once
+    uint8_t failures = 0;
+    for (uint8_t i = 0; i < manager->device_count; ++i)
+    {
+        if (manager->device_bus[i] != bus)
+            continue;
+
+        manager->device_ok[i] = job(manager->devices[i], arg);
+        if (!manager->device_ok[i])
+            ++failures;
+    }
+    manager->buses[bus].failures = failures;
+    return failures;
+}
+
+uint8_t taa3040_manager_run(taa3040_manager_t *const manager, const taa3040_manager_job_fn job, void *const arg, const taa3040_executor_t *const executor)
+{
+    if (!manager || !job)
+        return 0;
+
+    // Without wait the failures would be summed while workers may still be writing them
+    if (executor && executor->submit && !executor->wait)
+    {
+        for (uint8_t i = 0; i < manager->device_count; ++i)
+            manager->device_ok[i] = false;
+        return manager->device_count;
+    }
+
+    bool used[TAA3040_MANAGER_MAX_BUSES] = {false};
+    for (uint8_t i = 0; i < manager->device_count; ++i)
+        used[manager->device_bus[i]] = true;
+
+    manager->job = job;
+    manager->job_arg = arg;
+
+    for (uint8_t bus = 0; bus < TAA3040_MANAGER_MAX_BUSES; ++bus)
+    {
+        manager->buses[bus].failures = 0;
+        if (!used[bus])
+            continue;
+
+        if (executor && executor->submit)
+            executor->submit(executor->context, taa3040_manager_bus_work, &manager->buses[bus]);
+        else
+            taa3040_manager_bus_work(&manager->buses[bus]);
+    }
+
+    if (executor && executor->submit)
+        executor->wait(executor->context);
+
+    uint8_t failures = 0;
+    for (uint8_t bus = 0; bus < TAA3040_MANAGER_MAX_BUSES; ++bus)
+        failures += manager->buses[bus].failures;
+    return failures;
+}
+
+void taa3040_manager_startup(const taa3040_manager_t *const manager)
+{
+    if (!manager)
+        return;
+
+    for (uint8_t i = 0; i < manager->device_count; ++i)
+        taa3040_startup(manager->devices[i]);
+}
+
+void taa3040_manager_shutdown(const taa3040_manager_t *const manager)
+{
+    if (!manager)
+        return;
+
+    for (uint8_t i = 0; i < manager->device_count; ++i)
+        taa3040_shutdown(manager->devices[i]);
+}
+
+uint8_t taa3040_manager_set_device_config(taa3040_manager_t *const manager, const taa3040_config_t *const config, const taa3040_executor_t *const executor)
+{
+    if (!config)
+        return 0;
+
+    // The configuration is only read, so every worker can share it
+    return taa3040_manager_run(manager, taa3040_manager_config_job, (void*)config, executor);
+}
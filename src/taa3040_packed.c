@@ -0,0 +1,46 @@
+/**
+ * @file taa3040_packed.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 packed configuration
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_packed.h"
+#include "taa3040.h"
+
+/* === Conversion === */
+void taa3040_pack_config(const taa3040_config_t *const config, taa3040_packed_config_t *const packed)
+{
+    taa3040_image_encode(config, packed->image);
+    packed->flags = (config->asi_config.auto_clock_enabled? TAA3040_PACKED_AUTO_CLOCK_MASK: 0)
+                  | (config->system_config.advanced.fixed_i2c_address? TAA3040_PACKED_FIXED_I2C_ADDRESS_MASK: 0);
+}
+
+void taa3040_unpack_config(const taa3040_packed_config_t *const packed, taa3040_config_t *const config)
+{
+    taa3040_image_decode(packed->image, config);
+    config->asi_config.auto_clock_enabled = !!(packed->flags & TAA3040_PACKED_AUTO_CLOCK_MASK);
+    config->system_config.advanced.fixed_i2c_address = !!(packed->flags & TAA3040_PACKED_FIXED_I2C_ADDRESS_MASK);
+}
+
+/* === Device Access === */
+bool taa3040_set_packed_config(const taa3040_t *const dev, const taa3040_packed_config_t *const packed)
+{
+    if (!dev || !packed)
+        return false;
+
+    return taa3040_write_image(dev, packed->image);
+}
+
+bool taa3040_get_packed_config(const taa3040_t *const dev, taa3040_packed_config_t *const packed)
+{
+    if (!dev || !packed)
+        return false;
+
+    return taa3040_read_image(dev, packed->image);
+}
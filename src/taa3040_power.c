@@ -0,0 +1,216 @@
+/**
+ * @file taa3040_power.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 channel power manager
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_power.h"
+#include "taa3040.h"
+#include "taa3040_registers.h"
+#include <string.h>
+
+/* --- Internal Helpers --- */
+
+static inline uint8_t taa3040_power_bit(const uint8_t ch)
+{
+    return TAA3040_CHANNEL_BIT(ch);
+}
+
+/** @brief Channels dynamic power mode covers, in IN_CHANNEL_EN order */
+static inline uint8_t taa3040_power_dynamic_mask(const taa3040_dynamic_mode_channels_t channels)
+{
+    return (uint8_t)(0xFFu << (TAA3040_NUM_CHANNELS - 2u * ((unsigned)channels + 1u)));
+}
+
+static uint32_t taa3040_power_energy(const int32_t *const samples, const uint32_t frames, const uint8_t stride, const uint8_t ch)
+{
+    if (!frames)
+        return 0;
+
+    // The top 16 bits are plenty to tell silence from activity and keep the sum in 64 bits
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        const int32_t s = samples[(size_t)i * stride + ch] >> 16;
+        sum += (uint64_t)(s * s);
+    }
+    return (uint32_t)(sum / frames);
+}
+
+static void taa3040_power_detect(const taa3040_power_config_t *const config, taa3040_power_channel_t *const st, const uint32_t energy)
+{
+    const uint64_t level = (uint64_t)energy << 8;
+    const bool loud = energy > config->min_energy;
+    const bool above_on = loud && level > (uint64_t)st->floor * config->on_ratio;
+    const bool above_off = loud && level > (uint64_t)st->floor * config->off_ratio;
+
+    st->energy = energy;
+    if (st->active)
+    {
+        st->active = above_off;
+        st->rising_blocks = 0;
+    }
+    else
+    {
+        if (above_off && st->rising_blocks < UINT16_MAX)
+            ++st->rising_blocks;
+        else if (!above_off)
+            st->rising_blocks = 0;
+        st->active = above_on;
+    }
+
+    if (st->active)
+        st->idle_blocks = 0;
+    else if (st->idle_blocks < UINT16_MAX)
+        ++st->idle_blocks;
+
+    // Compared against the floor before the block, so an onset does not raise its own threshold
+    if (energy < st->floor)
+        st->floor = energy;
+    else
+        st->floor += (energy - st->floor) >> config->floor_rise_shift;
+}
+
+static void taa3040_power_log(taa3040_power_manager_t *const pm, const taa3040_power_event_t *const event)
+{
+    if (!pm->events || !pm->event_capacity)
+        return;
+
+    pm->events[pm->events_written % pm->event_capacity] = *event;
+    ++pm->events_written;
+}
+
+/* === Power Management === */
+void taa3040_power_default_config(taa3040_power_config_t *const config, const taa3040_dynamic_mode_channels_t dynamic_channels,
+                                  const uint16_t hang_blocks)
+{
+    if (!config || dynamic_channels > TAA3040_DYNAMIC_MODE_CHANNELS_ALL)
+        return;
+
+    *config = (taa3040_power_config_t) {
+        .sentinel_mask = taa3040_power_bit(0),
+        .managed_mask = (uint8_t)(taa3040_power_dynamic_mask(dynamic_channels) & ~taa3040_power_bit(0)),
+        .dynamic_channels = dynamic_channels,
+        .on_ratio = 16 << 8,
+        .off_ratio = 4 << 8,
+        .min_energy = 100,
+        .hang_blocks = hang_blocks,
+        .floor_rise_shift = 6,
+    };
+}
+
+bool taa3040_power_init(taa3040_power_manager_t *const pm, const taa3040_power_config_t *const config, const uint8_t enabled,
+                        taa3040_power_event_t *const events, const uint32_t capacity)
+{
+    if (!pm || !config)
+        return false;
+
+    // Without a powered sentinel nothing could wake the managed channels again, and
+    // switching a channel outside dynamic power mode glitches the ones recording
+    if (!config->sentinel_mask || (config->sentinel_mask & config->managed_mask)
+    ||  config->dynamic_channels > TAA3040_DYNAMIC_MODE_CHANNELS_ALL
+    ||  (config->managed_mask & ~taa3040_power_dynamic_mask(config->dynamic_channels))
+    ||  (enabled & config->sentinel_mask) != config->sentinel_mask
+    ||  config->off_ratio > config->on_ratio || config->floor_rise_shift > 31)
+        return false;
+
+    memset(pm, 0, sizeof(*pm));
+    pm->config = *config;
+    pm->enabled = enabled;
+    pm->events = events;
+    pm->event_capacity = events? capacity: 0;
+
+    // The first block measured sets the floor
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+        pm->channels[ch].floor = UINT32_MAX;
+
+    return true;
+}
+
+bool taa3040_power_process(taa3040_power_manager_t *const pm, const taa3040_t *const dev, const int32_t *const samples,
+                           const uint32_t frames, const uint8_t stride, const uint32_t timestamp)
+{
+    if (!pm || !dev || (frames && !samples))
+        return false;
+
+    const taa3040_power_config_t *const config = &pm->config;
+    uint8_t waker = TAA3040_NUM_CHANNELS;
+
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        taa3040_power_channel_t *const st = &pm->channels[ch];
+        if (!(pm->enabled & taa3040_power_bit(ch)))
+            continue;
+
+        ++st->powered_blocks;
+        const uint32_t energy = ch < stride? taa3040_power_energy(samples, frames, stride, ch): 0;
+        taa3040_power_detect(config, st, energy);
+
+        if (st->active && (config->sentinel_mask & taa3040_power_bit(ch)) && waker == TAA3040_NUM_CHANNELS)
+            waker = ch;
+    }
+    ++pm->blocks;
+
+    uint8_t target = pm->enabled;
+    if (waker < TAA3040_NUM_CHANNELS)
+        target |= config->managed_mask;
+    else
+    {
+        for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+        {
+            const uint8_t bit = taa3040_power_bit(ch);
+            if ((config->managed_mask & bit) && pm->channels[ch].idle_blocks >= config->hang_blocks)
+                target &= (uint8_t)~bit;
+        }
+    }
+
+    if (target == pm->enabled)
+        return true;
+
+    if (!taa3040_write_registers(dev, TAA3040_REG_IN_CHANNEL_EN, &target, 1))
+        return false;
+
+    // Woken channels start a fresh hang time and must prove activity again
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        if ((target & ~pm->enabled) & taa3040_power_bit(ch))
+        {
+            pm->channels[ch].idle_blocks = 0;
+            pm->channels[ch].active = false;
+        }
+    }
+
+    taa3040_power_event_t event = {
+        .timestamp = timestamp,
+        .block = pm->blocks - 1,
+        .enabled_before = pm->enabled,
+        .enabled_after = target,
+        .trigger = TAA3040_POWER_TRIGGER_IDLE,
+    };
+    if (waker < TAA3040_NUM_CHANNELS)
+    {
+        const taa3040_power_channel_t *const st = &pm->channels[waker];
+        event.trigger = waker;
+        event.energy = st->energy;
+        event.floor = st->floor;
+        event.detect_blocks = st->rising_blocks;
+    }
+    taa3040_power_log(pm, &event);
+
+    pm->enabled = target;
+    return true;
+}
+
+uint32_t taa3040_power_duty(const taa3040_power_manager_t *const pm, const uint8_t ch)
+{
+    if (!pm || ch >= TAA3040_NUM_CHANNELS || !pm->blocks)
+        return 0;
+
+    return (uint32_t)(((uint64_t)pm->channels[ch].powered_blocks << 16) / pm->blocks);
+}
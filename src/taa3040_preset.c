@@ -0,0 +1,150 @@
+/**
+ * @file taa3040_preset.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 preset bank
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_preset.h"
+#include "taa3040_blob.h"
+#include "taa3040.h"
+#include <string.h>
+
+/* --- Internal Helpers --- */
+
+/* Writes the runs that turn image from into image to, in programming order. Returns bytes written or -1 if out of space */
+static int32_t taa3040_preset_diff(const uint8_t *const from, const uint8_t *const to, uint8_t *const script, const uint16_t capacity)
+{
+    uint16_t pos = 0;
+    for (uint8_t run = 0; run < TAA3040_IMAGE_NUM_RUNS; ++run)
+    {
+        const taa3040_image_run_t r = TAA3040_IMAGE_RUNS[run];
+        const uint8_t *const a = &from[r.offset];
+        const uint8_t *const b = &to[r.offset];
+
+        uint8_t i = 0;
+        while (i < r.length)
+        {
+            if (a[i] == b[i])
+            {
+                ++i;
+                continue;
+            }
+
+            // Extend the run over every change that is within the merge gap of the last one
+            uint8_t end = i + 1;
+            for (uint8_t j = end; j < r.length && j - end <= TAA3040_PRESET_MERGE_GAP; ++j)
+                if (a[j] != b[j])
+                    end = j + 1;
+
+            const uint8_t length = end - i;
+            if (pos + TAA3040_BLOB_RUN_HEADER + length > capacity)
+                return -1;
+
+            script[pos++] = r.page;
+            script[pos++] = r.reg + i;
+            script[pos++] = length;
+            memcpy(&script[pos], &b[i], length);
+            pos += length;
+            i = end;
+        }
+    }
+    return pos;
+}
+
+static bool taa3040_preset_store(taa3040_preset_bank_t *const bank, const uint8_t from, const uint8_t to)
+{
+    const int32_t length = taa3040_preset_diff(bank->images[from], bank->images[to],
+        &bank->storage[bank->storage_used], bank->storage_capacity - bank->storage_used);
+    if (length < 0)
+        return false;
+
+    bank->script_offset[from][to] = bank->storage_used;
+    bank->script_length[from][to] = (uint16_t)length;
+    bank->storage_used += (uint16_t)length;
+    return true;
+}
+
+/* === Preset Bank === */
+bool taa3040_preset_bank_init(taa3040_preset_bank_t *const bank, uint8_t *const storage, const uint16_t capacity)
+{
+    if (!bank || (capacity && !storage))
+        return false;
+
+    memset(bank, 0, sizeof(*bank));
+    bank->storage = storage;
+    bank->storage_capacity = capacity;
+    bank->current = TAA3040_PRESET_NONE;
+    return true;
+}
+
+bool taa3040_preset_add(taa3040_preset_bank_t *const bank, const taa3040_config_t *const config, uint8_t *const index)
+{
+    if (!bank || !config || bank->count >= TAA3040_PRESET_MAX_PRESETS)
+        return false;
+
+    const uint8_t added = bank->count;
+    taa3040_image_encode(config, bank->images[added]);
+
+    const uint16_t used = bank->storage_used;
+    for (uint8_t other = 0; other < added; ++other)
+    {
+        if (!taa3040_preset_store(bank, other, added) || !taa3040_preset_store(bank, added, other))
+        {
+            bank->storage_used = used;
+            return false;
+        }
+    }
+
+    bank->script_offset[added][added] = 0;
+    bank->script_length[added][added] = 0;
+    bank->count++;
+
+    if (index)
+        *index = added;
+    return true;
+}
+
+bool taa3040_preset_apply(const taa3040_t *const dev, taa3040_preset_bank_t *const bank, const uint8_t index)
+{
+    if (!dev || !bank || index >= bank->count)
+        return false;
+
+    bank->current = TAA3040_PRESET_NONE;
+    if (!taa3040_write_image(dev, bank->images[index]))
+        return false;
+
+    bank->current = index;
+    return true;
+}
+
+bool taa3040_preset_switch(const taa3040_t *const dev, taa3040_preset_bank_t *const bank, const uint8_t index)
+{
+    if (!dev || !bank || index >= bank->count)
+        return false;
+
+    if (bank->current == TAA3040_PRESET_NONE)
+        return taa3040_preset_apply(dev, bank, index);
+
+    const uint8_t from = bank->current;
+    bank->current = TAA3040_PRESET_NONE;
+
+    if (!taa3040_blob_write_runs(dev, &bank->storage[bank->script_offset[from][index]], bank->script_length[from][index]))
+        return false;
+
+    bank->current = index;
+    return true;
+}
+
+uint16_t taa3040_preset_script_length(const taa3040_preset_bank_t *const bank, const uint8_t from, const uint8_t to)
+{
+    if (!bank || from >= bank->count || to >= bank->count)
+        return 0;
+
+    return bank->script_length[from][to];
+}
@@ -0,0 +1,116 @@
+/**
+ * @file taa3040_rate.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 detected rate tracking
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_rate.h"
+#include "taa3040.h"
+#include "taa3040_registers.h"
+#include <string.h>
+
+/* BCLK cycles per frame by FSYNC_RATIO_STATUS, 0 for reserved codes */
+static const uint16_t TAA3040_RATE_BCLK_RATIOS[16] = {
+    16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 1024, 2048, 0, 0, 0
+};
+
+/* === Detected Clocking === */
+bool taa3040_rate_decode(const uint8_t asi_status, taa3040_detected_clock_t *const clock)
+{
+    if (!clock)
+        return false;
+
+    const uint8_t rate = (asi_status & TAA3040_FSYNC_RATE_STATUS_MASK) >> TAA3040_FSYNC_RATE_STATUS_SHIFT;
+    const uint8_t ratio = (asi_status & TAA3040_FSYNC_RATIO_STATUS_MASK) >> TAA3040_FSYNC_RATIO_STATUS_SHIFT;
+    const bool rate_valid = rate <= TAA3040_SAMPLING_RATE_768KHZ;
+
+    clock->status = asi_status;
+    clock->sample_rate = rate_valid? (taa3040_sampling_rate_t)rate: TAA3040_SAMPLING_RATE_8KHZ;
+    clock->bclk_ratio = TAA3040_RATE_BCLK_RATIOS[ratio];
+    clock->valid = rate_valid && clock->bclk_ratio;
+    return clock->valid;
+}
+
+bool taa3040_rate_read(const taa3040_t *const dev, taa3040_detected_clock_t *const clock)
+{
+    if (!dev || !clock)
+        return false;
+
+    uint8_t status;
+    if (!taa3040_read_registers(dev, TAA3040_REG_ASI_STATUS, &status, 1))
+        return false;
+
+    taa3040_rate_decode(status, clock);
+    return true;
+}
+
+/* === Rate Watcher === */
+void taa3040_rate_watch_init(taa3040_rate_watch_t *const watch, const uint8_t stable_polls,
+                             const taa3040_rate_change_fn on_change, void *const context)
+{
+    if (!watch)
+        return;
+
+    memset(watch, 0, sizeof(*watch));
+    taa3040_rate_decode(0xFF, &watch->current);
+    watch->candidate = watch->current.status;
+    watch->stable_polls = stable_polls;
+    watch->on_change = on_change;
+    watch->context = context;
+}
+
+bool taa3040_rate_watch_update(taa3040_rate_watch_t *const watch, const uint8_t asi_status)
+{
+    if (!watch)
+        return false;
+
+    taa3040_detected_clock_t next;
+    taa3040_rate_decode(asi_status, &next);
+
+    // Any invalid status is the same "not detected" state, whatever the other field reads
+    const bool same = next.valid? (watch->current.valid && next.status == watch->current.status): !watch->current.valid;
+    if (same)
+    {
+        watch->confirmations = 0;
+        return false;
+    }
+
+    const uint8_t candidate = next.valid? asi_status: 0xFF;
+    if (candidate != watch->candidate)
+    {
+        watch->candidate = candidate;
+        watch->confirmations = 0;
+    }
+    if (++watch->confirmations < watch->stable_polls)
+        return false;
+
+    const taa3040_detected_clock_t previous = watch->current;
+    watch->current = next;
+    watch->confirmations = 0;
+    ++watch->changes;
+
+    if (watch->on_change)
+        watch->on_change(watch->context, &previous, &next);
+    return true;
+}
+
+bool taa3040_rate_watch_poll(taa3040_rate_watch_t *const watch, const taa3040_t *const dev, bool *const changed)
+{
+    if (!watch || !dev)
+        return false;
+
+    uint8_t status;
+    if (!taa3040_read_registers(dev, TAA3040_REG_ASI_STATUS, &status, 1))
+        return false;
+
+    const bool c = taa3040_rate_watch_update(watch, status);
+    if (changed)
+        *changed = c;
+    return true;
+}
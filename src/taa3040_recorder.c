@@ -0,0 +1,326 @@
+/**
+ * @file taa3040_recorder.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 WAV / RF64 recorder
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_recorder.h"
+#include <string.h>
+
+/* Each chunk follows the previous one's payload; the data chunk header ends the header buffer */
+#define TAA3040_RECORDER_DS64_OFFSET    (TAA3040_RECORDER_RIFF_BYTES)   ///< JUNK chunk of a WAV file, ds64 chunk of an RF64 file
+#define TAA3040_RECORDER_FMT_OFFSET     (TAA3040_RECORDER_DS64_OFFSET + TAA3040_RECORDER_CHUNK_BYTES + TAA3040_RECORDER_DS64_BYTES)
+#define TAA3040_RECORDER_PAD_OFFSET     (TAA3040_RECORDER_FMT_OFFSET + TAA3040_RECORDER_CHUNK_BYTES + TAA3040_RECORDER_FMT_BYTES)   ///< JUNK chunk aligning the audio
+#define TAA3040_RECORDER_UNKNOWN        (0xFFFFFFFFu)
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+_Static_assert(TAA3040_RECORDER_MIN_HEADER == TAA3040_RECORDER_PAD_OFFSET + 2 * TAA3040_RECORDER_CHUNK_BYTES, "recorder header layout");
+#endif
+
+/* KSDATAFORMAT_SUBTYPE_PCM */
+static const uint8_t TAA3040_RECORDER_PCM_GUID[16] = {
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+};
+
+/* --- Internal Helpers --- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TAA3040_RECORDER_LOAD(v)        __atomic_load_n(&(v), __ATOMIC_ACQUIRE)
+#define TAA3040_RECORDER_STORE(v, x)    __atomic_store_n(&(v), (x), __ATOMIC_RELEASE)
+#else
+#define TAA3040_RECORDER_LOAD(v)        (v)
+#define TAA3040_RECORDER_STORE(v, x)    ((v) = (x))
+#endif
+
+static inline void taa3040_recorder_put16(uint8_t *const p, const uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void taa3040_recorder_put32(uint8_t *const p, const uint32_t v)
+{
+    taa3040_recorder_put16(p, (uint16_t)v);
+    taa3040_recorder_put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline void taa3040_recorder_put64(uint8_t *const p, const uint64_t v)
+{
+    taa3040_recorder_put32(p, (uint32_t)v);
+    taa3040_recorder_put32(p + 4, (uint32_t)(v >> 32));
+}
+
+static inline uint32_t taa3040_recorder_frame_bytes(const taa3040_recorder_t *const rec)
+{
+    return (uint32_t)rec->config.channels * sizeof(int32_t);
+}
+
+/* Header of a file holding data_bytes of audio, or of unknown length while it is written */
+static void taa3040_recorder_header(const taa3040_recorder_t *const rec, const uint64_t data_bytes, const bool known)
+{
+    const taa3040_recorder_config_t *const c = &rec->config;
+    uint8_t *const h = c->header;
+    const uint64_t riff_bytes = c->header_bytes + data_bytes - 8;
+    const bool rf64 = known && riff_bytes > 0xFFFFFFFFull;
+
+    memset(h, 0, c->header_bytes);
+    memcpy(h, rf64? "RF64": "RIFF", 4);
+    taa3040_recorder_put32(h + 4, !known || rf64? TAA3040_RECORDER_UNKNOWN: (uint32_t)riff_bytes);
+    memcpy(h + 8, "WAVE", 4);
+
+    // Reserved as JUNK so the header never moves the audio when it becomes ds64
+    uint8_t *const ds64 = h + TAA3040_RECORDER_DS64_OFFSET;
+    memcpy(ds64, rf64? "ds64": "JUNK", 4);
+    taa3040_recorder_put32(ds64 + 4, TAA3040_RECORDER_DS64_BYTES);
+    if (rf64)
+    {
+        taa3040_recorder_put64(ds64 + 8, riff_bytes);
+        taa3040_recorder_put64(ds64 + 16, data_bytes);
+        taa3040_recorder_put64(ds64 + 24, data_bytes / taa3040_recorder_frame_bytes(rec));
+    }
+
+    uint8_t *const fmt = h + TAA3040_RECORDER_FMT_OFFSET;
+    memcpy(fmt, "fmt ", 4);
+    taa3040_recorder_put32(fmt + 4, TAA3040_RECORDER_FMT_BYTES);
+    taa3040_recorder_put16(fmt + 8, 0xFFFE);                                        // WAVE_FORMAT_EXTENSIBLE
+    taa3040_recorder_put16(fmt + 10, c->channels);
+    taa3040_recorder_put32(fmt + 12, c->sample_rate);
+    taa3040_recorder_put32(fmt + 16, c->sample_rate * taa3040_recorder_frame_bytes(rec));
+    taa3040_recorder_put16(fmt + 20, (uint16_t)taa3040_recorder_frame_bytes(rec));
+    taa3040_recorder_put16(fmt + 22, 32);
+    taa3040_recorder_put16(fmt + 24, 22);
+    taa3040_recorder_put16(fmt + 26, c->valid_bits);
+    taa3040_recorder_put32(fmt + 28, 0);                                            // No speaker positions
+    memcpy(fmt + 32, TAA3040_RECORDER_PCM_GUID, sizeof(TAA3040_RECORDER_PCM_GUID));
+
+    uint8_t *const pad = h + TAA3040_RECORDER_PAD_OFFSET;
+    memcpy(pad, "JUNK", 4);
+    taa3040_recorder_put32(pad + 4, c->header_bytes - TAA3040_RECORDER_PAD_OFFSET - 2 * TAA3040_RECORDER_CHUNK_BYTES);
+
+    uint8_t *const data = h + c->header_bytes - TAA3040_RECORDER_CHUNK_BYTES;
+    memcpy(data, "data", 4);
+    taa3040_recorder_put32(data + 4, !known || rf64? TAA3040_RECORDER_UNKNOWN: (uint32_t)data_bytes);
+}
+
+static bool taa3040_recorder_open(taa3040_recorder_t *const rec)
+{
+    rec->file = rec->sink.open(rec->sink.context, rec->file_index);
+    if (!rec->file)
+        return false;
+
+    ++rec->file_index;
+    rec->file_bytes = 0;
+    taa3040_recorder_header(rec, 0, false);
+    return rec->sink.write(rec->sink.context, rec->file, 0, rec->config.header, rec->config.header_bytes);
+}
+
+/* Fill in the lengths of the closing file and close it once its last block completed */
+static bool taa3040_recorder_settle(taa3040_recorder_t *const rec)
+{
+    if (!rec->closing || (int32_t)(TAA3040_RECORDER_LOAD(rec->completed) - rec->closing_end) < 0)
+        return true;
+
+    void *const file = rec->closing;
+    rec->closing = NULL;
+
+    taa3040_recorder_header(rec, rec->closing_bytes, true);
+    return rec->sink.write(rec->sink.context, file, 0, rec->config.header, rec->config.header_bytes)
+        && rec->sink.close(rec->sink.context, file, rec->config.header_bytes + rec->closing_bytes);
+}
+
+/* End the current file after the blocks submitted so far; only one file closes at a time */
+static bool taa3040_recorder_close(taa3040_recorder_t *const rec)
+{
+    if (!rec->file)
+        return true;
+
+    rec->closing = rec->file;
+    rec->closing_bytes = rec->file_bytes;
+    rec->closing_end = rec->submitted;
+    rec->file = NULL;
+    return taa3040_recorder_settle(rec);
+}
+
+static bool taa3040_recorder_fail(taa3040_recorder_t *const rec)
+{
+    rec->failed = true;
+    return false;
+}
+
+/* === Recorder === */
+bool taa3040_recorder_init(taa3040_recorder_t *const rec, const taa3040_recorder_config_t *const config,
+                           const taa3040_recorder_sink_t *const sink)
+{
+    if (!rec || !config || !sink || !sink->open || !sink->write || !sink->close)
+        return false;
+
+    const uint32_t frame_bytes = (uint32_t)config->channels * sizeof(int32_t);
+    if (!config->channels || config->channels > TAA3040_NUM_CHANNELS || !config->valid_bits || config->valid_bits > 32
+    ||  !config->blocks || config->block_count < 2 || !config->block_bytes || config->block_bytes % frame_bytes
+    ||  !config->header || config->header_bytes < TAA3040_RECORDER_MIN_HEADER || config->header_bytes % 2)
+        return false;
+
+    memset(rec, 0, sizeof(*rec));
+    rec->config = *config;
+    rec->sink = *sink;
+    return true;
+}
+
+size_t taa3040_recorder_push(taa3040_recorder_t *const rec, const int32_t *const frames, const size_t count)
+{
+    if (!rec || (count && !frames))
+        return 0;
+
+    const taa3040_recorder_config_t *const c = &rec->config;
+    const uint32_t frame_bytes = taa3040_recorder_frame_bytes(rec);
+    const uint8_t* src = (const uint8_t*)frames;
+    size_t queued = 0;
+
+    while (queued < count)
+    {
+        const uint32_t filled = rec->filled;
+        if (filled - TAA3040_RECORDER_LOAD(rec->completed) >= c->block_count)
+            break;
+
+        uint8_t *const block = &c->blocks[(size_t)(filled % c->block_count) * c->block_bytes];
+        size_t n = (c->block_bytes - rec->fill) / frame_bytes;
+        if (n > count - queued)
+            n = count - queued;
+
+        memcpy(&block[rec->fill], src, n * frame_bytes);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        for (size_t i = 0; i < n * c->channels; ++i)
+        {
+            uint8_t *const w = &block[rec->fill + i * sizeof(int32_t)];
+            const uint8_t b0 = w[0], b1 = w[1];
+            w[0] = w[3]; w[1] = w[2]; w[2] = b1; w[3] = b0;
+        }
+#endif
+        src += n * frame_bytes;
+        queued += n;
+        rec->fill += (uint32_t)(n * frame_bytes);
+
+        if (rec->fill == c->block_bytes)
+        {
+            rec->fill = 0;
+            TAA3040_RECORDER_STORE(rec->filled, filled + 1);
+        }
+    }
+
+    if (queued < count)
+        rec->dropped += count - queued;
+    return queued;
+}
+
+bool taa3040_recorder_flush(taa3040_recorder_t *const rec)
+{
+    if (!rec || TAA3040_RECORDER_LOAD(rec->flush_bytes))
+        return false;
+
+    const taa3040_recorder_config_t *const c = &rec->config;
+    const uint32_t filled = rec->filled;
+    if (!rec->fill)
+    {
+        // Nothing partial: the file ends after the last full block
+        if (filled)
+        {
+            rec->flush_end = filled;
+            TAA3040_RECORDER_STORE(rec->flush_bytes, c->block_bytes);
+        }
+        return true;
+    }
+
+    uint8_t *const block = &c->blocks[(size_t)(filled % c->block_count) * c->block_bytes];
+    memset(&block[rec->fill], 0, c->block_bytes - rec->fill);
+
+    rec->flush_end = filled + 1;
+    TAA3040_RECORDER_STORE(rec->flush_bytes, rec->fill);
+    rec->fill = 0;
+    TAA3040_RECORDER_STORE(rec->filled, filled + 1);
+    return true;
+}
+
+bool taa3040_recorder_drain(taa3040_recorder_t *const rec)
+{
+    if (!rec || rec->failed)
+        return false;
+
+    const taa3040_recorder_config_t *const c = &rec->config;
+    const uint32_t filled = TAA3040_RECORDER_LOAD(rec->filled);
+
+    for (;;)
+    {
+        if (!taa3040_recorder_settle(rec))
+            return taa3040_recorder_fail(rec);
+
+        // A flush ends the file once its last block went out, even if that was before the flush
+        const uint32_t flush_bytes = TAA3040_RECORDER_LOAD(rec->flush_bytes);
+        if (flush_bytes && rec->submitted == rec->flush_end)
+        {
+            if (rec->closing)
+                return true;    // The previous file is still completing, the next drain retries
+
+            TAA3040_RECORDER_STORE(rec->flush_bytes, 0);
+            if (!taa3040_recorder_close(rec))
+                return taa3040_recorder_fail(rec);
+            continue;
+        }
+
+        if (rec->submitted == filled)
+            return true;
+
+        const uint32_t index = rec->submitted;
+        const bool last = flush_bytes && rec->flush_end == index + 1;
+        const uint32_t length = last? flush_bytes: c->block_bytes;
+
+        if (rec->file && c->max_file_bytes && rec->file_bytes && rec->file_bytes + length > c->max_file_bytes)
+        {
+            if (rec->closing)
+                return true;
+
+            if (!taa3040_recorder_close(rec))
+                return taa3040_recorder_fail(rec);
+        }
+
+        if (!rec->file && !taa3040_recorder_open(rec))
+            return taa3040_recorder_fail(rec);
+
+        // Always a whole block, the padding of a partial one is trimmed on close
+        const uint8_t *const block = &c->blocks[(size_t)(index % c->block_count) * c->block_bytes];
+        if (!rec->sink.write(rec->sink.context, rec->file, c->header_bytes + rec->file_bytes, block, c->block_bytes))
+            return taa3040_recorder_fail(rec);
+
+        rec->file_bytes += length;
+        rec->submitted = index + 1;
+        if (!rec->sink.async)
+            TAA3040_RECORDER_STORE(rec->completed, rec->submitted);
+    }
+}
+
+void taa3040_recorder_complete(taa3040_recorder_t *const rec, const uint32_t blocks)
+{
+    if (!rec)
+        return;
+
+    TAA3040_RECORDER_STORE(rec->completed, rec->completed + blocks);
+}
+
+bool taa3040_recorder_finish(taa3040_recorder_t *const rec)
+{
+    if (!rec || !taa3040_recorder_drain(rec))
+        return false;
+
+    // Refused until the sink completed every write, the caller reports completions and retries
+    if (TAA3040_RECORDER_LOAD(rec->flush_bytes) || rec->closing)
+        return false;
+
+    if (!taa3040_recorder_close(rec))
+        return taa3040_recorder_fail(rec);
+    return !rec->closing;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file taa3040_sequencer.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 startup sequencer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_sequencer.h"
+#include "taa3040_image.h"
+#include "taa3040.h"
+
+static const uint32_t TAA3040_VREF_QC_US[] = { 3500, 10000, 50000, 100000 };
+static const uint32_t TAA3040_INPUT_QC_US[] = { 2500, 12500, 25000, 50000 };
+
+/* --- Internal Helpers --- */
+
+/*
+ * Runs that only act on digital data and may be written while the analog path settles.
+ * The biquad, mixer and IIR coefficients are not: they may only change while the
+ * channels are powered down, so they go with the power-up blocks.
+ */
+static inline bool taa3040_sequencer_is_live(const taa3040_image_run_t *const run)
+{
+    return run->offset == TAA3040_IMAGE_OFFSET_GPO
+        || run->offset == TAA3040_IMAGE_OFFSET_GPI
+        || run->offset == TAA3040_IMAGE_OFFSET_INTERRUPT;
+}
+
+/** @brief Runs written before power up (live false) or while the device settles (live true) */
+static uint32_t taa3040_sequencer_runs(const bool live)
+{
+    uint32_t runs = 0;
+    for (uint8_t i = 0; i < TAA3040_IMAGE_NUM_RUNS; ++i)
+    {
+        const taa3040_image_run_t *const run = &TAA3040_IMAGE_RUNS[i];
+
+        // Sleep and the enables are sequenced explicitly
+        if (run->offset == TAA3040_IMAGE_OFFSET_SLEEP || run->offset == TAA3040_IMAGE_OFFSET_ENABLES)
+            continue;
+        if (taa3040_sequencer_is_live(run) == live)
+            runs |= 1u << i;
+    }
+    return runs;
+}
+
+static inline uint32_t taa3040_sequencer_elapsed(const taa3040_sequencer_timer_t *const timer, const uint32_t start)
+{
+    return timer->now_us() - start;
+}
+
+static void taa3040_sequencer_wait_until(const taa3040_sequencer_timer_t *const timer, const uint32_t start, const uint32_t deadline)
+{
+    const uint32_t now = taa3040_sequencer_elapsed(timer, start);
+    if (now < deadline)
+        timer->delay_us(deadline - now);
+}
+
+/* === Startup Sequencing === */
+uint32_t taa3040_sequencer_settle_us(const uint8_t *const image)
+{
+    if (!image)
+        return 0;
+
+    const uint8_t power = image[taa3040_image_offset(0, TAA3040_REG_POWER_CONFIG)];
+    if (!(power & TAA3040_ADC_ENABLE_MASK))
+        return 0;
+
+    const uint8_t sleep_cfg = image[TAA3040_IMAGE_OFFSET_SLEEP];
+    const uint8_t shutdown_cfg = image[TAA3040_IMAGE_OFFSET_SHUTDOWN];
+    uint32_t settle = TAA3040_VREF_QC_US[(sleep_cfg & TAA3040_VREF_QCHRG_MASK) >> TAA3040_VREF_QCHRG_SHIFT];
+
+    // Input capacitors only need charging on AC coupled inputs that are powered
+    const uint8_t enabled = image[taa3040_image_offset(0, TAA3040_REG_IN_CHANNEL_EN)];
+    for (uint8_t ch = 0; ch < TAA3040_NUM_CHANNELS; ++ch)
+    {
+        const bool powered = enabled & TAA3040_CHANNEL_BIT(ch);
+        if (powered && !(image[TAA3040_IMAGE_OFFSET_CH_REG(TAA3040_REG_CH_CONFIG(ch))] & TAA3040_CHANNEL_COUPLING_MASK))
+        {
+            settle += TAA3040_INPUT_QC_US[(shutdown_cfg & TAA3040_INCAP_QCHG_MASK) >> TAA3040_INCAP_QCHG_SHIFT];
+            break;
+        }
+    }
+
+    if ((power & TAA3040_PLL_ENABLE_MASK) && settle < TAA3040_SEQUENCER_PLL_LOCK_US)
+        settle = TAA3040_SEQUENCER_PLL_LOCK_US;
+
+    return settle;
+}
+
+bool taa3040_sequencer_program(const taa3040_t *const dev, const uint8_t *const image, const taa3040_sequencer_timer_t *const timer,
+                               const uint32_t start, taa3040_sequencer_report_t *const report)
+{
+    if (!dev || !image || !timer || !timer->now_us || !timer->delay_us)
+        return false;
+
+    taa3040_sequencer_report_t r = { .ready_us = taa3040_sequencer_elapsed(timer, start) };
+    r.settle_us = taa3040_sequencer_settle_us(image);
+
+    // Wake first, nothing else may be written until the device is up
+    if (!taa3040_write_registers(dev, TAA3040_REG_SLEEP_CFG, &image[TAA3040_IMAGE_OFFSET_SLEEP], 1))
+        return false;
+    taa3040_sequencer_wait_until(timer, start, taa3040_sequencer_elapsed(timer, start) + TAA3040_SEQUENCER_WAKE_US);
+
+    // Everything the analog path and clocks depend on, then power up as early as possible
+    if (!taa3040_write_image_runs(dev, image, taa3040_sequencer_runs(false))
+    ||  !taa3040_write_registers(dev, TAA3040_REG_IN_CHANNEL_EN, &image[TAA3040_IMAGE_OFFSET_ENABLES], 3))
+        return false;
+    r.power_up_us = taa3040_sequencer_elapsed(timer, start);
+
+    // GPIO and interrupts are programmed in the shadow of the quick charge and PLL lock
+    if (!taa3040_write_image_runs(dev, image, taa3040_sequencer_runs(true)))
+        return false;
+    r.programmed_us = taa3040_sequencer_elapsed(timer, start);
+
+    const uint32_t settled = r.power_up_us + r.settle_us;
+    taa3040_sequencer_wait_until(timer, start, settled);
+
+    r.first_sample_estimate_us = r.programmed_us > settled? r.programmed_us: settled;
+    r.sequential_us = r.programmed_us + r.settle_us;
+
+    taa3040_status_t status;
+    if (!taa3040_get_status(dev, &status))
+        return false;
+    r.device_status = (uint8_t)status.device_status;
+
+    if (report)
+        *report = r;
+    return true;
+}
+
+bool taa3040_sequencer_start(const taa3040_t *const dev, const taa3040_config_t *const config, const taa3040_sequencer_timer_t *const timer,
+                             taa3040_sequencer_report_t *const report)
+{
+    if (!dev || !config || !timer || !timer->now_us || !timer->delay_us)
+        return false;
+
+    const uint32_t start = timer->now_us();
+    if (!taa3040_startup(dev))
+        return false;
+
+    // Encoding costs nothing on the critical path while the supplies ramp
+    uint8_t image[TAA3040_IMAGE_SIZE];
+    taa3040_image_encode(config, image);
+    taa3040_sequencer_wait_until(timer, start, TAA3040_SEQUENCER_READY_US);
+
+    return taa3040_sequencer_program(dev, image, timer, start, report);
+}
@@ -0,0 +1,241 @@
+/**
+ * @file taa3040_trace.c
+ * @author Orion Serup (orion@crablabs.io)
+ * @brief The implementation of the TAA3040 transaction trace
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @license MIT
+ * @copyright Copyright (c) Crab Labs LLC 2025
+ *
+ */
+
+#include "taa3040_trace.h"
+#include "taa3040_registers.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char* const TAA3040_TRACE_API_NAMES[TAA3040_TRACE_API_COUNT] = {
+    [TAA3040_TRACE_API_NONE]                     = "none",
+    [TAA3040_TRACE_API_RESET]                    = "taa3040_reset",
+    [TAA3040_TRACE_API_SLEEP]                    = "taa3040_sleep",
+    [TAA3040_TRACE_API_WAKE]                     = "taa3040_wake",
+    [TAA3040_TRACE_API_SET_DEVICE_CONFIG]        = "taa3040_set_device_config",
+    [TAA3040_TRACE_API_GET_DEVICE_CONFIG]        = "taa3040_get_device_config",
+    [TAA3040_TRACE_API_SET_ASI_CONFIG]           = "taa3040_set_asi_config",
+    [TAA3040_TRACE_API_GET_ASI_CONFIG]           = "taa3040_get_asi_config",
+    [TAA3040_TRACE_API_SET_CHANNEL_CONFIG]       = "taa3040_set_channel_config",
+    [TAA3040_TRACE_API_GET_CHANNEL_CONFIG]       = "taa3040_get_channel_config",
+    [TAA3040_TRACE_API_SET_MIXER_CHANNEL_CONFIG] = "taa3040_set_mixer_channel_config",
+    [TAA3040_TRACE_API_GET_MIXER_CHANNEL_CONFIG] = "taa3040_get_mixer_channel_config",
+    [TAA3040_TRACE_API_SET_MIXER_CONFIG]         = "taa3040_set_mixer_config",
+    [TAA3040_TRACE_API_GET_MIXER_CONFIG]         = "taa3040_get_mixer_config",
+    [TAA3040_TRACE_API_SET_SYSTEM_CONFIG]        = "taa3040_set_system_config",
+    [TAA3040_TRACE_API_SET_DSP_CONFIG]           = "taa3040_set_dsp_config",
+    [TAA3040_TRACE_API_GET_DSP_CONFIG]           = "taa3040_get_dsp_config",
+    [TAA3040_TRACE_API_SET_GPIO_CONFIG]          = "taa3040_set_gpio_config",
+    [TAA3040_TRACE_API_GET_GPIO_CONFIG]          = "taa3040_get_gpio_config",
+    [TAA3040_TRACE_API_SET_INTERRUPT_CONFIG]     = "taa3040_set_interrupt_config",
+    [TAA3040_TRACE_API_GET_INTERRUPT_CONFIG]     = "taa3040_get_interrupt_config",
+    [TAA3040_TRACE_API_SET_GAIN_DB]              = "taa3040_set_gain_db",
+    [TAA3040_TRACE_API_GET_GAIN_DB]              = "taa3040_get_gain_db",
+    [TAA3040_TRACE_API_SET_DIGITAL_VOLUME]       = "taa3040_set_digital_volume",
+    [TAA3040_TRACE_API_GET_DIGITAL_VOLUME]       = "taa3040_get_digital_volume",
+    [TAA3040_TRACE_API_GET_FILTER]               = "taa3040_get_filter",
+    [TAA3040_TRACE_API_SET_FILTER]               = "taa3040_set_filter",
+    [TAA3040_TRACE_API_ENABLE_CHANNEL]           = "taa3040_enable_channel",
+    [TAA3040_TRACE_API_DISABLE_CHANNEL]          = "taa3040_disable_channel",
+    [TAA3040_TRACE_API_GET_STATUS]               = "taa3040_get_status",
+    [TAA3040_TRACE_API_SET_PAGE]                 = "taa3040_set_page",
+    [TAA3040_TRACE_API_WRITE_REGISTERS]          = "taa3040_write_registers",
+    [TAA3040_TRACE_API_READ_REGISTERS]           = "taa3040_read_registers",
+    [TAA3040_TRACE_API_WRITE_IMAGE]              = "taa3040_write_image",
+    [TAA3040_TRACE_API_READ_IMAGE]               = "taa3040_read_image",
+    [TAA3040_TRACE_API_UPLOAD_BEGIN]             = "taa3040_upload_begin",
+    [TAA3040_TRACE_API_UPLOAD_END]               = "taa3040_upload_end",
+    [TAA3040_TRACE_API_UPLOAD_DEVICE_CONFIG]     = "taa3040_upload_device_config",
+    [TAA3040_TRACE_API_SET_CHANNEL_CONFIGS]      = "taa3040_set_channel_configs",
+    [TAA3040_TRACE_API_GET_CHANNEL_CONFIGS]      = "taa3040_get_channel_configs",
+    [TAA3040_TRACE_API_SET_LEVELS]               = "taa3040_set_levels",
+    [TAA3040_TRACE_API_GET_LEVELS]               = "taa3040_get_levels",
+};
+
+/* --- Internal Helpers --- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TAA3040_TRACE_LOAD(v)       __atomic_load_n(&(v), __ATOMIC_ACQUIRE)
+#define TAA3040_TRACE_STORE(v, x)   __atomic_store_n(&(v), (x), __ATOMIC_RELEASE)
+#else
+#define TAA3040_TRACE_LOAD(v)       (v)
+#define TAA3040_TRACE_STORE(v, x)   ((v) = (x))
+#endif
+
+static void taa3040_trace_push(taa3040_trace_t *const trace, const taa3040_trace_record_t *const record)
+{
+    // Single writer: fill the slot first, then publish it by advancing the count
+    const uint32_t written = trace->written;
+    trace->records[written % trace->capacity] = *record;
+    TAA3040_TRACE_STORE(trace->written, written + 1);
+}
+
+static void taa3040_trace_emit(const taa3040_trace_sink_fn sink, void *const context, const char *const text, const int length)
+{
+    if (length > 0)
+        sink(context, text, (size_t)length);
+}
+
+/* === Trace === */
+bool taa3040_trace_init(taa3040_trace_t *const trace, taa3040_trace_record_t *const records, const uint32_t capacity, const taa3040_trace_clock_fn clock)
+{
+    if (!trace || !records || !capacity || !clock)
+        return false;
+
+    memset(trace, 0, sizeof(*trace));
+    trace->records = records;
+    trace->capacity = capacity;
+    trace->clock = clock;
+    return true;
+}
+
+bool taa3040_trace_attach(taa3040_t *const dev, taa3040_trace_t *const trace)
+{
+#ifdef TAA3040_TRACE
+    if (!dev)
+        return false;
+
+    if (trace)
+    {
+        trace->address = dev->address;
+        trace->page = 0;
+        trace->api = TAA3040_TRACE_API_NONE;
+    }
+    dev->trace = trace;
+    return true;
+#else
+    (void)dev;
+    (void)trace;
+    return false;
+#endif
+}
+
+uint32_t taa3040_trace_snapshot(const taa3040_trace_t *const trace, taa3040_trace_record_t *const records, const uint32_t capacity)
+{
+    if (!trace || !records || !capacity)
+        return 0;
+
+    const uint32_t end = TAA3040_TRACE_LOAD(trace->written);
+    uint32_t count = end < trace->capacity? end: trace->capacity;
+    if (count > capacity)
+        count = capacity;
+
+    const uint32_t start = end - count;
+    for (uint32_t i = 0; i < count; ++i)
+        records[i] = trace->records[(start + i) % trace->capacity];
+
+    // Anything the writer lapped while copying may be torn, so drop it. Record now may
+    // be mid write, and its slot holds record now - capacity
+    const uint32_t now = TAA3040_TRACE_LOAD(trace->written);
+    const uint32_t oldest_intact = now >= trace->capacity? now - trace->capacity + 1: 0;
+    if (oldest_intact <= start)
+        return count;
+
+    const uint32_t lost = oldest_intact - start;
+    if (lost >= count)
+        return 0;
+
+    memmove(records, &records[lost], (count - lost) * sizeof(*records));
+    return count - lost;
+}
+
+const char* taa3040_trace_api_name(const uint8_t api)
+{
+    return api < TAA3040_TRACE_API_COUNT? TAA3040_TRACE_API_NAMES[api]: "unknown";
+}
+
+void taa3040_trace_export_chrome(const taa3040_trace_record_t *const records, const uint32_t count, const uint8_t address,
+                                 const taa3040_trace_sink_fn sink, void *const context)
+{
+    if (!sink || (count && !records))
+        return;
+
+    char line[256];
+    taa3040_trace_emit(sink, context, line, snprintf(line, sizeof(line),
+        "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"TAA3040 @ 0x%02X\"}}",
+        address, address));
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const taa3040_trace_record_t r = records[i];
+        const uint8_t kind = r.flags & TAA3040_TRACE_KIND_MASK;
+        const char* const api = taa3040_trace_api_name(r.api);
+        int length;
+
+        if (kind == TAA3040_TRACE_API_BEGIN || kind == TAA3040_TRACE_API_END)
+            length = snprintf(line, sizeof(line),
+                ",\n{\"name\":\"%s\",\"cat\":\"api\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":%u,\"tid\":0}",
+                api, kind == TAA3040_TRACE_API_BEGIN? 'B': 'E', (unsigned long)r.timestamp, address);
+        else
+            length = snprintf(line, sizeof(line),
+                ",\n{\"name\":\"%s %u:0x%02X\",\"cat\":\"i2c\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%u,\"pid\":%u,\"tid\":0,"
+                "\"args\":{\"page\":%u,\"reg\":%u,\"length\":%u,\"ok\":%s,\"api\":\"%s\"}}",
+                kind == TAA3040_TRACE_READ? "read": "write", r.page, r.reg, (unsigned long)r.timestamp, r.duration, address,
+                r.page, r.reg, r.length, (r.flags & TAA3040_TRACE_OK_MASK)? "true": "false", api);
+
+        taa3040_trace_emit(sink, context, line, length);
+    }
+
+    taa3040_trace_emit(sink, context, "\n]}\n", 4);
+}
+
+/* === Driver Hooks === */
+taa3040_trace_scope_t taa3040_trace_enter(taa3040_trace_t *const trace, const uint8_t api)
+{
+    taa3040_trace_scope_t scope = { .trace = trace, .outer = TAA3040_TRACE_API_NONE };
+    if (!trace)
+        return scope;
+
+    const taa3040_trace_record_t record = {
+        .timestamp = trace->clock(), .page = trace->page, .flags = TAA3040_TRACE_API_BEGIN, .api = api
+    };
+    taa3040_trace_push(trace, &record);
+
+    scope.outer = trace->api;
+    trace->api = api;
+    return scope;
+}
+
+void taa3040_trace_leave(const taa3040_trace_scope_t *const scope)
+{
+    taa3040_trace_t *const trace = scope->trace;
+    if (!trace)
+        return;
+
+    const taa3040_trace_record_t record = {
+        .timestamp = trace->clock(), .page = trace->page, .flags = TAA3040_TRACE_API_END, .api = trace->api
+    };
+    taa3040_trace_push(trace, &record);
+    trace->api = scope->outer;
+}
+
+void taa3040_trace_transaction(taa3040_trace_t *const trace, const uint8_t kind, const uint8_t reg, const uint8_t *const data,
+                               const uint8_t length, const bool ok, const uint32_t start)
+{
+    if (!trace)
+        return;
+
+    const uint32_t elapsed = trace->clock() - start;
+    const taa3040_trace_record_t record = {
+        .timestamp = start,
+        .duration = elapsed > UINT16_MAX? UINT16_MAX: (uint16_t)elapsed,
+        .page = trace->page,
+        .reg = reg,
+        .length = length,
+        .flags = (uint8_t)(kind | (ok? TAA3040_TRACE_OK_MASK: 0)),
+        .api = trace->api,
+    };
+    taa3040_trace_push(trace, &record);
+
+    if (ok && kind == TAA3040_TRACE_WRITE && reg == TAA3040_REG_PAGE_SELECT && length)
+        trace->page = data[0];
+}